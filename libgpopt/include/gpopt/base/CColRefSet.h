@@ -51,6 +51,9 @@ namespace gpopt
 	{
 		// bitset iter needs to access internals
 		friend class CColRefSetIter;
+
+		// factory marks the sets it shares
+		friend class CColRefSetFactory;
 			
 		private:
 						
@@ -63,6 +66,10 @@ namespace gpopt
 			// clear given bit; return previous value
 			BOOL FExchangeClear(ULONG ulBit);
 
+			// is this the shared instance of a column set factory; shared
+			// sets are immutable and unique within their factory
+			BOOL m_fInterned;
+
 		public:
 				
 			// ctor
@@ -111,6 +118,43 @@ namespace gpopt
 			// replace column array with another column array
 			void Replace(const DrgPcr *pdrgpcrOut, const DrgPcr *pdrgpcrIn);
 
+			// union with given set
+			void Union(const CBitSet *pbs);
+
+			// intersect with given set
+			void Intersection(const CBitSet *pbs);
+
+			// remove members of given set
+			void Difference(const CBitSet *pbs);
+
+			// is this set shared by a column set factory
+			BOOL FInterned() const
+			{
+				return m_fInterned;
+			}
+
+			using CBitSet::FEqual;
+
+			// equality; two distinct shared sets are never equal
+			BOOL FEqual
+				(
+				const CColRefSet *pcrs
+				)
+				const
+			{
+				if (this == pcrs)
+				{
+					return true;
+				}
+
+				if (m_fInterned && pcrs->m_fInterned)
+				{
+					return false;
+				}
+
+				return CBitSet::FEqual(pcrs);
+			}
+
 			// check if the current colrefset is a subset of any of the colrefsets
 			// in the given array
 			BOOL FContained(const DrgPcrs *pdrgpcrs);
@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CColRefSetFactory.h
+//
+//	@doc:
+//		Sharing of equal column sets; one instance per optimization
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CColRefSetFactory_H
+#define GPOPT_CColRefSetFactory_H
+
+#include "gpos/base.h"
+#include "gpos/common/CList.h"
+#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/CSyncHashtableAccessByKey.h"
+#include "gpos/common/CSyncHashtableAccessByIter.h"
+#include "gpos/common/CSyncHashtableIter.h"
+
+#include "gpopt/spinlock.h"
+#include "gpopt/base/CColRefSet.h"
+
+// initial number of buckets of the column set table
+#define GPOPT_COLREFSET_FACTORY_HT_BUCKETS	(1024)
+
+// minimum number of shared sets before sets no longer in use are dropped
+#define GPOPT_COLREFSET_FACTORY_SWEEP_MIN	(1024)
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CColRefSetFactory
+	//
+	//	@doc:
+	//		Hash-consing of column sets.
+	//
+	//		The factory keeps one shared instance per distinct set; interning a
+	//		set returns the shared instance equal to it, so shared sets can be
+	//		compared by identity. Shared sets are immutable. They are allocated
+	//		from the factory's pool, so sets interned from short-lived pools do
+	//		not dangle; sets of the factory's pool are adopted without a copy.
+	//
+	//		The factory holds a reference to each shared set. Whenever the
+	//		number of shared sets doubles, sets that are only referenced by
+	//		the factory are dropped, so sets of discarded expressions do not
+	//		accumulate during optimization. The empty set is shared without
+	//		a table lookup.
+	//
+	//---------------------------------------------------------------------------
+	class CColRefSetFactory
+	{
+		private:
+
+			// table entry
+			struct SEntry
+			{
+				// shared set
+				const CColRefSet *m_pcrs;
+
+				// link for the hash table
+				SLink m_link;
+			};
+
+			// short hand for the table of sets
+			typedef CSyncHashtable<
+						SEntry,
+						const CColRefSet *,
+						CSpinlockColRefSetFactory> SetTable;
+
+			// short hand for table accessor
+			typedef CSyncHashtableAccessByKey<
+						SEntry,
+						const CColRefSet *,
+						CSpinlockColRefSetFactory> SetTableAccessor;
+
+			// short hand for table iterator
+			typedef CSyncHashtableIter<
+						SEntry,
+						const CColRefSet *,
+						CSpinlockColRefSetFactory> SetTableIter;
+
+			// short hand for table iterator accessor
+			typedef CSyncHashtableAccessByIter<
+						SEntry,
+						const CColRefSet *,
+						CSpinlockColRefSetFactory> SetTableIterAccessor;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// are shared sets only referenced by the optimizing thread
+			BOOL m_fSingleThreaded;
+
+			// shared sets
+			SetTable m_sht;
+
+			// shared empty set
+			CColRefSet *m_pcrsEmpty;
+
+			// number of shared sets that triggers the next sweep
+			volatile ULONG_PTR m_ulpSweepThreshold;
+
+			// non-zero while a worker sweeps the table
+			volatile ULONG m_ulSweeping;
+
+			// invalid key
+			static
+			const CColRefSet *m_pcrsInvalid;
+
+			// hash function of table keys
+			static
+			ULONG UlHash(const CColRefSet * const &pcrs);
+
+			// equality function of table keys
+			static
+			BOOL FEqual(const CColRefSet * const &pcrsFst, const CColRefSet * const &pcrsSnd);
+
+			// release a shared set and its entry
+			static
+			void DestroyEntry(SEntry *pentry);
+
+			// drop shared sets that are only referenced by the factory
+			void Sweep();
+
+			// private copy ctor
+			CColRefSetFactory(const CColRefSetFactory &);
+
+		public:
+
+			// ctor
+			CColRefSetFactory(IMemoryPool *pmp, BOOL fSingleThreaded);
+
+			// dtor
+			~CColRefSetFactory();
+
+			// return the shared set equal to the given set; consumes the
+			// reference of the given set and returns a new reference
+			CColRefSet *PcrsIntern(CColRefSet *pcrs);
+
+	}; // class CColRefSetFactory
+}
+
+#endif // !GPOPT_CColRefSetFactory_H
+
+// EOF
@@ -123,7 +123,8 @@ namespace gpopt
 			// link for cost context hash table in CGroupExpression
 			SLink m_link;
 
-			// ctor
+			// ctor; cost contexts are shared between threads if their group
+			// expression is
 			CCostContext(IMemoryPool *pmp, COptimizationContext *poc, ULONG ulOptReq, CGroupExpression *pgexpr);
 
 			// dtor
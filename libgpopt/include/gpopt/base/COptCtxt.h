@@ -13,8 +13,10 @@
 #define GPOPT_COptCtxt_H
 
 #include "gpos/base.h"
+#include "gpos/memory/CMemoryPoolSlab.h"
 #include "gpos/task/CTaskLocalStorageObject.h"
 
+#include "gpopt/base/CColRefSetFactory.h"
 #include "gpopt/base/CColumnFactory.h"
 #include "gpopt/base/CCTEInfo.h"
 #include "gpopt/base/IComparator.h"
@@ -57,9 +59,21 @@ namespace gpopt
 			// shared memory pool
 			IMemoryPool *m_pmp;
 		
+			// arena for slabs, NULL unless arena pools are enabled
+			IMemoryPool *m_pmpArena;
+
+			// slab pools for memo objects, allocated from the arena if
+			// there is one and from the shared pool otherwise
+			CMemoryPoolSlab *m_pmpGroupExpressions;
+			CMemoryPoolSlab *m_pmpCostContexts;
+			CMemoryPoolSlab *m_pmpOptimizationContexts;
+
 			// column factory
 			CColumnFactory *m_pcf;
 
+			// factory of shared column sets
+			CColRefSetFactory *m_pcrsf;
+
 			// metadata accessor;
 			CMDAccessor *m_pmda;
 
@@ -87,10 +101,21 @@ namespace gpopt
 			// whether or not we are optimizing a DML query
 			BOOL m_fDMLQuery;
 
+			// is the optimization run by a single thread; objects it creates
+			// are then counted without atomic operations
+			BOOL m_fSingleThreaded;
+
 			// value for the first valid part id
 			static
 			ULONG m_ulFirstValidPartId;
 
+			// create a slab pool for memo objects of given size
+			CMemoryPoolSlab *PmpSlabCreate(ULONG ulObjectSize);
+
+			// tear down and delete a slab pool
+			static
+			void DestroySlab(CMemoryPoolSlab *pmps);
+
 		public:
 
 			// ctor
@@ -112,6 +137,24 @@ namespace gpopt
 			{
 				return m_pmp;
 			}
+
+			// memory pool for group expressions
+			IMemoryPool *PmpGroupExpressions() const
+			{
+				return m_pmpGroupExpressions;
+			}
+
+			// memory pool for cost contexts
+			IMemoryPool *PmpCostContexts() const
+			{
+				return m_pmpCostContexts;
+			}
+
+			// memory pool for optimization contexts
+			IMemoryPool *PmpOptimizationContexts() const
+			{
+				return m_pmpOptimizationContexts;
+			}
 			
 			// optimizer configurations
 			COptimizerConfig *Poconf() const
@@ -125,6 +168,12 @@ namespace gpopt
 				return m_fDMLQuery;
 			}
 
+			// is the optimization run by a single thread
+			BOOL FSingleThreaded() const
+			{
+				return m_fSingleThreaded;
+			}
+
 			// set the DML flag
 			void MarkDMLQuery
 				(
@@ -139,6 +188,12 @@ namespace gpopt
 			{
 				return m_pcf;
 			}
+
+			// column set factory accessor
+			CColRefSetFactory *Pcrsf() const
+			{
+				return m_pcrsf;
+			}
 			
 			// metadata accessor
 			CMDAccessor *Pmda() const
@@ -137,7 +137,7 @@ namespace gpopt
 
 		public:
 
-			// ctor
+			// ctor; contexts are shared between threads if their group is
 			COptimizationContext
 				(
 				IMemoryPool *pmp,
@@ -146,24 +146,7 @@ namespace gpopt
 				CReqdPropRelational *prprel, // required relational props -- used during stats derivation
 				DrgPstat *pdrgpstatCtxt, // stats of previously optimized expressions
 				ULONG ulSearchStageIndex
-				)
-				:
-				m_pmp(pmp),
-				m_ulId(GPOPT_INVALID_OPTCTXT_ID),
-				m_pgroup(pgroup),
-				m_prpp(prpp),
-				m_prprel(prprel),
-				m_pdrgpstatCtxt(pdrgpstatCtxt),
-				m_ulSearchStageIndex(ulSearchStageIndex),
-				m_pccBest(NULL),
-				m_estate(estUnoptimized),
-				m_fHasMultiStageAggPlan(false)
-			{
-				GPOS_ASSERT(NULL != pgroup);
-				GPOS_ASSERT(NULL != prpp);
-				GPOS_ASSERT(NULL != prprel);
-				GPOS_ASSERT(NULL != pdrgpstatCtxt);
-			}
+				);
 
 			// dtor
 			virtual
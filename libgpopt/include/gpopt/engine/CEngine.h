@@ -12,6 +12,9 @@
 #define GPOPT_CEngine_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/memory/CMemoryProfile.h"
+#include "gpos/sync/atomic.h"
 #include "gpos/sync/CMutex.h"
 
 #include "gpopt/xforms/CXform.h"
@@ -31,6 +34,8 @@ namespace gpopt
 	class CPhysical;
 	class CQueryContext;
 	class COptimizationContext;
+	class CJobTrace;
+	class CScheduler;
 	class CReqdPropPlan;
 	class CReqdPropRelational;
 	class CEnumeratorConfig;
@@ -63,6 +68,10 @@ namespace gpopt
 			// memo table
 			CMemo *m_pmemo;
 
+			// does optimization run on a single thread; if so, memo objects
+			// are counted without atomic operations
+			BOOL m_fSingleThreaded;
+
 			//  pattern used for adding enforcers
 			CExpression *m_pexprEnforcerPattern;
 
@@ -80,6 +89,56 @@ namespace gpopt
 			// mutex for locking shared data structures when updating optimization statistics
 			CMutex m_mutexOptStats;
 
+			// soft limit on the size of engine's memory pool, in bytes
+			ULLONG m_ullSearchMemoryBudget;
+
+			// non-zero once engine's memory pool exceeded the memory budget;
+			// set by compare-and-swap as workers check the budget concurrently
+			volatile ULONG m_ulMemoryBudgetExceeded;
+
+			// deadline of optimization in milliseconds, gpos::ulong_max if none
+			ULONG m_ulOptimizationDeadline;
+
+			// clock started when optimization starts
+			CWallClock m_clockOptimization;
+
+			// non-zero once exploration has been stopped due to memory budget
+			// or deadline; set by compare-and-swap as workers stop it concurrently
+			volatile ULONG m_ulExplorationStopped;
+
+			// non-zero once the root group has a plan for the required properties;
+			// caches the memo lookup, since a found plan is never lost
+			volatile ULONG m_ulRootPlanFound;
+
+			// number of search stages whose memo was explored by parallel jobs
+			ULONG m_ulParallelExplorations;
+
+			// timeline of optimization jobs, NULL if not tracing
+			CJobTrace *m_pjtrace;
+
+			// allocation profile of the optimization, NULL if not profiling
+			CMemoryProfile *m_pmprof;
+
+			// arena owned by the engine, NULL unless arena pools are enabled
+			IMemoryPool *m_pmpArena;
+
+			// slab pools of the optimizer context for memo objects
+			IMemoryPool *m_pmpGroupExpressions;
+			IMemoryPool *m_pmpCostContexts;
+			IMemoryPool *m_pmpOptimizationContexts;
+
+			// pool for jobs, schedulers and memo index; these are only
+			// referenced while the engine exists
+			IMemoryPool *PmpScheduling() const
+			{
+				if (NULL != m_pmpArena)
+				{
+					return m_pmpArena;
+				}
+
+				return m_pmp;
+			}
+
 #ifdef GPOS_DEBUG
 
 			// a set of internal debugging function used for recursive
@@ -160,6 +219,12 @@ namespace gpopt
 			// create and schedule the main optimization job
 			void ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc);
 
+			// run scheduled jobs on worker tasks until all jobs are complete
+			void RunWorkers(CJobFactory *pjf, CScheduler *psched, ULONG ulWorkers);
+
+			// explore memo using multiple threads
+			void ExploreParallel(ULONG ulWorkers);
+
 			// build memo using multiple threads
 			void MultiThreadedOptimize(ULONG ulWorkers = 4);
 
@@ -175,8 +240,11 @@ namespace gpopt
 			// check if search has terminated
 			BOOL FSearchTerminated() const
 			{
-				// at least one stage has completed and achieved required cost
-				return (NULL != PssPrevious() && PssPrevious()->FAchievedReqdCost());
+				// at least one stage has completed and either achieved required cost,
+				// or found a plan after exploration was stopped
+				return (NULL != PssPrevious() &&
+						(PssPrevious()->FAchievedReqdCost() ||
+						 (FExplorationStopped() && NULL != PssPrevious()->PexprBest())));
 			}
 
 			// generate random plan id
@@ -258,6 +326,20 @@ namespace gpopt
 				return m_pmemo->PgroupRoot();
 			}
 
+			// number of search stages whose memo was explored by parallel jobs
+			ULONG UlParallelExplorations() const
+			{
+				return m_ulParallelExplorations;
+			}
+
+			// number of times stats of memo groups were derived by parallel jobs
+			ULONG UlParallelStatsDerivations() const
+			{
+				GPOS_ASSERT(NULL != m_pmemo);
+
+				return m_pmemo->UlParallelStatsDerivations();
+			}
+
 			// check if a group is the root one
 			BOOL FRoot(CGroup *pgroup) const
 			{
@@ -392,12 +474,54 @@ namespace gpopt
 				return m_pdrgpss->UlLength();
 			}
 
+			// memory pool for cost contexts
+			IMemoryPool *PmpCostContexts() const
+			{
+				return m_pmpCostContexts;
+			}
+
+			// memory pool for optimization contexts
+			IMemoryPool *PmpOptimizationContexts() const
+			{
+				return m_pmpOptimizationContexts;
+			}
+
 			// set of xforms of current stage
 			CXformSet *PxfsCurrentStage() const
 			{
 				return (*m_pdrgpss)[m_ulCurrSearchStage]->Pxfs();
 			}
 
+			// check size of engine's memory pool against memory budget;
+			// called by the scheduler every few jobs
+			void CheckMemoryBudget();
+
+			// has memory budget been exceeded; if so, no more exploration
+			// xforms are applied
+			BOOL FMemoryBudgetExceeded() const
+			{
+				return 0 != m_ulMemoryBudgetExceeded;
+			}
+
+			// stop applying exploration xforms for the rest of optimization
+			void StopExploration()
+			{
+				(void) FCompareSwap(&m_ulExplorationStopped, 0 /*ulOld*/, 1 /*ulNew*/);
+			}
+
+			// has exploration been stopped, due to either memory budget
+			// or deadline
+			BOOL FExplorationStopped() const
+			{
+				return 0 != m_ulExplorationStopped;
+			}
+
+			// pass the remaining time until deadline to a scheduler
+			void SetDeadline(CScheduler *psched) const;
+
+			// does the root group have a plan for the required properties
+			BOOL FRootPlanFound();
+
 			// return array of child optimization contexts corresponding to handle requirements
 			DrgPoc *PdrgpocChildren(IMemoryPool *pmp, CExpressionHandle &exprhdl);
 
@@ -17,6 +17,7 @@
 
 #define JOIN_ORDER_DP_THRESHOLD ULONG(10)
 #define BROADCAST_THRESHOLD ULONG(10000000)
+#define PARALLEL_WORKERS ULONG(2)
 
 namespace gpopt
 {
@@ -47,6 +48,12 @@ namespace gpopt
 
 			BOOL m_fEnforceConstraintsOnDML;
 
+			ULONG m_ulSearchMemoryBudget;
+
+			ULONG m_ulParallelWorkers;
+
+			ULONG m_ulOptimizationDeadline;
+
 			// private copy ctor
 			CHint(const CHint &);
 
@@ -60,7 +67,10 @@ namespace gpopt
 				ULONG ulArrayExpansionThreshold,
 				ULONG ulJoinOrderDPLimit,
 				ULONG ulBroadcastThreshold,
-				BOOL fEnforceConstraintsOnDML
+				BOOL fEnforceConstraintsOnDML,
+				ULONG ulSearchMemoryBudget,
+				ULONG ulParallelWorkers,
+				ULONG ulOptimizationDeadline
 				)
 				:
 				m_ulMinNumOfPartsToRequireSortOnInsert(ulMinNumOfPartsToRequireSortOnInsert),
@@ -68,7 +78,10 @@ namespace gpopt
 				m_ulArrayExpansionThreshold(ulArrayExpansionThreshold),
 				m_ulJoinOrderDPLimit(ulJoinOrderDPLimit),
 				m_ulBroadcastThreshold(ulBroadcastThreshold),
-				m_fEnforceConstraintsOnDML(fEnforceConstraintsOnDML)
+				m_fEnforceConstraintsOnDML(fEnforceConstraintsOnDML),
+				m_ulSearchMemoryBudget(ulSearchMemoryBudget),
+				m_ulParallelWorkers(ulParallelWorkers),
+				m_ulOptimizationDeadline(ulOptimizationDeadline)
 			{
 			}
 
@@ -121,6 +134,33 @@ namespace gpopt
 				return m_fEnforceConstraintsOnDML;
 			}
 
+			// Soft limit, in MB, on the memory used by the optimization engine.
+			// Once the engine's memory pool grows beyond it, no further exploration
+			// xforms are applied; implementation and optimization of the memo found
+			// so far continue, so that the best plan can still be returned.
+			ULONG UlSearchMemoryBudget() const
+			{
+				return m_ulSearchMemoryBudget;
+			}
+
+			// Maximum number of workers running optimization jobs when parallel
+			// optimization is enabled (EopttraceParallel). The scheduler wakes up
+			// workers as long as there is enough queued work to keep them busy.
+			ULONG UlParallelWorkers() const
+			{
+				return m_ulParallelWorkers;
+			}
+
+			// Time, in milliseconds, after which optimization returns the best
+			// plan found so far. Exploration stops well before the deadline so
+			// that the remaining time goes to implementing and optimizing the
+			// memo; once the deadline has passed and a plan exists, all
+			// outstanding optimization jobs are abandoned.
+			ULONG UlOptimizationDeadline() const
+			{
+				return m_ulOptimizationDeadline;
+			}
+
 			// generate default hint configurations, which disables sort during insert on
 			// append only row-oriented partitioned tables by default
 			static
@@ -132,7 +172,10 @@ namespace gpopt
 					gpos::int_max,			 /* ulArrayExpansionThreshold */
 					JOIN_ORDER_DP_THRESHOLD, /*ulJoinOrderDPLimit*/
 					BROADCAST_THRESHOLD,	 /*ulBroadcastThreshold*/
-					true					 /* fEnforceConstraintsOnDML */
+					true,					 /* fEnforceConstraintsOnDML */
+					gpos::int_max,			 /* ulSearchMemoryBudget */
+					PARALLEL_WORKERS,		 /* ulParallelWorkers */
+					gpos::int_max			 /* ulOptimizationDeadline */
 				);
 			}
 
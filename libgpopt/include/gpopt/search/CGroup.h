@@ -12,6 +12,7 @@
 #define GPOPT_CGroup_H
 
 #include "gpos/base.h"
+#include "gpos/sync/CEvent.h"
 #include "gpos/sync/CMutex.h"
 
 #include "naucrates/statistics/CStatistics.h"
@@ -19,6 +20,7 @@
 #include "gpos/common/CDynamicPtrArray.h"
 #include "gpos/common/CSyncHashtable.h"
 #include "gpos/common/CSyncList.h"
+#include "gpos/common/CSyncSegmentedArray.h"
 #include "gpos/sync/atomic.h"
 #include "gpos/sync/CSpinlock.h"
 
@@ -198,8 +200,9 @@ namespace gpopt
 			// hash join keys for inner child (only for scalar groups)
 			DrgPexpr *m_pdrgpexprHashJoinKeysInner;
 
-			// list of group expressions
-			CList<CGroupExpression> m_listGExprs;
+			// group expressions in order of insertion; slots of duplicates,
+			// and of expressions moved to another group, are cleared
+			CSyncSegmentedArray<CGroupExpression> m_sarGExprs;
 
 			// list of duplicate group expressions identified by group merge
 			CList<CGroupExpression> m_listDupGExprs;
@@ -210,15 +213,21 @@ namespace gpopt
 			// group stats
 			IStatistics *m_pstats;
 
-			// scalar expression for stat derivation
-			CExpression *m_pexprScalar;
+			// scalar expression for stat derivation; set once the expression
+			// is complete, since the group may be shared with other workers
+			// before that
+			CExpression * volatile m_pexprScalar;
+
+			// mutex and event for waiting on the scalar expression
+			CMutex m_mutexScalar;
+			CEvent m_eventScalar;
 
 			// dummy cost context used in scalar groups for plan enumeration
 			CCostContext *m_pccDummy;
 
 			// pointer to group containing the group expressions
 			// of all duplicate groups
-			CGroup *m_pgroupDuplicate;
+			CGroup * volatile m_pgroupDuplicate;
 
 			// map of processed links
 			LinkMap *m_plinkmap;
@@ -226,9 +235,14 @@ namespace gpopt
 			// map of computed stats during costing
 			StatsMap *m_pstatsmap;
 
-			// mutex for locking stats map when adding a new entry
+			// mutex for publishing derived group stats, and for locking
+			// stats map when adding a new entry
 			CMutex m_mutexStats;
 
+			// stats replaced by appending stats; concurrent derivations may
+			// still use them, hence they are released with the group stats
+			DrgPstat *m_pdrgpstatRetired;
+
 
 			// hashtable of optimization contexts
 			ShtOC m_sht;
@@ -269,6 +283,9 @@ namespace gpopt
 			// private copy ctor
 			CGroup(const CGroup&);
 
+			// make a complete scalar expression visible to other workers
+			void PublishScalarExpression(CExpression *pexpr);
+
 			// cleanup optimization contexts on destruction
 			void CleanupContexts();
 
@@ -289,6 +306,12 @@ namespace gpopt
 			// set hash join keys
 			void SetHashJoinKeys(DrgPexpr *pdrgpexprOuter, DrgPexpr *pdrgpexprInner);
 
+			// is the slot of the next group expression installed
+			BOOL FGExprSlotInstalled() const
+			{
+				return m_sarGExprs.FNextInstalled();
+			}
+
 			// insert new group expression
 			void Insert(CGroupExpression *pgexpr);
 
@@ -307,6 +330,9 @@ namespace gpopt
 			// retrieve next group expression
 			CGroupExpression *PgexprNext(CGroupExpression *pgexpr);
 
+			// retrieve first group expression at or after given position
+			CGroupExpression *PgexprFrom(ULONG_PTR ulpPos) const;
+
 			// return true if first promise is better than second promise
 			BOOL FBetterPromise
 				(
@@ -366,8 +392,9 @@ namespace gpopt
 
 		public:
 
-			// ctor
-			CGroup(IMemoryPool *pmp, BOOL fScalar = false);
+			// ctor; groups of an optimization that runs on a single thread
+			// are counted without atomic operations
+			CGroup(IMemoryPool *pmp, BOOL fScalar, BOOL fSingleThreaded);
 			
 			// dtor
 			~CGroup();
@@ -418,8 +445,13 @@ namespace gpopt
 			}
 
 			// return cached scalar expression
-			CExpression *PexprScalar() const
+			CExpression *PexprScalar()
 			{
+				if (FScalar() && NULL == m_pexprScalar)
+				{
+					WaitScalarExpression();
+				}
+
 				return m_pexprScalar;
 			}
 
@@ -522,6 +554,13 @@ namespace gpopt
 			// merge group with its duplicate - not thread-safe
 			void MergeGroup();
 
+			// install the slot of the next group expression ahead of taking
+			// the locks to insert it, since installing may allocate
+			void InstallGExprSlot()
+			{
+				m_sarGExprs.InstallNext();
+			}
+
 			// lookup a given context in contexts hash table
 			COptimizationContext *PocLookup(IMemoryPool *pmp, CReqdPropPlan *prpp, ULONG ulSearchStageIndex);
 
@@ -543,6 +582,10 @@ namespace gpopt
 			// materialize a dummy cost context attached to the first group expression
 			void CreateDummyCostContext();
 
+			// wait until the worker that added a scalar group has materialized
+			// the group's scalar expression
+			void WaitScalarExpression();
+
 			// return the CTE producer ID in the group (if any)
 			ULONG UlCTEProducerId() const
 			{
@@ -622,9 +665,6 @@ namespace gpopt
 			// print function
 			IOstream &OsPrint(IOstream &os);
 
-			// slink for group list in memo
-			SLink m_link;
-
 #ifdef GPOS_DEBUG
 			// debug print; for interactive debugging sessions only
 			void DbgPrint();
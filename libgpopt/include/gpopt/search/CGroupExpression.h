@@ -119,6 +119,9 @@ namespace gpopt
 			
 			// back pointer to group
 			CGroup *m_pgroup;
+
+			// position in the group's array of group expressions
+			ULONG_PTR m_ulpGroupPos;
 			
 			// id of xform that generated group expression
 			CXform::EXformId m_exfidOrigin;
@@ -204,6 +207,7 @@ namespace gpopt
 				m_pdrgpgroup(NULL),
 				m_pdrgpgroupSorted(NULL),
 				m_pgroup(NULL),
+				m_ulpGroupPos(ULONG_PTR_MAX),
 				m_exfidOrigin(CXform::ExfInvalid),
 				m_pgexprOrigin(NULL),
 				m_fIntermediate(false),
@@ -215,7 +219,8 @@ namespace gpopt
 						
 		public:
 
-			// ctor
+			// ctor; group expressions of an optimization that runs on a
+			// single thread are counted without atomic operations
 			CGroupExpression
 				(
 				IMemoryPool *pmp,
@@ -223,7 +228,8 @@ namespace gpopt
 				DrgPgroup *pdrgpgroup,
 				CXform::EXformId exfid,
 				CGroupExpression *pgexprOrigin,
-				BOOL fIntermediate
+				BOOL fIntermediate,
+				BOOL fSingleThreaded
 				);
 
 			// dtor
@@ -252,8 +258,9 @@ namespace gpopt
 			// check if cost context already exists in group expression hash table
 			BOOL FCostContextExists(COptimizationContext *poc, DrgPoc *pdrgpoc);
 
-			// compute and store expression's cost under a given context
-			CCostContext *PccComputeCost(IMemoryPool *pmp, COptimizationContext *poc, ULONG ulOptReq, DrgPoc *pdrgpoc, BOOL fPruned, CCost costLowerBound);
+			// compute and store expression's cost under a given context;
+			// the cost context is allocated from the given pool of cost contexts
+			CCostContext *PccComputeCost(IMemoryPool *pmp, IMemoryPool *pmpCostContexts, COptimizationContext *poc, ULONG ulOptReq, DrgPoc *pdrgpoc, BOOL fPruned, CCost costLowerBound);
 
 			// compute a cost lower bound for plans, rooted by current group expression, and satisfying the given required properties
 			CCost CostLowerBound(IMemoryPool *pmp, CReqdPropPlan *prppInput, CCostContext *pccChild, ULONG ulChildIndex);
@@ -324,6 +331,21 @@ namespace gpopt
 				return m_pgroup;
 			}
 
+			// accessor for position in the group's array of group expressions
+			ULONG_PTR UlpGroupPos() const
+			{
+				return m_ulpGroupPos;
+			}
+
+			// setter of position in the group's array of group expressions
+			void SetGroupPos
+				(
+				ULONG_PTR ulpPos
+				)
+			{
+				m_ulpGroupPos = ulpPos;
+			}
+
 			// origin xform
 			CXform::EXformId ExfidOrigin() const
 			{
@@ -441,7 +463,7 @@ namespace gpopt
 			// print driver
 			IOstream &OsPrint(IOstream &os, const CHAR * = "");
 
-			// link for list in Group
+			// link for list of duplicates in Group
 			SLink m_linkGroup;
 
 			// link for group expression hash table
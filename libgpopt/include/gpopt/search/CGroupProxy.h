@@ -77,8 +77,9 @@ namespace gpopt
 				m_pgroup->SetHashJoinKeys(pdrgpexprOuter, pdrgpexprInner);
 			}
 
-			// insert group expression
-			void Insert(CGroupExpression *pgexpr);
+			// insert group expression; return false if the slot for it is
+			// not installed
+			BOOL FInsert(CGroupExpression *pgexpr);
 
 			// move duplicate group expression to duplicates list
 			void MoveDuplicateGExpr(CGroupExpression *pgexpr);
@@ -83,6 +83,7 @@ namespace gpopt
 		// friends
 		friend class CJobFactory;
 		friend class CJobQueue;
+		friend class CJobTrace;
 		friend class CScheduler;
 		
 		public:
@@ -294,6 +295,22 @@ namespace gpopt
 			virtual
 			void Cleanup() {}
 
+			// id of the group the job works on, used for tracing;
+			// gpos::ulong_max if job does not work on a group
+			virtual
+			ULONG UlGroupId() const
+			{
+				return gpos::ulong_max;
+			}
+
+			// id of the xform the job applies, used for tracing;
+			// gpos::ulong_max if job does not apply an xform
+			virtual
+			ULONG UlXformId() const
+			{
+				return gpos::ulong_max;
+			}
+
 #ifdef GPOS_DEBUG
 			// print job description
 			virtual
@@ -88,6 +88,12 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+		public:
+
+			// id of target group
+			virtual
+			ULONG UlGroupId() const;
+
 	}; // class CJobGroup
 
 }
@@ -113,6 +113,12 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+		public:
+
+			// id of the group of target group expression
+			virtual
+			ULONG UlGroupId() const;
+
 	}; // class CJobGroupExpression
 
 }
@@ -13,12 +13,13 @@
 #define GPOPT_CJobQueue_H
 
 #include "gpos/base.h"
-#include "gpos/common/CList.h"
-#include "gpos/sync/CSpinlock.h"
+#include "gpos/sync/atomic.h"
 
-#include "gpopt/spinlock.h"
 #include "gpopt/search/CJob.h"
 
+// value of the list of waiting jobs once the main job has completed
+#define GPOPT_JOBQUEUE_COMPLETED ((ULONG_PTR) 1)
+
 namespace gpopt
 {
 	using namespace gpos;
@@ -30,22 +31,35 @@ namespace gpopt
 	//	@doc:
 	//		Forces unique execution of an operation assigned to many jobs.
 	//
+	//		Jobs are pushed to a lock-free list of waiting jobs; the job that
+	//		finds the list empty becomes the main job. On completion, the main
+	//		job atomically detaches the list and marks it as completed, so
+	//		that later jobs do not wait.
+	//
 	//---------------------------------------------------------------------------
 	class CJobQueue
 	{
 		private:
 
 			// main job
-			volatile CJob *m_pj;
+			CJob * volatile m_pj;
 
-			// flag indicating if main job has completed
-			volatile BOOL m_fCompleted;
+			// list of jobs waiting for main job to complete, linked through
+			// CJob::m_linkQueue, including main job;
+			// GPOPT_JOBQUEUE_COMPLETED once main job has completed
+			volatile ULONG_PTR m_ulpQueued;
 
-			// list of jobs waiting for main job to complete
-			CList<CJob> m_listjQueued;
+			// check if main job has completed
+			BOOL FCompleted() const
+			{
+				return GPOPT_JOBQUEUE_COMPLETED == m_ulpQueued;
+			}
 
-			// lock protecting queue
-			CSpinlockJobQueue m_slock;
+			// check if no job is waiting
+			BOOL FNoneWaiting() const
+			{
+				return 0 == m_ulpQueued || FCompleted();
+			}
 
 		public:
 
@@ -61,10 +75,8 @@ namespace gpopt
 			CJobQueue()
 				:
 				m_pj(NULL),
-				m_fCompleted(false)
-			{
-				m_listjQueued.Init(GPOS_OFFSET(CJob, m_linkQueue));
-			}
+				m_ulpQueued(0)
+			{}
 
 			// dtor
 			~CJobQueue()
@@ -73,17 +85,17 @@ namespace gpopt
 					(
 					NULL != ITask::PtskSelf() &&
 					!ITask::PtskSelf()->FPendingExc(),
-					m_listjQueued.FEmpty()
+					FNoneWaiting()
 					);
 			}
 
 			// reset job queue
 			void Reset()
 			{
-				GPOS_ASSERT(m_listjQueued.FEmpty());
+				GPOS_ASSERT(FNoneWaiting());
 
 				m_pj = NULL;
-				m_fCompleted = false;
+				m_ulpQueued = 0;
 			}
 
 			// add job as a waiter;
@@ -19,6 +19,7 @@
 
 #include "gpopt/base/CStateMachine.h"
 #include "gpopt/engine/CEngine.h"
+#include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 
 namespace gpopt
@@ -153,8 +154,9 @@ namespace gpopt
                 TEnumState estNext = estSentinel;
                 do
                 {
-                    // check if current search stage is timed-out
-                    if (psc->Peng()->PssCurrent()->FTimedOut())
+                    // check if current search stage is timed-out, or if
+                    // optimization deadline has passed with a plan ready
+                    if (psc->Peng()->PssCurrent()->FTimedOut() || psc->Psched()->FDeadlineExpired())
                     {
                         // cleanup job state and terminate state machine
                         pjOwner->Cleanup();
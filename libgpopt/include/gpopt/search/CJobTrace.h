@@ -0,0 +1,160 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CJobTrace.h
+//
+//	@doc:
+//		Per-worker recording of optimization job events
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CJobTrace_H
+#define GPOPT_CJobTrace_H
+
+#include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
+
+#include "gpopt/search/CJob.h"
+
+// default number of events kept per worker
+#define GPOPT_JOB_TRACE_EVENTS	(64 * 1024)
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CJobTrace
+	//
+	//	@doc:
+	//		Timeline of job executions of an optimization.
+	//
+	//		Each worker records events into its own ring buffer; a slot is
+	//		reserved by atomically advancing the ring's position, so recording
+	//		takes no locks. When a ring is full, the oldest events are
+	//		overwritten.
+	//
+	//		Every execution slice of a job is recorded with its start time,
+	//		duration and outcome (completed, suspended, runnable); resuming a
+	//		suspended job is recorded as an instant event. Events carry the
+	//		job type, job id, group id and applied xform.
+	//
+	//		The trace is exported in Chrome trace-event format, which can be
+	//		loaded into chrome://tracing or similar viewers; exporting is not
+	//		thread-safe and must happen after all workers are done.
+	//
+	//---------------------------------------------------------------------------
+	class CJobTrace
+	{
+		public:
+
+			// event types
+			enum EEventType
+			{
+				EetCompleted = 0,	// job executed and completed
+				EetSuspended,		// job executed and waits for children
+				EetRunnable,		// job executed and can resume immediately
+				EetResumed,			// suspended job was resumed
+
+				EetSentinel
+			};
+
+			// recorded event
+			struct SEvent
+			{
+				// event type
+				EEventType m_eet;
+
+				// job type
+				CJob::EJobType m_ejt;
+
+				// job id
+				ULONG m_ulJobId;
+
+				// group id, gpos::ulong_max if none
+				ULONG m_ulGroupId;
+
+				// xform id, gpos::ulong_max if none
+				ULONG m_ulXformId;
+
+				// start time, in microseconds since trace start
+				ULONG m_ulStartUs;
+
+				// duration in microseconds
+				ULONG m_ulDurationUs;
+			};
+
+		private:
+
+			// ring buffer of a worker
+			struct SRing
+			{
+				// number of events recorded
+				volatile ULONG_PTR m_ulpRecorded;
+
+				// events
+				SEvent *m_rgev;
+			};
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// number of rings
+			const ULONG m_ulWorkers;
+
+			// number of events per ring
+			const ULONG m_ulEvents;
+
+			// rings
+			SRing *m_rgring;
+
+			// clock started when the trace is created
+			CWallClock m_clock;
+
+			// record an event in a worker's ring
+			void Record(ULONG ulWorker, const SEvent &ev);
+
+			// print a recorded event
+			IOstream &OsPrintEvent(IOstream &os, ULONG ulWorker, const SEvent &ev) const;
+
+			// private copy ctor
+			CJobTrace(const CJobTrace &);
+
+		public:
+
+			// ctor
+			CJobTrace(IMemoryPool *pmp, ULONG ulWorkers, ULONG ulEvents = GPOPT_JOB_TRACE_EVENTS);
+
+			// dtor
+			~CJobTrace();
+
+			// microseconds since trace start
+			ULONG UlElapsedUS() const
+			{
+				return m_clock.UlElapsedUS();
+			}
+
+			// start recording an execution slice of a job; the job is
+			// described in the given event since it may be released or
+			// resumed by another worker before the slice is recorded
+			void BeginExecution(SEvent *pev, CJob *pj) const;
+
+			// record an execution slice with the given outcome
+			void EndExecution(ULONG ulWorker, SEvent *pev, EEventType eet);
+
+			// record the resumption of a suspended job
+			void RecordResume(ULONG ulWorker, CJob *pj);
+
+			// number of events kept for a worker
+			ULONG UlEvents(ULONG ulWorker) const;
+
+			// export events in Chrome trace-event format
+			IOstream &OsPrintChromeTrace(IOstream &os) const;
+
+	}; // class CJobTrace
+}
+
+#endif // !GPOPT_CJobTrace_H
+
+// EOF
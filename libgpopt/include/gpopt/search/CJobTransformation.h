@@ -100,6 +100,14 @@ namespace gpopt
 			virtual
 			BOOL FExecute(CSchedulerContext *psc);
 
+			// id of the group of target group expression
+			virtual
+			ULONG UlGroupId() const;
+
+			// id of the xform to apply
+			virtual
+			ULONG UlXformId() const;
+
 #ifdef GPOS_DEBUG
 
 			// print function
@@ -14,8 +14,10 @@
 #include "gpos/base.h"
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/CSyncHashtable.h"
-#include "gpos/common/CSyncList.h"
+#include "gpos/common/CSyncSegmentedArray.h"
 #include "gpos/sync/CAtomicCounter.h"
+#include "gpos/sync/CEvent.h"
+#include "gpos/sync/CMutex.h"
 
 #include "gpopt/spinlock.h"
 #include "gpopt/search/CGroupExpression.h"
@@ -68,21 +70,24 @@ namespace gpopt
 
 			// memory pool
 			IMemoryPool *m_pmp;
-		
-			// id counter for groups
-			CAtomicULONG m_aul;
 
+			// are groups only referenced by the optimizing thread
+			BOOL m_fSingleThreaded;
+		
 			// root group
 			CGroup *m_pgroupRoot;
 
-			// number of groups
-			volatile ULONG_PTR m_ulpGrps;
-
 			// tree map of member group expressions
 			MemoTreeMap *m_pmemotmap;
 
-			// list of groups
-			CSyncList<CGroup> m_listGroups;
+			// number of times stats of memo groups were derived by parallel jobs
+			ULONG m_ulParallelStatsDerivations;
+
+			// groups indexed by id; an id is reserved before the hash table
+			// is locked, so a slot is NULL while its group is added, and stays
+			// NULL if the group expression was inserted by another worker
+			// meanwhile; iteration starts from the most recently added group
+			CSyncSegmentedArray<CGroup> m_sarGroups;
 
 			// hashtable of all group expressions
 			CSyncHashtable<
@@ -90,26 +95,72 @@ namespace gpopt
 				CGroupExpression, // search key
 				CSpinlockMemo> m_sht;
 
-			// add new group
-			void Add(CGroup *pgroup, CExpression *pexprOrigin);
+			// add new group with reserved id
+			void Add(CGroup *pgroup, CExpression *pexprOrigin, ULONG ulId);
 
 			// rehash all group expressions after group merge - not thread-safe
 			BOOL FRehash();
 
 			// helper for inserting group expression in target group
-			CGroup *PgroupInsert(CGroup *pgroupTarget, CGroupExpression *pgexpr, CExpression *pexprOrigin, BOOL fNewGroup);
+			CGroup *PgroupInsert(CGroup *pgroupTarget, CGroupExpression *pgexpr, CExpression *pexprOrigin, ULONG ulNewGroupId);
 
 			// helper to check if a new group needs to be created
 			BOOL FNewGroup(CGroup **ppgroupTarget, CGroupExpression *pgexpr, BOOL fScalar);
 
+			// shared state of parallel stats derivation
+			struct SStatsDerivation
+			{
+				// memory pools
+				IMemoryPool *m_pmpLocal;
+				IMemoryPool *m_pmpGlobal;
+
+				// groups to derive stats on, ordered by level
+				CGroup **m_rgpgroup;
+
+				// for each group, index of the first group on its level
+				ULONG *m_rgulLevelStart;
+
+				// number of groups
+				ULONG m_ulGroups;
+
+				// index of next group to claim
+				volatile ULONG_PTR m_ulpNext;
+
+				// number of groups with derived stats
+				ULONG_PTR m_ulpDone;
+
+				// first task that failed, if any
+				CTask *m_ptskFailed;
+
+				// mutex protecting the number of done groups and the failed task
+				CMutex m_mutex;
+
+				// event signaled when a group is done or a task failed
+				CEvent m_event;
+			};
+
+			// compute stats derivation level of a logical group; groups
+			// are on a higher level than all their logical child groups
+			ULONG UlStatsLevel(CGroup *pgroup, ULONG *rgulLevel);
+
+			// derive stats of groups without stats on multiple workers
+			void DeriveStatsParallel(IMemoryPool *pmpLocal, ULONG ulWorkers);
+
+			// derive stats on claimed groups until all groups are claimed
+			static
+			void DeriveStats(SStatsDerivation *psd);
+
+			// task function of parallel stats derivation
+			static
+			void *PvDeriveStats(void *pv);
+
 			// private copy ctor
 			CMemo(const CMemo &);
 						
 		public:
 		
 			// ctor
-			explicit
-			CMemo(IMemoryPool *pmp);
+			CMemo(IMemoryPool *pmp, IMemoryPool *pmpIndex, BOOL fSingleThreaded);
 			
 			// dtor
 			~CMemo();
@@ -120,10 +171,11 @@ namespace gpopt
 				return m_pgroupRoot;
 			}
 
-			// return number of groups
+			// return number of group ids, counting ids of groups that were
+			// not added
 			ULONG_PTR UlpGroups() const
 			{
-				return m_ulpGrps;
+				return m_sarGroups.UlpSize();
 			}
 
 			// return total number of group expressions
@@ -162,8 +214,16 @@ namespace gpopt
 			// print driver
 			IOstream &OsPrint(IOstream &os);
 
-			// derive stats when no stats not present for the group
-			void DeriveStatsIfAbsent(IMemoryPool *pmp);
+			// derive stats when no stats not present for the group;
+			// large memos are processed on the given number of workers when
+			// parallel optimization is enabled
+			void DeriveStatsIfAbsent(IMemoryPool *pmp, ULONG ulWorkers = 1);
+
+			// number of times stats of memo groups were derived by parallel jobs
+			ULONG UlParallelStatsDerivations() const
+			{
+				return m_ulParallelStatsDerivations;
+			}
 
 			// build tree map
 			void BuildTreeMap(COptimizationContext *poc);
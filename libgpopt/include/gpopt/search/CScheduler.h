@@ -14,18 +14,29 @@
 #include "gpos/base.h"
 #include "gpos/common/CSyncList.h"
 #include "gpos/common/CSyncPool.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/sync/CEvent.h"
 
+#include "gpopt/spinlock.h"
 #include "gpopt/search/CJob.h"
 
+// maximum number of queued jobs per active worker before waking up another worker
 #define OPT_SCHED_QUEUED_RUNNING_RATIO 10
 #define OPT_SCHED_CFA 100
 
+// estimated cost, in microseconds, of waking up a worker
+#define OPT_SCHED_WAKEUP_COST_US 100
+
+// factor by which the backlog of a worker must fall below the wake-up
+// threshold before the worker is parked
+#define OPT_SCHED_SHRINK_FACTOR 4
+
 namespace gpopt
 {
 	using namespace gpos;
 	
 	// prototypes
+	class CJobTrace;
 	class CSchedulerContext;
 
 	//---------------------------------------------------------------------------
@@ -52,6 +63,23 @@ namespace gpopt
 	//		complete. At this point, a queued job can be terminated if it does not
 	//		have any further dependencies.
 	//
+	//		Runnable jobs are kept in per-worker deques. A worker pushes the jobs
+	//		it spawns or resumes to the tail of its own deque and pops from the
+	//		tail (LIFO), so that it keeps working on the most recent part of the
+	//		search space. An idle worker steals from the head (FIFO) of other
+	//		workers' deques, thereby picking up the oldest, and typically
+	//		largest, pieces of work. Jobs added from outside of a worker go to a
+	//		shared list that all workers check before stealing.
+	//
+	//		The scheduler may be given a deadline, which is checked whenever a
+	//		job is dispatched. Past the exploration part of the deadline, the
+	//		engine stops exploring, so that queued exploration jobs complete
+	//		without applying xforms and workers turn to implementing and
+	//		optimizing the memo explored so far. Once the deadline has passed
+	//		and the root group has a plan, all outstanding jobs are abandoned.
+	//		Jobs are never abandoned before a plan exists, hence the deadline
+	//		may be overrun by the time needed to find the first plan.
+	//
 	//---------------------------------------------------------------------------
 	class CScheduler
 	{	
@@ -92,13 +120,29 @@ namespace gpopt
 				}
 			};
 
+			// deque of runnable jobs owned by a worker
+			struct SWorkerQueue
+			{
+				// spinlock protecting the deque
+				CSpinlockScheduler m_slock;
+
+				// jobs; owner works at the tail, thieves at the head
+				CList<SJobLink> m_listjl;
+			};
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
 			// mutex and event mechanism for individual workers
 			CMutex m_mutex;
 			CEvent m_event;
 					
-			// list of jobs waiting to execute
+			// list of jobs waiting to execute, added from outside of workers
 			CSyncList<SJobLink> m_listjlWaiting;
 
+			// per-worker deques of jobs waiting to execute
+			SWorkerQueue *m_rgwq;
+
 			// pool of job link objects
 			CSyncPool<SJobLink> m_spjl;
 
@@ -108,14 +152,37 @@ namespace gpopt
 			// number of active tasks;
 			volatile ULONG_PTR m_ulpTasksActive;
 
+			// number of workers that registered with the scheduler
+			volatile ULONG_PTR m_ulpWorkers;
+
+			// moving average of job execution time, in microseconds
+			volatile ULONG_PTR m_ulpJobTimeUs;
+
 			// current job counters
 			volatile ULONG_PTR m_ulpTotal;
 			volatile ULONG_PTR m_ulpRunning;
 			volatile ULONG_PTR m_ulpQueued;
 
+			// timeline of job executions, NULL if not tracing
+			CJobTrace *m_pjtrace;
+
+			// clock started when the deadline is set
+			CWallClock m_clockDeadline;
+
+			// milliseconds after which exploration stops, gpos::ulong_max if none
+			ULONG m_ulExplorationDeadlineMs;
+
+			// milliseconds after which outstanding jobs are abandoned once a
+			// plan exists, gpos::ulong_max if none
+			ULONG m_ulDeadlineMs;
+
+			// has the deadline passed with a plan for the root group
+			volatile BOOL m_fDeadlineExpired;
+
 			// stats
 			volatile ULONG_PTR m_ulpStatsQueued;
 			volatile ULONG_PTR m_ulpStatsDequeued;
+			volatile ULONG_PTR m_ulpStatsStolen;
 			volatile ULONG_PTR m_ulpStatsSuspended;
 			volatile ULONG_PTR m_ulpStatsCompleted;
 			volatile ULONG_PTR m_ulpStatsCompletedQueued;
@@ -147,11 +214,20 @@ namespace gpopt
 				BOOL fCompleted
 				);
 
+			// assign a deque to the worker running the given context
+			void RegisterWorker(CSchedulerContext *psc);
+
 			// retrieve next job to run
-			CJob *PjRetrieve();
+			CJob *PjRetrieve(CSchedulerContext *psc);
+
+			// pop job link from the tail of a worker's deque
+			SJobLink *PjlPop(ULONG ulWorker);
+
+			// steal job link from the head of another worker's deque
+			SJobLink *PjlSteal(ULONG ulWorker);
 
 			// schedule job for execution
-			void Schedule(CJob *pj);
+			void Schedule(CJob *pj, CSchedulerContext *psc);
 
 			// prepare for job execution
 			void PreExecute(CJob *pj);
@@ -163,7 +239,14 @@ namespace gpopt
 			EJobResult EjrPostExecute(CJob *pj, BOOL fCompleted);
 
 			// resume parent job
-			void ResumeParent(CJob *pj);
+			void ResumeParent(CJob *pj, CSchedulerContext *psc);
+
+			// check deadline before dispatching a job
+			void CheckDeadline(CSchedulerContext *psc);
+
+			// index of the trace ring to record events of the given context
+			static
+			ULONG UlTraceWorker(CSchedulerContext *psc);
 
 			// check if all jobs have completed
 			BOOL FEmpty() const
@@ -183,6 +266,27 @@ namespace gpopt
 				(void) UlpExchangeAdd(&m_ulpTasksActive, -1);
 			}
 
+			// record execution time of a job
+			void RecordJobTime
+				(
+				ULONG ulTimeUs
+				)
+			{
+				// races between workers only lose samples
+				m_ulpJobTimeUs = (7 * m_ulpJobTimeUs + ulTimeUs) / 8;
+			}
+
+			// number of queued jobs per active worker worth waking up another
+			// worker for; the shorter jobs run, the more of them are needed to
+			// amortize the wake-up
+			ULONG_PTR UlpQueuedRunningRatio() const
+			{
+				ULONG_PTR ulpJobTimeUs = std::max((ULONG_PTR) 1, (ULONG_PTR) m_ulpJobTimeUs);
+				ULONG_PTR ulpRatio = OPT_SCHED_WAKEUP_COST_US / ulpJobTimeUs;
+
+				return std::max((ULONG_PTR) 1, std::min((ULONG_PTR) OPT_SCHED_QUEUED_RUNNING_RATIO, ulpRatio));
+			}
+
 			// check if there is enough work for more workers
 			BOOL FIncreaseWorkers() const
 			{
@@ -190,11 +294,25 @@ namespace gpopt
 				return
 					(
 					m_ulpTasksMax > m_ulpTasksActive &&
-					(OPT_SCHED_QUEUED_RUNNING_RATIO < m_ulpQueued / (m_ulpTasksActive + 1))
+					(UlpQueuedRunningRatio() < m_ulpQueued / (m_ulpTasksActive + 1))
 				    )
 				    ;
 			}
 
+			// check if the remaining workers can keep up with queued work
+			// without the current one; thresholds leave a gap to
+			// FIncreaseWorkers to avoid waking up and parking repeatedly
+			BOOL FDecreaseWorkers() const
+			{
+				ULONG_PTR ulpTasksActive = m_ulpTasksActive;
+				return
+					(
+					1 < ulpTasksActive &&
+					m_ulpQueued * OPT_SCHED_SHRINK_FACTOR < UlpQueuedRunningRatio() * (ulpTasksActive - 1)
+					)
+					;
+			}
+
 			// no copy ctor
 			CScheduler(const CScheduler&);
 
@@ -220,22 +338,44 @@ namespace gpopt
 			void *Run(void*);
 
 			// transition job to completed
-			void Complete(CJob *pj);
+			void Complete(CJob *pj, CSchedulerContext *psc);
 
 			// transition queued job to completed
-			void CompleteQueued(CJob *pj);
+			void CompleteQueued(CJob *pj, CSchedulerContext *psc);
 
 			// transition job to suspended
 			void Suspend(CJob *pj);
 			
-			// add new job for scheduling
-			void Add(CJob *pj, CJob *pjParent);
+			// add new job for scheduling; the job is queued at the worker
+			// running the given context, or in the shared list if the context
+			// is NULL or does not belong to a worker
+			void Add(CJob *pj, CJob *pjParent, CSchedulerContext *psc);
 
 			// resume suspended job
-			void Resume(CJob *pj);
+			void Resume(CJob *pj, CSchedulerContext *psc);
 
 			// print statistics
 			void PrintStats() const;
+
+			// record job executions in the given trace
+			void SetJobTrace
+				(
+				CJobTrace *pjtrace
+				)
+			{
+				m_pjtrace = pjtrace;
+			}
+
+			// set deadline, in milliseconds from now, for stopping exploration
+			// and for abandoning outstanding jobs
+			void SetDeadline(ULONG ulExplorationDeadlineMs, ULONG ulDeadlineMs);
+
+			// has the deadline passed with a plan for the root group; if so,
+			// jobs terminate at their next step
+			BOOL FDeadlineExpired() const
+			{
+				return m_fDeadlineExpired;
+			}
 			
 #ifdef GPOS_DEBUG
 			// get flag for tracking jobs
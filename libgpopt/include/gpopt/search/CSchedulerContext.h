@@ -51,6 +51,10 @@ namespace gpopt
 			// optimization engine
 			CEngine *m_peng;
 
+			// index of the scheduler's job deque owned by the worker running
+			// this context; gpos::ulong_max if context does not run jobs
+			ULONG m_ulWorker;
+
 			// flag indicating if context has been initialized
 			BOOL m_fInit;
 
@@ -114,6 +118,29 @@ namespace gpopt
 				return m_peng;
 			}
 
+			// does context belong to a worker running jobs
+			BOOL FWorker() const
+			{
+				return gpos::ulong_max != m_ulWorker;
+			}
+
+			// index of the worker's job deque
+			ULONG UlWorker() const
+			{
+				GPOS_ASSERT(FWorker());
+				return m_ulWorker;
+			}
+
+			// bind context to a worker's job deque
+			void SetWorker
+				(
+				ULONG ulWorker
+				)
+			{
+				GPOS_ASSERT(!FWorker());
+				m_ulWorker = ulWorker;
+			}
+
 	}; // class CSchedulerContext
 }
 
@@ -19,8 +19,11 @@ namespace gpopt
 
 	// OPTIMIZER SPINLOCKS - reserve range 200-400
 
-	// spinlock used in job queues
-	typedef CSpinlockRanked<210> CSpinlockJobQueue;
+	// spinlock used in scheduler's per-worker job deques
+	typedef CSpinlockRanked<200> CSpinlockScheduler;
+
+	// spinlock used in column set factory
+	typedef CSpinlockRanked<210> CSpinlockColRefSetFactory;
 
 	// spinlock used in column factory
 	typedef CSpinlockRanked<220> CSpinlockColumnFactory;
@@ -34,7 +34,8 @@ CColRefSet::CColRefSet
 	ULONG ulSizeBits
 	)
 	:
-	CBitSet(pmp, ulSizeBits)
+	CBitSet(pmp, ulSizeBits),
+	m_fInterned(false)
 {}
 
 
@@ -52,7 +53,8 @@ CColRefSet::CColRefSet
 	const CColRefSet &bs
 	)
 	:
-	CBitSet(pmp, bs)
+	CBitSet(pmp, bs),
+	m_fInterned(false)
 {}
 
 
@@ -71,7 +73,8 @@ CColRefSet::CColRefSet
 	ULONG ulSize
 	)
 	:
-	CBitSet(pmp, ulSize)
+	CBitSet(pmp, ulSize),
+	m_fInterned(false)
 {
 	Include(pdrgpcr);
 }
@@ -158,6 +161,8 @@ CColRefSet::Include
 	const CColRef *pcr
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	CBitSet::FExchangeSet(pcr->UlId());
 }
 
@@ -176,6 +181,8 @@ CColRefSet::Include
 	const DrgPcr *pdrgpcr
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	ULONG ulLength = pdrgpcr->UlLength();
 	for (ULONG i = 0; i < ulLength; i++)
 	{
@@ -198,6 +205,8 @@ CColRefSet::Include
 	const CColRefSet *pcrs
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	CColRefSetIter crsi(*pcrs);
 	while(crsi.FAdvance())
 	{
@@ -220,6 +229,8 @@ CColRefSet::Exclude
 	const CColRef *pcr
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	CBitSet::FExchangeClear(pcr->UlId());
 }
 
@@ -238,6 +249,8 @@ CColRefSet::Exclude
 	const CColRefSet *pcrs
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	CColRefSetIter crsi(*pcrs);
 	while(crsi.FAdvance())
 	{
@@ -260,6 +273,8 @@ CColRefSet::Exclude
 	const DrgPcr *pdrgpcr
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	for (ULONG i = 0; i < pdrgpcr->UlLength(); i++)
 	{
 		Exclude((*pdrgpcr)[i]);
@@ -282,6 +297,8 @@ CColRefSet::Replace
 	const CColRef *pcrIn
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	if (FMember(pcrOut))
 	{
 		Exclude(pcrOut);
@@ -305,6 +322,8 @@ CColRefSet::Replace
 	const DrgPcr *pdrgpcrIn
 	)
 {
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
 	const ULONG ulLen = pdrgpcrOut->UlLength();
 	GPOS_ASSERT(ulLen == pdrgpcrIn->UlLength());
 
@@ -315,6 +334,66 @@ CColRefSet::Replace
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSet::Union
+//
+//	@doc:
+//		Union with given set
+//
+//---------------------------------------------------------------------------
+void
+CColRefSet::Union
+	(
+	const CBitSet *pbs
+	)
+{
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
+	CBitSet::Union(pbs);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSet::Intersection
+//
+//	@doc:
+//		Intersect with given set
+//
+//---------------------------------------------------------------------------
+void
+CColRefSet::Intersection
+	(
+	const CBitSet *pbs
+	)
+{
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
+	CBitSet::Intersection(pbs);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSet::Difference
+//
+//	@doc:
+//		Remove members of given set
+//
+//---------------------------------------------------------------------------
+void
+CColRefSet::Difference
+	(
+	const CBitSet *pbs
+	)
+{
+	GPOS_ASSERT(!m_fInterned && "Shared column sets are immutable");
+
+	CBitSet::Difference(pbs);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CColRefSet::Pdrgpcr
@@ -0,0 +1,306 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CColRefSetFactory.cpp
+//
+//	@doc:
+//		Implementation of sharing of equal column sets
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/atomic.h"
+
+#include "gpopt/base/CColRefSetFactory.h"
+
+using namespace gpopt;
+
+// invalid key
+const CColRefSet *CColRefSetFactory::m_pcrsInvalid = NULL;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::CColRefSetFactory
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CColRefSetFactory::CColRefSetFactory
+	(
+	IMemoryPool *pmp,
+	BOOL fSingleThreaded
+	)
+	:
+	m_pmp(pmp),
+	m_fSingleThreaded(fSingleThreaded),
+	m_pcrsEmpty(NULL),
+	m_ulpSweepThreshold(GPOPT_COLREFSET_FACTORY_SWEEP_MIN),
+	m_ulSweeping(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	m_sht.Init
+		(
+		m_pmp,
+		GPOPT_COLREFSET_FACTORY_HT_BUCKETS,
+		GPOS_OFFSET(SEntry, m_link),
+		GPOS_OFFSET(SEntry, m_pcrs),
+		&m_pcrsInvalid,
+		UlHash,
+		FEqual
+		);
+
+	m_pcrsEmpty = GPOS_NEW(m_pmp) CColRefSet(m_pmp);
+	m_pcrsEmpty->m_fInterned = true;
+	if (m_fSingleThreaded)
+	{
+		m_pcrsEmpty->SetSingleThreaded();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::~CColRefSetFactory
+//
+//	@doc:
+//		Dtor; releases the shared sets
+//
+//---------------------------------------------------------------------------
+CColRefSetFactory::~CColRefSetFactory()
+{
+	m_sht.DestroyEntries(DestroyEntry);
+	m_pcrsEmpty->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::UlHash
+//
+//	@doc:
+//		Hash of a set's contents
+//
+//---------------------------------------------------------------------------
+ULONG
+CColRefSetFactory::UlHash
+	(
+	const CColRefSet * const &pcrs
+	)
+{
+	GPOS_ASSERT(NULL != pcrs);
+
+	return pcrs->CBitSet::UlHash();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::FEqual
+//
+//	@doc:
+//		Equality of the sets' contents
+//
+//---------------------------------------------------------------------------
+BOOL
+CColRefSetFactory::FEqual
+	(
+	const CColRefSet * const &pcrsFst,
+	const CColRefSet * const &pcrsSnd
+	)
+{
+	if (NULL == pcrsFst || NULL == pcrsSnd)
+	{
+		return pcrsFst == pcrsSnd;
+	}
+
+	return pcrsFst->FEqual(pcrsSnd);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::DestroyEntry
+//
+//	@doc:
+//		Release a shared set and its entry
+//
+//---------------------------------------------------------------------------
+void
+CColRefSetFactory::DestroyEntry
+	(
+	SEntry *pentry
+	)
+{
+	const_cast<CColRefSet *>(pentry->m_pcrs)->Release();
+	GPOS_DELETE(pentry);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::Sweep
+//
+//	@doc:
+//		Drop shared sets that are only referenced by the factory; the factory
+//		adds references to shared sets only under the table's lock, so a set
+//		found with a single reference under that lock is no longer in use.
+//		Dropped entries are released after the lock is given up; the iterator
+//		steps over the entry following a dropped one, which is left for the
+//		next sweep.
+//
+//---------------------------------------------------------------------------
+void
+CColRefSetFactory::Sweep()
+{
+	CList<SEntry> listDropped;
+	listDropped.Init(GPOS_OFFSET(SEntry, m_link));
+
+	// scope for table iterator
+	{
+		SetTableIter shtit(m_sht);
+		while (shtit.FAdvance())
+		{
+			SetTableIterAccessor shtitacc(shtit);
+			SEntry *pentry = shtitacc.Pt();
+			if (NULL != pentry && 1 == pentry->m_pcrs->UlpRefCount())
+			{
+				shtitacc.Remove(pentry);
+				listDropped.Append(pentry);
+			}
+		}
+	}
+
+	while (!listDropped.FEmpty())
+	{
+		DestroyEntry(listDropped.RemoveHead());
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetFactory::PcrsIntern
+//
+//	@doc:
+//		Return the shared set equal to the given set. A set that is not
+//		shared yet is adopted if the caller holds its only reference and it
+//		lives in the factory's pool, otherwise it is copied to the factory's
+//		pool; the new entry is prepared outside of the table's lock and
+//		dropped if another worker shared an equal set meanwhile. Inserting
+//		sweeps the table once the number of shared sets doubled since the
+//		last sweep.
+//
+//---------------------------------------------------------------------------
+CColRefSet *
+CColRefSetFactory::PcrsIntern
+	(
+	CColRefSet *pcrs
+	)
+{
+	GPOS_ASSERT(NULL != pcrs);
+
+	if (pcrs->FInterned())
+	{
+		// reference to a shared set is passed through
+		return pcrs;
+	}
+
+	if (0 == pcrs->CElements())
+	{
+		pcrs->Release();
+		m_pcrsEmpty->AddRef();
+
+		return m_pcrsEmpty;
+	}
+
+	const CColRefSet *pcrsKey = pcrs;
+	CColRefSet *pcrsShared = NULL;
+
+	// scope for table accessor
+	{
+		SetTableAccessor shta(m_sht, pcrsKey);
+
+		SEntry *pentry = shta.PtLookup();
+		if (NULL != pentry)
+		{
+			pcrsShared = const_cast<CColRefSet *>(pentry->m_pcrs);
+			pcrsShared->AddRef();
+		}
+	}
+
+	if (NULL != pcrsShared)
+	{
+		pcrs->Release();
+
+		return pcrsShared;
+	}
+
+	CColRefSet *pcrsNew = pcrs;
+	if (m_pmp == pcrs->m_pmp && 1 == pcrs->UlpRefCount())
+	{
+		// take over the caller's reference
+		pcrs = NULL;
+	}
+	else
+	{
+		pcrsNew = GPOS_NEW(m_pmp) CColRefSet(m_pmp, *pcrs);
+	}
+	pcrsNew->m_fInterned = true;
+	if (m_fSingleThreaded)
+	{
+		// the new set is not reachable by other threads yet
+		pcrsNew->SetSingleThreaded();
+	}
+
+	SEntry *pentryNew = GPOS_NEW(m_pmp) SEntry;
+	pentryNew->m_pcrs = pcrsNew;
+
+	BOOL fInserted = false;
+
+	// scope for table accessor
+	{
+		SetTableAccessor shta(m_sht, pcrsKey);
+
+		SEntry *pentry = shta.PtLookup();
+		if (NULL == pentry)
+		{
+			shta.Insert(pentryNew);
+			pentry = pentryNew;
+			pentryNew = NULL;
+			fInserted = true;
+		}
+
+		pcrsShared = const_cast<CColRefSet *>(pentry->m_pcrs);
+		pcrsShared->AddRef();
+	}
+
+	if (NULL != pentryNew)
+	{
+		// another worker shared an equal set first
+		DestroyEntry(pentryNew);
+	}
+
+	if (NULL != pcrs)
+	{
+		pcrs->Release();
+	}
+
+	if (fInserted &&
+		m_sht.UlpEntries() >= m_ulpSweepThreshold &&
+		FCompareSwap(&m_ulSweeping, 0, 1))
+	{
+		Sweep();
+
+		m_ulpSweepThreshold =
+			std::max((ULONG_PTR) GPOPT_COLREFSET_FACTORY_SWEEP_MIN, 2 * m_sht.UlpEntries());
+		m_ulSweeping = 0;
+	}
+
+	return pcrsShared;
+}
+
+// EOF
@@ -50,6 +50,7 @@ CCostContext::CCostContext
 	CGroupExpression *pgexpr
 	)
 	:
+	CRefCount(pgexpr->FSingleThreaded()),
 	m_pmp(pmp),
 	m_cost(GPOPT_INVALID_COST),
 	m_estate(estUncosted),
@@ -19,6 +19,7 @@
 #include "gpopt/base/CReqdPropPlan.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPhysicalCTEConsumer.h"
+#include "gpopt/search/CGroupExpression.h"
 
 
 using namespace gpopt;
@@ -88,7 +89,9 @@ CDrvdPropPlan::Pdpplan
 //		CDrvdPropPlan::Derive
 //
 //	@doc:
-//		Derive plan props
+//		Derive plan props; properties derived for a group expression of a
+//		single-threaded memo are counted without atomic operations unless
+//		they are shared with other expressions
 //
 //---------------------------------------------------------------------------
 void
@@ -118,6 +121,14 @@ CDrvdPropPlan::Derive
 	}
 
 	m_pcm = popPhysical->PcmDerive(pmp, exprhdl);
+
+	CGroupExpression *pgexpr = exprhdl.Pgexpr();
+	if (NULL != pgexpr && pgexpr->FSingleThreaded())
+	{
+		SafeSetSingleThreaded(this);
+		SafeSetSingleThreaded(m_pos);
+		SafeSetSingleThreaded(m_pds);
+	}
 }
 
 
@@ -20,6 +20,7 @@
 #include "gpopt/base/CReqdPropPlan.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/base/CColRefSet.h"
+#include "gpopt/base/COptCtxt.h"
 #include "gpopt/base/CKeyCollection.h"
 #include "gpopt/base/CPartInfo.h"
 
@@ -100,17 +101,27 @@ CDrvdPropRelational::Derive
 
 	CLogical *popLogical = CLogical::PopConvert(exprhdl.Pop());
 
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	if (poctxt->FSingleThreaded())
+	{
+		// the properties are only referenced by the optimizing thread
+		SafeSetSingleThreaded(this);
+	}
+
+	// column sets are shared with equal sets derived for other expressions
+	CColRefSetFactory *pcrsf = poctxt->Pcrsf();
+
 	// call output derivation function on the operator
-	m_pcrsOutput = popLogical->PcrsDeriveOutput(pmp, exprhdl);
+	m_pcrsOutput = pcrsf->PcrsIntern(popLogical->PcrsDeriveOutput(pmp, exprhdl));
 
 	// derive outer-references
-	m_pcrsOuter = popLogical->PcrsDeriveOuter(pmp, exprhdl);
+	m_pcrsOuter = pcrsf->PcrsIntern(popLogical->PcrsDeriveOuter(pmp, exprhdl));
 	
 	// derive not null columns
-	m_pcrsNotNull = popLogical->PcrsDeriveNotNull(pmp, exprhdl);
+	m_pcrsNotNull = pcrsf->PcrsIntern(popLogical->PcrsDeriveNotNull(pmp, exprhdl));
 
 	// derive correlated apply columns
-	m_pcrsCorrelatedApply = popLogical->PcrsDeriveCorrelatedApply(pmp, exprhdl);
+	m_pcrsCorrelatedApply = pcrsf->PcrsIntern(popLogical->PcrsDeriveCorrelatedApply(pmp, exprhdl));
 
 	// derive keys
 	m_pkc = popLogical->PkcDeriveKeys(pmp, exprhdl);
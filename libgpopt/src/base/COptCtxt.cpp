@@ -11,15 +11,22 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/sync/CAutoMutex.h"
 
 #include "naucrates/traceflags/traceflags.h"
 #include "gpopt/base/CColRefSet.h"
 #include "gpopt/base/CDefaultComparator.h"
 #include "gpopt/base/COptCtxt.h"
+#include "gpopt/base/CCostContext.h"
+#include "gpopt/base/COptimizationContext.h"
 #include "gpopt/cost/ICostModel.h"
 #include "gpopt/eval/IConstExprEvaluator.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/search/CGroupExpression.h"
+
+// number of memo objects per slab
+#define GPOPT_OPTCTXT_SLAB_BLOCKS 256
 
 using namespace gpopt;
 
@@ -45,7 +52,12 @@ COptCtxt::COptCtxt
 	:
 	CTaskLocalStorageObject(CTaskLocalStorage::EtlsidxOptCtxt),
 	m_pmp(pmp),
+	m_pmpArena(NULL),
+	m_pmpGroupExpressions(NULL),
+	m_pmpCostContexts(NULL),
+	m_pmpOptimizationContexts(NULL),
 	m_pcf(pcf),
+	m_pcrsf(NULL),
 	m_pmda(pmda),
 	m_pceeval(pceeval),
 	m_pcomp(GPOS_NEW(m_pmp) CDefaultComparator(pceeval)),
@@ -53,7 +65,8 @@ COptCtxt::COptCtxt
 	m_pcteinfo(NULL),
 	m_pdrgpcrSystemCols(NULL),
 	m_poconf(poconf),
-	m_fDMLQuery(false)
+	m_fDMLQuery(false),
+	m_fSingleThreaded(!GPOS_FTRACE(EopttraceParallel))
 {
 	GPOS_ASSERT(NULL != pmp);
 	GPOS_ASSERT(NULL != pcf);
@@ -63,8 +76,77 @@ COptCtxt::COptCtxt
 	GPOS_ASSERT(NULL != poconf);
 	GPOS_ASSERT(NULL != poconf->Pcm());
 	
+	m_pcrsf = GPOS_NEW(m_pmp) CColRefSetFactory(m_pmp, m_fSingleThreaded);
 	m_pcteinfo = GPOS_NEW(m_pmp) CCTEInfo(m_pmp);
 	m_pcm = poconf->Pcm();
+
+	if (GPOS_FTRACE(EopttraceArenaMemoryPools))
+	{
+		m_pmpArena = CMemoryPoolManager::Pmpm()->PmpCreate
+						(
+						CMemoryPoolManager::EatArena,
+						true /*fThreadSafe*/,
+						gpos::ullong_max,
+						GPOS_FTRACE(EopttraceHugePageMemoryPools)
+						);
+	}
+
+	m_pmpGroupExpressions = PmpSlabCreate(GPOS_SIZEOF(CGroupExpression));
+	m_pmpCostContexts = PmpSlabCreate(GPOS_SIZEOF(CCostContext));
+	m_pmpOptimizationContexts = PmpSlabCreate(GPOS_SIZEOF(COptimizationContext));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptCtxt::PmpSlabCreate
+//
+//	@doc:
+//		Create a slab pool for memo objects of the given size; memo objects
+//		are created and released by concurrent optimization jobs
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab *
+COptCtxt::PmpSlabCreate
+	(
+	ULONG ulObjectSize
+	)
+{
+	IMemoryPool *pmpSlabs = m_pmp;
+	if (NULL != m_pmpArena)
+	{
+		pmpSlabs = m_pmpArena;
+	}
+
+	return GPOS_NEW(m_pmp) CMemoryPoolSlab
+				(
+				pmpSlabs,
+				ulObjectSize,
+				GPOPT_OPTCTXT_SLAB_BLOCKS,
+				true /*fThreadSafe*/,
+				false /*fOwnsUnderlying*/
+				);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptCtxt::DestroySlab
+//
+//	@doc:
+//		Return slabs of a slab pool to the shared pool and delete it
+//
+//---------------------------------------------------------------------------
+void
+COptCtxt::DestroySlab
+	(
+	CMemoryPoolSlab *pmps
+	)
+{
+	GPOS_ASSERT(NULL != pmps);
+
+	pmps->TearDown();
+	GPOS_DELETE(pmps);
 }
 
 
@@ -79,12 +161,22 @@ COptCtxt::COptCtxt
 //---------------------------------------------------------------------------
 COptCtxt::~COptCtxt()
 {
+	GPOS_DELETE(m_pcrsf);
 	GPOS_DELETE(m_pcf);
 	GPOS_DELETE(m_pcomp);
 	m_pceeval->Release();
 	m_pcteinfo->Release();
 	m_poconf->Release();
 	CRefCount::SafeRelease(m_pdrgpcrSystemCols);
+
+	DestroySlab(m_pmpGroupExpressions);
+	DestroySlab(m_pmpCostContexts);
+	DestroySlab(m_pmpOptimizationContexts);
+
+	if (NULL != m_pmpArena)
+	{
+		CMemoryPoolManager::Pmpm()->Destroy(m_pmpArena);
+	}
 }
 
 
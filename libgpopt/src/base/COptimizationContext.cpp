@@ -33,6 +33,42 @@ const COptimizationContext COptimizationContext::m_ocInvalid;
 const OPTCTXT_PTR COptimizationContext::m_pocInvalid = NULL;
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationContext::COptimizationContext
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+COptimizationContext::COptimizationContext
+	(
+	IMemoryPool *pmp,
+	CGroup *pgroup,
+	CReqdPropPlan *prpp,
+	CReqdPropRelational *prprel,
+	DrgPstat *pdrgpstatCtxt,
+	ULONG ulSearchStageIndex
+	)
+	:
+	CRefCount(pgroup->FSingleThreaded()),
+	m_pmp(pmp),
+	m_ulId(GPOPT_INVALID_OPTCTXT_ID),
+	m_pgroup(pgroup),
+	m_prpp(prpp),
+	m_prprel(prprel),
+	m_pdrgpstatCtxt(pdrgpstatCtxt),
+	m_ulSearchStageIndex(ulSearchStageIndex),
+	m_pccBest(NULL),
+	m_estate(estUnoptimized),
+	m_fHasMultiStageAggPlan(false)
+{
+	GPOS_ASSERT(NULL != pgroup);
+	GPOS_ASSERT(NULL != prpp);
+	GPOS_ASSERT(NULL != prprel);
+	GPOS_ASSERT(NULL != pdrgpstatCtxt);
+}
+
 
 //---------------------------------------------------------------------------
 //	@function:
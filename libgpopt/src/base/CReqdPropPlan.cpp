@@ -178,7 +178,9 @@ CReqdPropPlan::ComputeReqdCTEs
 //		CReqdPropPlan::Compute
 //
 //	@doc:
-//		Compute required props
+//		Compute required props; properties computed for a group expression
+//		of a single-threaded memo are counted without atomic operations
+//		unless they are shared with other requests
 //
 //---------------------------------------------------------------------------
 void
@@ -264,6 +266,17 @@ CReqdPropPlan::Compute
 							CEnfdPartitionPropagation::EppmSatisfy,
 							ppfmDerived
 							);
+
+	CGroupExpression *pgexpr = exprhdl.Pgexpr();
+	if (NULL != pgexpr && pgexpr->FSingleThreaded())
+	{
+		SafeSetSingleThreaded(this);
+		SafeSetSingleThreaded(m_pcrs);
+		SafeSetSingleThreaded(m_peo);
+		SafeSetSingleThreaded(m_peo->PosRequired());
+		SafeSetSingleThreaded(m_ped);
+		SafeSetSingleThreaded(m_ped->PdsRequired());
+	}
 }
 
 //---------------------------------------------------------------------------
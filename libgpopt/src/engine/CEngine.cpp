@@ -9,12 +9,15 @@
 //		Implementation of optimization engine
 //---------------------------------------------------------------------------
 #include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/sync/atomic.h"
 #include "gpos/task/CAutoTaskProxy.h"
 #include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/memory/CAutoMemoryPoolRegion.h"
 
 #include "gpopt/exception.h"
 
@@ -44,6 +47,8 @@
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CJob.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobGroupExploration.h"
+#include "gpopt/search/CJobTrace.h"
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
@@ -55,11 +60,16 @@
 #define GPOPT_SAMPLING_MAX_ITERS 30
 #define GPOPT_JOBS_CAP 5000  // maximum number of initial optimization jobs
 #define GPOPT_JOBS_PER_GROUP 20 // estimated number of needed optimization jobs per memo group
+#define GPOPT_PARALLEL_EXPLORATION_MIN_GROUPS 32 // minimum number of memo groups to explore in parallel
+#define GPOPT_DEADLINE_EXPLORATION_PCT 50 // percentage of optimization deadline spent before exploration stops
 
 // memory consumption unit in bytes -- currently MB
 #define GPOPT_MEM_UNIT (1024 * 1024)
 #define GPOPT_MEM_UNIT_NAME "MB"
 
+// number of call sites printed in memory profile
+#define GPOPT_MEM_PROFILE_TOP_SITES 50
+
 using namespace gpopt;
 
 //---------------------------------------------------------------------------
@@ -80,12 +90,46 @@ CEngine::CEngine
 	m_pdrgpss(NULL),
 	m_ulCurrSearchStage(0),
 	m_pmemo(NULL),
+	m_fSingleThreaded(false),
 	m_pexprEnforcerPattern(NULL),
 	m_pxfs(NULL),
 	m_pdrgpulpXformCalls(NULL),
-	m_pdrgpulpXformTimes(NULL)
+	m_pdrgpulpXformTimes(NULL),
+	m_ullSearchMemoryBudget(gpos::ullong_max),
+	m_ulMemoryBudgetExceeded(0),
+	m_ulOptimizationDeadline(gpos::ulong_max),
+	m_ulExplorationStopped(0),
+	m_ulRootPlanFound(0),
+	m_ulParallelExplorations(0),
+	m_pjtrace(NULL),
+	m_pmprof(NULL),
+	m_pmpArena(NULL),
+	m_pmpGroupExpressions(NULL),
+	m_pmpCostContexts(NULL),
+	m_pmpOptimizationContexts(NULL)
 {
-	m_pmemo = GPOS_NEW(pmp) CMemo(pmp);
+	if (GPOS_FTRACE(EopttraceArenaMemoryPools))
+	{
+		// jobs, schedulers and memo index are released all at once
+		// when the engine is destroyed
+		m_pmpArena = CMemoryPoolManager::Pmpm()->PmpCreate
+						(
+						CMemoryPoolManager::EatArena,
+						true /*fThreadSafe*/,
+						gpos::ullong_max,
+						GPOS_FTRACE(EopttraceHugePageMemoryPools)
+						);
+	}
+
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	m_pmpGroupExpressions = poctxt->PmpGroupExpressions();
+	m_pmpCostContexts = poctxt->PmpCostContexts();
+	m_pmpOptimizationContexts = poctxt->PmpOptimizationContexts();
+
+	// no workers are spawned unless parallel optimization is enabled
+	m_fSingleThreaded = poctxt->FSingleThreaded();
+
+	m_pmemo = GPOS_NEW(pmp) CMemo(pmp, PmpScheduling(), m_fSingleThreaded);
 	m_pexprEnforcerPattern = GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CPatternLeaf(pmp));
 	m_pxfs = GPOS_NEW(pmp) CXformSet(pmp);
 	m_pdrgpulpXformCalls = GPOS_NEW(pmp) DrgPulp(pmp);
@@ -103,6 +147,9 @@ CEngine::CEngine
 //---------------------------------------------------------------------------
 CEngine::~CEngine()
 {
+	// stops profiling if optimization was aborted
+	GPOS_DELETE(m_pmprof);
+
 #ifdef GPOS_DEBUG
 	// in optimized build, we flush-down memory pools without leak checking,
 	// we can save time in optimized build by skipping all de-allocations here,
@@ -113,7 +160,14 @@ CEngine::~CEngine()
 	m_pdrgpulpXformTimes->Release();
 	m_pexprEnforcerPattern->Release();
 	CRefCount::SafeRelease(m_pdrgpss);
+	GPOS_DELETE(m_pjtrace);
 #endif // GPOS_DEBUG
+
+	// jobs and memo index are not used once the engine is destroyed
+	if (NULL != m_pmpArena)
+	{
+		CMemoryPoolManager::Pmpm()->Destroy(m_pmpArena);
+	}
 }
 
 
@@ -188,6 +242,18 @@ CEngine::Init
 		}
 	}
 
+	const ULONG ulSearchMemoryBudget = COptCtxt::PoctxtFromTLS()->Poconf()->Phint()->UlSearchMemoryBudget();
+	if (gpos::int_max != ulSearchMemoryBudget)
+	{
+		m_ullSearchMemoryBudget = (ULLONG) ulSearchMemoryBudget * GPOPT_MEM_UNIT;
+	}
+
+	const ULONG ulOptimizationDeadline = COptCtxt::PoctxtFromTLS()->Poconf()->Phint()->UlOptimizationDeadline();
+	if (gpos::int_max != ulOptimizationDeadline)
+	{
+		m_ulOptimizationDeadline = ulOptimizationDeadline;
+	}
+
 	m_pqc = pqc;
 	InitLogicalExpression(m_pqc->Pexpr());
 
@@ -196,6 +262,105 @@ CEngine::Init
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::CheckMemoryBudget
+//
+//	@doc:
+//		Check size of engine's memory pool against memory budget;
+//		once exceeded, the flag stays set for the rest of optimization;
+//		only the worker that sets the flag reports it
+//
+//---------------------------------------------------------------------------
+void
+CEngine::CheckMemoryBudget()
+{
+	if (0 != m_ulMemoryBudgetExceeded || gpos::ullong_max == m_ullSearchMemoryBudget)
+	{
+		return;
+	}
+
+	if (m_pmp->UllTotalAllocatedSize() > m_ullSearchMemoryBudget &&
+		FCompareSwap(&m_ulMemoryBudgetExceeded, 0 /*ulOld*/, 1 /*ulNew*/))
+	{
+		StopExploration();
+
+		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+		{
+			CAutoTrace at(m_pmp);
+			at.Os()
+				<< "[OPT]: Memory budget of " << m_ullSearchMemoryBudget / GPOPT_MEM_UNIT << " " << GPOPT_MEM_UNIT_NAME
+				<< " exceeded at stage " << m_ulCurrSearchStage << ", exploration stopped";
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::SetDeadline
+//
+//	@doc:
+//		Pass the remaining time until deadline to a scheduler; exploration
+//		stops once the given percentage of the deadline is spent
+//
+//---------------------------------------------------------------------------
+void
+CEngine::SetDeadline
+	(
+	CScheduler *psched
+	)
+	const
+{
+	GPOS_ASSERT(NULL != psched);
+
+	if (gpos::ulong_max == m_ulOptimizationDeadline)
+	{
+		return;
+	}
+
+	const ULONG ulElapsedMs = std::min(m_ulOptimizationDeadline, m_clockOptimization.UlElapsedMS());
+	const ULONG ulExplorationMs = (ULONG) ((ULLONG) m_ulOptimizationDeadline * GPOPT_DEADLINE_EXPLORATION_PCT / 100);
+
+	psched->SetDeadline
+			(
+			ulExplorationMs - std::min(ulExplorationMs, ulElapsedMs),
+			m_ulOptimizationDeadline - ulElapsedMs
+			);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FRootPlanFound
+//
+//	@doc:
+//		Does the root group have a plan for the required properties in
+//		any search stage; the memo is looked up until a plan is found
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FRootPlanFound()
+{
+	GPOS_ASSERT(NULL != PgroupRoot());
+
+	if (0 != m_ulRootPlanFound)
+	{
+		return true;
+	}
+
+	COptimizationContext *poc = PgroupRoot()->PocLookupBest(m_pmp, m_pdrgpss->UlLength(), m_pqc->Prpp());
+	if (NULL == poc || NULL == poc->PccBest())
+	{
+		return false;
+	}
+
+	(void) FCompareSwap(&m_ulRootPlanFound, 0 /*ulOld*/, 1 /*ulNew*/);
+
+	return true;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::AddEnforcers
@@ -321,14 +486,15 @@ CEngine::PgroupInsert
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
 	CGroupExpression *pgexpr =
-		GPOS_NEW(m_pmp) CGroupExpression
+		GPOS_NEW(m_pmpGroupExpressions) CGroupExpression
 					(
 					m_pmp,
 					pop,
 					pdrgpgroupChildren,
 					exfidOrigin,
 					pgexprOrigin,
-					fIntermediate
+					fIntermediate,
+					m_fSingleThreaded
 					);
 
 	// find the group that contains created group expression
@@ -695,7 +861,7 @@ CEngine::Pmemotmap()
 	if (NULL == m_pmemo->Pmemotmap())
 	{
 		m_pqc->Prpp()->AddRef();
-		COptimizationContext *poc = GPOS_NEW(m_pmp) COptimizationContext
+		COptimizationContext *poc = GPOS_NEW(m_pmpOptimizationContexts) COptimizationContext
 						(
 						m_pmp,
 						PgroupRoot(),
@@ -741,10 +907,12 @@ CEngine::ApplyTransformations
 		GPOS_CHECK_ABORT;
 		CXform *pxform = CXformFactory::Pxff()->Pxf(xsi.TBit());
 
-		// transform group expression, and insert results to memo
+		// transform group expression with scratch data in a region, and
+		// insert results to memo
+		CAutoMemoryPoolRegion amprScratch(pmpLocal);
 		CXformResult *pxfres = GPOS_NEW(m_pmp) CXformResult(m_pmp);
 		ULONG ulElapsedTime = 0;
-		pgexpr->Transform(m_pmp, pmpLocal, pxform, pxfres, &ulElapsedTime);
+		pgexpr->Transform(m_pmp, amprScratch.Pmp(), pxform, pxfres, &ulElapsedTime);
 		InsertXformResult(pgexpr->Pgroup(), pxfres, pxform->Exfid(), pgexpr, ulElapsedTime);
 		pxfres->Release();
 
@@ -966,7 +1134,7 @@ CEngine::PocChild
 	prprel->AddRef();
 
 	COptimizationContext *pocChild =
-			GPOS_NEW(m_pmp) COptimizationContext
+			GPOS_NEW(m_pmpOptimizationContexts) COptimizationContext
 				(
 				m_pmp,
 				pgroupChild,
@@ -1036,7 +1204,7 @@ CEngine::PccOptimizeChild
 		FSafeToPrune(pgexpr, pocOrigin->Prpp(), pccChildBest, ulChildIndex, &costLowerBound))
 	{
 		// failed to optimize child due to cost bounding
-		(void) pgexpr->PccComputeCost(m_pmp, pocOrigin, ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
+		(void) pgexpr->PccComputeCost(m_pmp, m_pmpCostContexts, pocOrigin, ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
 		return NULL;
 	}
 
@@ -1161,7 +1329,7 @@ CEngine::OptimizeGroupExpression
 		if (FSafeToPrune(pgexpr, poc->Prpp(), NULL /*pccChild*/,
 						 gpos::ulong_max /*ulChildIndex*/, &costLowerBound))
 		{
-			(void) pgexpr->PccComputeCost(m_pmp, poc, ul, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
+			(void) pgexpr->PccComputeCost(m_pmp, m_pmpCostContexts, poc, ul, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
 			continue;
 		}
 
@@ -1176,7 +1344,7 @@ CEngine::OptimizeGroupExpression
 			if (NULL != pdrgpoc && FCheckEnfdProps(m_pmp, pgexpr, poc, ul, pdrgpoc))
 			{
 				// compute group expression cost under the current optimization context
-				CCostContext *pccComputed = pgexpr->PccComputeCost(m_pmp, poc, ul, pdrgpoc, false /*fPruned*/, CCost(0.0));
+				CCostContext *pccComputed = pgexpr->PccComputeCost(m_pmp, m_pmpCostContexts, poc, ul, pdrgpoc, false /*fPruned*/, CCost(0.0));
 
 				if (NULL != pccComputed)
 				{
@@ -1350,7 +1518,7 @@ CEngine::RecursiveOptimize()
 		// optimize root group
 		m_pqc->Prpp()->AddRef();
 		COptimizationContext *poc =
-			GPOS_NEW(m_pmp) COptimizationContext
+			GPOS_NEW(m_pmpOptimizationContexts) COptimizationContext
 				(
 				m_pmp,
 				PgroupRoot(),
@@ -1472,7 +1640,8 @@ CEngine::FinalizeExploration()
 	if (!GPOS_FTRACE(EopttraceDonotDeriveStatsForAllGroups))
 	{
 		// derive stats for every group without stats
-		m_pmemo->DeriveStatsIfAbsent(m_pmp);
+		const ULONG ulWorkers = COptCtxt::PoctxtFromTLS()->Poconf()->Phint()->UlParallelWorkers();
+		m_pmemo->DeriveStatsIfAbsent(m_pmp, ulWorkers);
 	}
 
 	if (GPOS_FTRACE(EopttracePrintMemoAfterExploration))
@@ -1683,15 +1852,52 @@ CEngine::Optimize()
 
 	CAutoTimer at("\n[OPT]: Total Optimization Time", GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
-	if (GPOS_FTRACE(EopttraceParallel))
+	// deadline counts from here
+	m_clockOptimization.Restart();
+
+	if (GPOS_FTRACE(EopttracePrintMemoryProfile))
+	{
+		// profile is inherited by the workers of this optimization only
+		m_pmprof = GPOS_NEW(m_pmp) CMemoryProfile(m_pmp);
+		m_pmprof->Activate();
+	}
+
+	const ULONG ulWorkers = std::max((ULONG) 1, poconf->Phint()->UlParallelWorkers());
+	if (GPOS_FTRACE(EopttracePrintJobTimeline))
 	{
-		MultiThreadedOptimize(2 /*ulWorkers*/);
+		m_pjtrace = GPOS_NEW(m_pmp) CJobTrace(m_pmp, ulWorkers);
+	}
+
+	if (!m_fSingleThreaded)
+	{
+		MultiThreadedOptimize(ulWorkers);
 	}
 	else
 	{
 		MainThreadOptimize();
 	}
 
+	if (NULL != m_pjtrace)
+	{
+		CAutoTrace atTimeline(m_pmp);
+		(void) m_pjtrace->OsPrintChromeTrace(atTimeline.Os());
+
+		GPOS_DELETE(m_pjtrace);
+		m_pjtrace = NULL;
+	}
+
+	if (NULL != m_pmprof)
+	{
+		m_pmprof->Deactivate();
+
+		CAutoTrace atProfile(m_pmp);
+		atProfile.Os() << "[OPT]: ";
+		(void) m_pmprof->OsPrint(atProfile.Os(), GPOPT_MEM_PROFILE_TOP_SITES);
+
+		GPOS_DELETE(m_pmprof);
+		m_pmprof = NULL;
+	}
+
 	{
 		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 		{
@@ -1722,8 +1928,11 @@ CEngine::MainThreadOptimize()
 	GPOS_ASSERT(NULL != COptCtxt::PoctxtFromTLS());
 
 	const ULONG ulJobs = std::min((ULONG) GPOPT_JOBS_CAP, (ULONG) (m_pmemo->UlpGroups() * GPOPT_JOBS_PER_GROUP));
-	CJobFactory jf(m_pmp, ulJobs);
-	CScheduler sched(m_pmp, ulJobs, 1 /*ulWorkers*/);
+	CJobFactory jf(PmpScheduling(), ulJobs);
+	CScheduler sched(PmpScheduling(), ulJobs, 1 /*ulWorkers*/);
+
+	sched.SetJobTrace(m_pjtrace);
+	SetDeadline(&sched);
 
 	CSchedulerContext sc;
 	sc.Init(m_pmp, &jf, &sched, this);
@@ -1735,7 +1944,7 @@ CEngine::MainThreadOptimize()
 
 		// optimize root group
 		m_pqc->Prpp()->AddRef();
-		COptimizationContext *poc = GPOS_NEW(m_pmp) COptimizationContext
+		COptimizationContext *poc = GPOS_NEW(m_pmpOptimizationContexts) COptimizationContext
 							(
 							m_pmp,
 							PgroupRoot(),
@@ -1769,6 +1978,111 @@ CEngine::MainThreadOptimize()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::RunWorkers
+//
+//	@doc:
+//		Run the scheduled jobs on the given number of worker tasks;
+//		returns when all jobs are complete
+//
+//---------------------------------------------------------------------------
+void
+CEngine::RunWorkers
+	(
+	CJobFactory *pjf,
+	CScheduler *psched,
+	ULONG ulWorkers
+	)
+{
+	GPOS_ASSERT(0 < ulWorkers);
+
+	// create task array
+	CAutoRg<CTask*> a_rgptsk;
+	a_rgptsk = GPOS_NEW_ARRAY(PmpScheduling(), CTask*, ulWorkers);
+
+	// create scheduling contexts
+	CAutoRg<CSchedulerContext> a_rgsc;
+	a_rgsc = GPOS_NEW_ARRAY(PmpScheduling(), CSchedulerContext, ulWorkers);
+
+	// reuse threads and tasks of earlier optimizations if possible
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+	pwpm->Prewarm(ulWorkers);
+	CAutoTaskProxy atp(m_pmp, pwpm);
+
+	for (ULONG i = 0; i < ulWorkers; i++)
+	{
+		// initialize scheduling context
+		a_rgsc[i].Init(m_pmp, pjf, psched, this);
+
+		// create scheduling task
+		a_rgptsk[i] = atp.PtskCreate(CScheduler::Run, &a_rgsc[i]);
+
+		// store a pointer to optimizer's context in current task local storage
+		a_rgptsk[i]->Tls().Reset(m_pmp);
+		a_rgptsk[i]->Tls().Store(COptCtxt::PoctxtFromTLS());
+	}
+
+	// start tasks
+	for (ULONG i = 0; i < ulWorkers; i++)
+	{
+		atp.Schedule(a_rgptsk[i]);
+	}
+
+	// wait for tasks to complete
+	for (ULONG i = 0; i < ulWorkers; i++)
+	{
+		CTask *ptsk;
+		atp.WaitAny(&ptsk);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::ExploreParallel
+//
+//	@doc:
+//		Explore the memo on multiple workers; child groups of a group
+//		expression are independent, so their exploration jobs are picked
+//		up by idle workers; completing the root exploration job finalizes
+//		exploration of the current stage
+//
+//---------------------------------------------------------------------------
+void
+CEngine::ExploreParallel
+	(
+	ULONG ulWorkers
+	)
+{
+	GPOS_ASSERT(NULL != PgroupRoot());
+	GPOS_ASSERT(1 < ulWorkers);
+
+	if (PgroupRoot()->FExplored())
+	{
+		return;
+	}
+
+	const ULONG ulJobs = std::min((ULONG) GPOPT_JOBS_CAP, (ULONG) (m_pmemo->UlpGroups() * GPOPT_JOBS_PER_GROUP));
+	CJobFactory jf(PmpScheduling(), ulJobs);
+	CScheduler sched(PmpScheduling(), ulJobs, ulWorkers);
+
+	sched.SetJobTrace(m_pjtrace);
+	SetDeadline(&sched);
+
+	CSchedulerContext sc;
+	sc.Init(m_pmp, &jf, &sched, this);
+
+	CJobGroupExploration::ScheduleJob(&sc, PgroupRoot(), NULL /*pjParent*/);
+
+	RunWorkers(&jf, &sched, ulWorkers);
+	m_ulParallelExplorations++;
+
+	// exploration jobs are abandoned if the deadline passed
+	GPOS_ASSERT(PgroupRoot()->FExplored() || sched.FDeadlineExpired());
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::MultiThreadedOptimize
@@ -1787,8 +2101,11 @@ CEngine::MultiThreadedOptimize
 	GPOS_ASSERT(NULL != COptCtxt::PoctxtFromTLS());
 
 	const ULONG ulJobs = std::min((ULONG) GPOPT_JOBS_CAP, (ULONG) (m_pmemo->UlpGroups() * GPOPT_JOBS_PER_GROUP));
-	CJobFactory jf(m_pmp, ulJobs);
-	CScheduler sched(m_pmp, ulJobs, ulWorkers);
+	CJobFactory jf(PmpScheduling(), ulJobs);
+	CScheduler sched(PmpScheduling(), ulJobs, ulWorkers);
+
+	sched.SetJobTrace(m_pjtrace);
+	SetDeadline(&sched);
 
 	CSchedulerContext sc;
 	sc.Init(m_pmp, &jf, &sched, this);
@@ -1800,7 +2117,7 @@ CEngine::MultiThreadedOptimize
 
 		// optimize root group
 		m_pqc->Prpp()->AddRef();
-		COptimizationContext *poc = GPOS_NEW(m_pmp) COptimizationContext
+		COptimizationContext *poc = GPOS_NEW(m_pmpOptimizationContexts) COptimizationContext
 								(
 								m_pmp,
 								PgroupRoot(),
@@ -1810,48 +2127,18 @@ CEngine::MultiThreadedOptimize
 								m_ulCurrSearchStage
 								);
 
-		// schedule main optimization job
-		ScheduleMainJob(&sc, poc);
-
-		// create task array
-		CAutoRg<CTask*> a_rgptsk;
-		a_rgptsk = GPOS_NEW_ARRAY(m_pmp, CTask*, ulWorkers);
-
-		// create scheduling contexts
-		CAutoRg<CSchedulerContext> a_rgsc;
-		a_rgsc = GPOS_NEW_ARRAY(m_pmp, CSchedulerContext, ulWorkers);
-
-		// scope for ATP
+		// explore large memos before implementing any of their groups;
+		// the main job then finds the root group explored
+		if (1 < ulWorkers && GPOPT_PARALLEL_EXPLORATION_MIN_GROUPS <= m_pmemo->UlpGroups())
 		{
-			CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
-			CAutoTaskProxy atp(m_pmp, pwpm);
-
-			for (ULONG i = 0; i < ulWorkers; i++)
-			{
-				// initialize scheduling context
-				a_rgsc[i].Init(m_pmp, &jf, &sched, this);
-
-				// create scheduling task
-				a_rgptsk[i] = atp.PtskCreate(CScheduler::Run, &a_rgsc[i]);
-
-				// store a pointer to optimizer's context in current task local storage
-				a_rgptsk[i]->Tls().Reset(m_pmp);
-				a_rgptsk[i]->Tls().Store(COptCtxt::PoctxtFromTLS());
-			}
+			ExploreParallel(ulWorkers);
+		}
 
-			// start tasks
-			for (ULONG i = 0; i < ulWorkers; i++)
-			{
-				atp.Schedule(a_rgptsk[i]);
-			}
+		// schedule main optimization job
+		ScheduleMainJob(&sc, poc);
 
-			// wait for tasks to complete
-			for (ULONG i = 0; i < ulWorkers; i++)
-			{
-				CTask *ptsk;
-				atp.WaitAny(&ptsk);
-			}
-		}
+		// run optimization job on worker tasks
+		RunWorkers(&jf, &sched, ulWorkers);
 
 		poc->Release();
 
@@ -2212,7 +2499,7 @@ CEngine::FCheckEnfdProps
 	poc->AddRef();
 	pgexpr->AddRef();
 	pdrgpoc->AddRef();
-	CCostContext *pcc= GPOS_NEW(pmp) CCostContext(pmp, poc, ulOptReq, pgexpr);
+	CCostContext *pcc= GPOS_NEW(m_pmpCostContexts) CCostContext(pmp, poc, ulOptReq, pgexpr);
 	pcc->SetChildContexts(pdrgpoc);
 	CExpressionHandle exprhdl(pmp);
 	exprhdl.Attach(pcc);
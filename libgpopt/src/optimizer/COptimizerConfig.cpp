@@ -172,6 +172,9 @@ COptimizerConfig::Serialize(IMemoryPool *pmp, CXMLSerializer *pxmlser, CBitSet *
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenJoinOrderDPThreshold), m_phint->UlJoinOrderDPLimit());
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenBroadcastThreshold), m_phint->UlBroadcastThreshold());
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenEnforceConstraintsOnDML), m_phint->FEnforceConstraintsOnDML());
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenSearchMemoryBudget), m_phint->UlSearchMemoryBudget());
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenParallelWorkers), m_phint->UlParallelWorkers());
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenOptimizationDeadline), m_phint->UlOptimizationDeadline());
 	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenHint));
 
 	// Serialize traceflags represented in bitset into stream
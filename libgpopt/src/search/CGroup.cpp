@@ -162,14 +162,17 @@ CGroup::SContextLink::FEqual
 CGroup::CGroup
 	(
 	IMemoryPool *pmp,
-	BOOL fScalar
+	BOOL fScalar,
+	BOOL fSingleThreaded
 	)
 	:
+	CRefCount(fSingleThreaded),
 	m_pmp(pmp),
 	m_ulId(GPOPT_INVALID_GROUP_ID),
 	m_fScalar(fScalar),
 	m_pdrgpexprHashJoinKeysOuter(NULL),
 	m_pdrgpexprHashJoinKeysInner(NULL),
+	m_sarGExprs(pmp),
 	m_pdp(NULL),
 	m_pstats(NULL),
 	m_pexprScalar(NULL),
@@ -177,6 +180,7 @@ CGroup::CGroup
 	m_pgroupDuplicate(NULL),
 	m_plinkmap(NULL),
 	m_pstatsmap(NULL),
+	m_pdrgpstatRetired(NULL),
 	m_ulGExprs(0),
 	m_pcostmap(NULL),
 	m_ulpOptCtxts(0),
@@ -188,8 +192,8 @@ CGroup::CGroup
 {
 	GPOS_ASSERT(NULL != pmp);
 
-	m_listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
 	m_listDupGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
+	m_eventScalar.Init(&m_mutexScalar);
 
 	m_sht.Init
 			(
@@ -203,6 +207,7 @@ CGroup::CGroup
 			);
 	m_plinkmap = GPOS_NEW(pmp) LinkMap(pmp);
 	m_pstatsmap = GPOS_NEW(pmp) StatsMap(pmp);
+	m_pdrgpstatRetired = GPOS_NEW(pmp) DrgPstat(pmp);
 	m_pcostmap = GPOS_NEW(pmp) CostMap(pmp);
 }
 
@@ -225,13 +230,14 @@ CGroup::~CGroup()
 	CRefCount::SafeRelease(m_pstats);
 	m_plinkmap->Release();
 	m_pstatsmap->Release();
+	m_pdrgpstatRetired->Release();
 	m_pcostmap->Release();
 	
 	// cleaning-up group expressions
-	CGroupExpression *pgexpr = m_listGExprs.PtFirst();
+	CGroupExpression *pgexpr = PgexprFrom(0);
 	while (NULL != pgexpr)
 	{
-		CGroupExpression *pgexprNext = m_listGExprs.PtNext(pgexpr);
+		CGroupExpression *pgexprNext = PgexprFrom(pgexpr->UlpGroupPos() + 1);
 		pgexpr->CleanupContexts();
 		pgexpr->Release();
 		
@@ -620,7 +626,7 @@ CGroup::UlHash() const
 //		CGroup::Insert
 //
 //	@doc:
-//		Insert group expression
+//		Insert group expression; the slot for it is installed by the caller
 //
 //---------------------------------------------------------------------------
 void
@@ -630,8 +636,9 @@ CGroup::Insert
 	)
 {
 	GPOS_ASSERT(m_slock.FOwned());
+	GPOS_ASSERT(FGExprSlotInstalled());
 
-	m_listGExprs.Append(pgexpr);
+	pgexpr->SetGroupPos(m_sarGExprs.UlpAppend(pgexpr));
 	COperator *pop = pgexpr->Pop();
 	if (pop->FLogical())
 	{
@@ -660,7 +667,8 @@ CGroup::Insert
 //		CGroup::MoveDuplicateGExpr
 //
 //	@doc:
-//		Move duplicate group expression to duplicates list
+//		Move duplicate group expression to duplicates list; its slot is
+//		cleared, iterating past it continues with the next group expression
 //
 //---------------------------------------------------------------------------
 void
@@ -670,8 +678,9 @@ CGroup::MoveDuplicateGExpr
 	)
 {
 	GPOS_ASSERT(m_slock.FOwned());
+	GPOS_ASSERT(pgexpr == m_sarGExprs[pgexpr->UlpGroupPos()]);
 
-	m_listGExprs.Remove(pgexpr);
+	m_sarGExprs.Remove(pgexpr->UlpGroupPos());
 	m_ulGExprs--;
 
 	m_listDupGExprs.Append(pgexpr);
@@ -735,7 +744,7 @@ CGroup::PgexprFirst()
 {
 	GPOS_ASSERT(m_slock.FOwned());
 
-	return m_listGExprs.PtFirst();
+	return PgexprFrom(0);
 }
 
 
@@ -744,7 +753,8 @@ CGroup::PgexprFirst()
 //		CGroup::PgexprNext
 //
 //	@doc:
-//		Retrieve next expression in group
+//		Retrieve next expression in group; the given expression may have
+//		been moved to the duplicates list meanwhile
 //
 //---------------------------------------------------------------------------
 CGroupExpression *
@@ -755,7 +765,37 @@ CGroup::PgexprNext
 {
 	GPOS_ASSERT(m_slock.FOwned());
 
-	return m_listGExprs.PtNext(pgexpr);
+	return PgexprFrom(pgexpr->UlpGroupPos() + 1);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::PgexprFrom
+//
+//	@doc:
+//		Retrieve first expression in group at or after given position,
+//		skipping cleared slots
+//
+//---------------------------------------------------------------------------
+CGroupExpression *
+CGroup::PgexprFrom
+	(
+	ULONG_PTR ulpPos
+	)
+	const
+{
+	const ULONG_PTR ulpSize = m_sarGExprs.UlpSize();
+	for (ULONG_PTR ulp = ulpPos; ulp < ulpSize; ulp++)
+	{
+		CGroupExpression *pgexpr = m_sarGExprs[ulp];
+		if (NULL != pgexpr)
+		{
+			return pgexpr;
+		}
+	}
+
+	return NULL;
 }
 
 
@@ -924,8 +964,9 @@ CGroup::AppendStats
 		gp.InitStats(pstatsCopy);
 	}
 
-	pstatsCurrent->Release();
-	pstatsCurrent = NULL;
+	// derivations of parent groups on other workers may still use
+	// the replaced stats
+	m_pdrgpstatRetired->Append(pstatsCurrent);
 }
 
 
@@ -957,7 +998,7 @@ CGroup::AddDuplicateGrp
 	while (pgroupSrc->m_pgroupDuplicate != pgroupDest &&
 	       !FCompareSwap<CGroup>
 				(
-				(volatile CGroup**)&pgroupSrc->m_pgroupDuplicate,
+				(volatile CGroup **) &pgroupSrc->m_pgroupDuplicate,
 				NULL,
 				pgroupDest
 				))
@@ -1021,13 +1062,16 @@ CGroup::MergeGroup()
 	CGroup *pgroupTarget = m_pgroupDuplicate;
 
 	// move group expressions from this group to target
-	while (!m_listGExprs.FEmpty())
+	CGroupExpression *pgexpr = PgexprFrom(0);
+	while (NULL != pgexpr)
 	{
-		CGroupExpression *pgexpr = m_listGExprs.RemoveHead();
+		CGroupExpression *pgexprNext = PgexprFrom(pgexpr->UlpGroupPos() + 1);
+		m_sarGExprs.Remove(pgexpr->UlpGroupPos());
 		m_ulGExprs--;
 
 		pgexpr->Reset(pgroupTarget, pgroupTarget->m_ulGExprs++);
-		pgroupTarget->m_listGExprs.Append(pgexpr);
+		pgexpr->SetGroupPos(pgroupTarget->m_sarGExprs.UlpAppend(pgexpr));
+		pgexpr = pgexprNext;
 
 		GPOS_CHECK_ABORT;
 	}
@@ -1064,7 +1108,7 @@ CGroup::CreateScalarExpression()
 	{
 		COperator *pop = pgexprFirst->Pop();
 		pop->AddRef();
-		m_pexprScalar = GPOS_NEW(m_pmp) CExpression (m_pmp, pop);
+		PublishScalarExpression(GPOS_NEW(m_pmp) CExpression (m_pmp, pop));
 
 		return;
 	}
@@ -1083,7 +1127,63 @@ CGroup::CreateScalarExpression()
 
 	COperator *pop = pgexprFirst->Pop();
 	pop->AddRef();
-	m_pexprScalar = GPOS_NEW(m_pmp) CExpression(m_pmp, pop, pdrgpexpr);
+	PublishScalarExpression(GPOS_NEW(m_pmp) CExpression(m_pmp, pop, pdrgpexpr));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::PublishScalarExpression
+//
+//	@doc:
+//		Make a complete scalar expression visible to other workers and
+//		wake up workers waiting for it
+//
+//---------------------------------------------------------------------------
+void
+CGroup::PublishScalarExpression
+	(
+	CExpression *pexpr
+	)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	CAutoMutex am(m_mutexScalar);
+	am.Lock();
+
+#ifdef GPOS_DEBUG
+	BOOL fPublished =
+#endif // GPOS_DEBUG
+		FCompareSwap<CExpression>((volatile CExpression **) &m_pexprScalar, NULL, pexpr);
+
+	GPOS_ASSERT(fPublished && "Scalar expression materialized twice");
+
+	m_eventScalar.Broadcast();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::WaitScalarExpression
+//
+//	@doc:
+//		Wait for the scalar expression of a group that was added to the memo
+//		by another worker; the expression is materialized right after the
+//		group is added
+//
+//---------------------------------------------------------------------------
+void
+CGroup::WaitScalarExpression()
+{
+	GPOS_ASSERT(FScalar());
+
+	CAutoMutex am(m_mutexScalar);
+	am.Lock();
+
+	while (NULL == m_pexprScalar)
+	{
+		m_eventScalar.Wait();
+	}
 }
 
 
@@ -1559,11 +1659,18 @@ CGroup::PstatsRecursiveDerive
 
 	// derive stats on group expression and copy them to group
 	pstats = pgexprBest->PstatsRecursiveDerive(pmpLocal, pmpGlobal, prprelInput, pdrgpstatCtxt);
-	if (!FInitStats(pstats))
 	{
-		// a group stat object already exists, we append derived stats to that object
-		AppendStats(pmpGlobal, pstats);
-		pstats->Release();
+		// derivation runs unlocked; concurrent derivations of the group
+		// publish their stats one at a time
+		CAutoMutex am(m_mutexStats);
+		am.Lock();
+
+		if (!FInitStats(pstats))
+		{
+			// a group stat object already exists, we append derived stats to that object
+			AppendStats(pmpGlobal, pstats);
+			pstats->Release();
+		}
 	}
 	GPOS_ASSERT(NULL != Pstats());
 
@@ -1848,11 +1955,11 @@ void
 CGroup::ResetGroupState()
 {
 	// reset group expression states
-	CGroupExpression *pgexpr = m_listGExprs.PtFirst();
+	CGroupExpression *pgexpr = PgexprFrom(0);
 	while (NULL != pgexpr)
 	{
 		pgexpr->ResetState();
-		pgexpr = m_listGExprs.PtNext(pgexpr);
+		pgexpr = PgexprFrom(pgexpr->UlpGroupPos() + 1);
 
 		GPOS_CHECK_ABORT;
 	}
@@ -1912,6 +2019,8 @@ CGroup::ResetStats()
 	}
  	CRefCount::SafeRelease(pstats);
  	pstats = NULL;
+
+	m_pdrgpstatRetired->Clear();
 }
 
 
@@ -2091,7 +2200,7 @@ CGroup::OsPrint
 	os << std::endl << "Group " << m_ulId << " (";
 	if (!FScalar())
 	{
-		os << "#GExprs: " << m_listGExprs.UlSize();
+		os << "#GExprs: " << m_ulGExprs;
 
 		if (0 < m_listDupGExprs.UlSize())
 		{
@@ -2104,11 +2213,11 @@ CGroup::OsPrint
 	}
 	os << "):" << std::endl;
 
-	CGroupExpression *pgexpr = m_listGExprs.PtFirst();
+	CGroupExpression *pgexpr = PgexprFrom(0);
 	while (NULL != pgexpr)
 	{
 		(void) pgexpr->OsPrint(os, szPrefix);
-		pgexpr = m_listGExprs.PtNext(pgexpr);
+		pgexpr = PgexprFrom(pgexpr->UlpGroupPos() + 1);
 
 		GPOS_CHECK_ABORT;
 	}
@@ -51,9 +51,11 @@ CGroupExpression::CGroupExpression
 	DrgPgroup *pdrgpgroup,
 	CXform::EXformId exfid,
 	CGroupExpression *pgexprOrigin,
-	BOOL fIntermediate
+	BOOL fIntermediate,
+	BOOL fSingleThreaded
 	)
 	:
+	CRefCount(fSingleThreaded),
 	m_pmp(pmp),
 	m_ulId(GPOPT_INVALID_GEXPR_ID),
 	m_pgexprDuplicate(NULL),
@@ -61,6 +63,7 @@ CGroupExpression::CGroupExpression
 	m_pdrgpgroup(pdrgpgroup),
 	m_pdrgpgroupSorted(NULL),
 	m_pgroup(NULL),
+	m_ulpGroupPos(ULONG_PTR_MAX),
 	m_exfidOrigin(exfid),
 	m_pgexprOrigin(pgexprOrigin),
 	m_fIntermediate(fIntermediate),
@@ -455,6 +458,7 @@ CCostContext *
 CGroupExpression::PccComputeCost
 	(
 	IMemoryPool *pmp,
+	IMemoryPool *pmpCostContexts,
 	COptimizationContext *poc,
 	ULONG ulOptReq,
 	DrgPoc *pdrgpoc, // array of child contexts
@@ -478,7 +482,7 @@ CGroupExpression::PccComputeCost
 
 	poc->AddRef();
 	this->AddRef();
-	CCostContext *pcc = GPOS_NEW(pmp) CCostContext(pmp, poc, ulOptReq, this);
+	CCostContext *pcc = GPOS_NEW(pmpCostContexts) CCostContext(pmp, poc, ulOptReq, this);
 	BOOL fValid = true;
 
 	// computing cost
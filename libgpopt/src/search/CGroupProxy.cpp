@@ -58,23 +58,32 @@ CGroupProxy::~CGroupProxy()
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CGroupProxy::Insert
+//		CGroupProxy::FInsert
 //
 //	@doc:
-//		Insert group expression into group
+//		Insert group expression into group; fails without allocating if
+//		concurrent insertions used up the slot installed for it, since the
+//		group's lock is held
 //
 //---------------------------------------------------------------------------
-void 
-CGroupProxy::Insert
+BOOL
+CGroupProxy::FInsert
 	(
 	CGroupExpression *pgexpr
 	)
 {
+	if (!m_pgroup->FGExprSlotInstalled())
+	{
+		return false;
+	}
+
 	pgexpr->Init(m_pgroup, m_pgroup->m_ulGExprs++);
 
 	GPOS_ASSERT(pgexpr->Pgroup() == m_pgroup);
 
 	m_pgroup->Insert(pgexpr);
+
+	return true;
 }
 
 
@@ -95,13 +104,13 @@ CGroupProxy::MoveDuplicateGExpr
 	GPOS_ASSERT(pgexpr->Pgroup() == m_pgroup);
 
 #ifdef GPOS_DEBUG
-	ULONG ulGExprsOld = m_pgroup->m_listGExprs.UlSize() + m_pgroup->m_listDupGExprs.UlSize();
+	ULONG ulGExprsOld = m_pgroup->m_ulGExprs + m_pgroup->m_listDupGExprs.UlSize();
 #endif	// GPOS_DEBUG
 
 	m_pgroup->MoveDuplicateGExpr(pgexpr);
 	GPOS_ASSERT
 		(
-		ulGExprsOld == (m_pgroup->m_listGExprs.UlSize() + m_pgroup->m_listDupGExprs.UlSize())
+		ulGExprsOld == (m_pgroup->m_ulGExprs + m_pgroup->m_listDupGExprs.UlSize())
 		);
 }
 
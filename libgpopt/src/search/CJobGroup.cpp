@@ -40,6 +40,21 @@ CJobGroup::Init
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobGroup::UlGroupId
+//
+//	@doc:
+//		Id of target group
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobGroup::UlGroupId() const
+{
+	return m_pgroup->UlId();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobGroup::PgexprFirstUnschedNonLogical
@@ -47,6 +47,21 @@ CJobGroupExpression::Init
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobGroupExpression::UlGroupId
+//
+//	@doc:
+//		Id of the group of target group expression
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobGroupExpression::UlGroupId() const
+{
+	return m_pgexpr->Pgroup()->UlId();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobGroupExpression::ScheduleTransformations
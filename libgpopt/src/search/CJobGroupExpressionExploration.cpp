@@ -182,6 +182,13 @@ CJobGroupExpressionExploration::ScheduleApplicableTransformations
 {
 	GPOS_ASSERT(!FXformsScheduled());
 
+	if (psc->Peng()->FExplorationStopped())
+	{
+		// memory budget is exhausted or deadline is near, do not grow the memo any further
+		SetXformsScheduled();
+		return;
+	}
+
 	// get all applicable xforms
 	COperator *pop = m_pgexpr->Pop();
 	CXformSet *pxfs = CLogical::PopConvert(pop)->PxfsCandidates(psc->PmpGlobal());
@@ -347,7 +354,7 @@ CJobGroupExpressionExploration::ScheduleJob
 	// initialize job
 	CJobGroupExpressionExploration *pjege = PjConvert(pj);
 	pjege->Init(pgexpr);
-	psc->Psched()->Add(pjege, pjParent);
+	psc->Psched()->Add(pjege, pjParent, psc);
 }
 
 #ifdef GPOS_DEBUG
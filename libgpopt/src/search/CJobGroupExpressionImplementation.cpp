@@ -348,7 +348,7 @@ CJobGroupExpressionImplementation::ScheduleJob
 	// initialize job
 	CJobGroupExpressionImplementation *pjige = PjConvert(pj);
 	pjige->Init(pgexpr);
-	psc->Psched()->Add(pjige, pjParent);
+	psc->Psched()->Add(pjige, pjParent, psc);
 }
 
 #ifdef GPOS_DEBUG
@@ -345,7 +345,7 @@ CJobGroupExpressionOptimization::EevtInitialize
 			pjgeo->m_pgexpr, pjgeo->m_poc->Prpp(), NULL /*pccChild*/,
 			gpos::ulong_max /*ulChildIndex*/, &costLowerBound))
 	{
-		(void) pjgeo->m_pgexpr->PccComputeCost(psc->PmpGlobal(), pjgeo->m_poc, pjgeo->m_ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
+		(void) pjgeo->m_pgexpr->PccComputeCost(psc->PmpGlobal(), psc->Peng()->PmpCostContexts(), pjgeo->m_poc, pjgeo->m_ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
 		return eevFinalized;
 	}
 
@@ -397,7 +397,7 @@ CJobGroupExpressionOptimization::DerivePrevChildProps
 	if (psc->Peng()->FSafeToPrune(m_pgexpr, m_poc->Prpp(), pccChildBest, ulPrevChildIndex, &costLowerBound))
 	{
 		// failed to optimize child due to cost bounding
-		(void) m_pgexpr->PccComputeCost(psc->PmpGlobal(), m_poc, m_ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
+		(void) m_pgexpr->PccComputeCost(psc->PmpGlobal(), psc->Peng()->PmpCostContexts(), m_poc, m_ulOptReq, NULL /*pdrgpoc*/, true /*fPruned*/, costLowerBound);
 		m_fChildOptimizationFailed = true;
 		return;
 	}
@@ -511,7 +511,7 @@ CJobGroupExpressionOptimization::ScheduleChildGroupsJobs
 	prprel->AddRef();
 
 	// schedule optimization job for current child group
-	COptimizationContext *pocChild = GPOS_NEW(psc->PmpGlobal()) COptimizationContext
+	COptimizationContext *pocChild = GPOS_NEW(psc->Peng()->PmpOptimizationContexts()) COptimizationContext
 									(
 									psc->PmpGlobal(),
 									pgroupChild,
@@ -651,7 +651,7 @@ CJobGroupExpressionOptimization::EevtOptimizeSelf
 	DrgPoc *pdrgpoc = pjgeo->m_pdrgpoc;
 	ULONG ulOptReq = pjgeo->m_ulOptReq;
 
-	CCostContext *pcc = pgexpr->PccComputeCost(psc->PmpGlobal(), poc, ulOptReq, pdrgpoc, false /*fPruned*/, CCost(0.0));
+	CCostContext *pcc = pgexpr->PccComputeCost(psc->PmpGlobal(), psc->Peng()->PmpCostContexts(), poc, ulOptReq, pdrgpoc, false /*fPruned*/, CCost(0.0));
 	
 	if (NULL == pcc)
 	{
@@ -751,7 +751,7 @@ CJobGroupExpressionOptimization::ScheduleJob
 	// initialize job
 	CJobGroupExpressionOptimization *pjgeo = PjConvert(pj);
 	pjgeo->Init(pgexpr, poc, ulOptReq);
-	psc->Psched()->Add(pjgeo, pjParent);
+	psc->Psched()->Add(pjgeo, pjParent, psc);
 }
 
 
@@ -810,7 +810,7 @@ CJobGroupExpressionOptimization::FScheduleCTEOptimization
 
 	// initialize job
 	pjgeo->Init(pgexpr, poc, ulOptReq, prppCTEProducer);
-	psc->Psched()->Add(pjgeo, pjParent);
+	psc->Psched()->Add(pjgeo, pjParent, psc);
 	prppCTEProducer->Release();
 
 	return true;
@@ -17,8 +17,6 @@
 //
 //---------------------------------------------------------------------------
 
-#include "gpos/sync/CAutoSpinlock.h"
-
 #include "gpopt/search/CJobFactory.h"
 #include "gpopt/search/CJobQueue.h"
 #include "gpopt/search/CScheduler.h"
@@ -44,48 +42,41 @@ CJobQueue::EjqrAdd
 {
 	GPOS_ASSERT(NULL != pj);
 
-	EJobQueueResult ejer = EjqrCompleted;
+	// take reference before job becomes visible to NotifyCompleted
+	pj->IncRefs();
 
-	// check if job has completed before getting the lock
-	if (!m_fCompleted)
+	while (true)
 	{
-		CAutoSpinlock as(m_slock);
-		as.Lock();
+		ULONG_PTR ulpHead = m_ulpQueued;
+
+		// check if job has completed
+		if (GPOPT_JOBQUEUE_COMPLETED == ulpHead)
+		{
+			(void) pj->UlpDecrRefs();
+			return EjqrCompleted;
+		}
 
 		// check if this is the main job
 		if (pj == m_pj)
 		{
-			GPOS_ASSERT(!m_fCompleted);
-			ejer = EjqrMain;
-			pj->IncRefs();
+			return EjqrMain;
 		}
-		else
+
+		pj->m_linkQueue.m_pvNext = reinterpret_cast<void*>(ulpHead);
+		if (FCompareSwap(&m_ulpQueued, ulpHead, reinterpret_cast<ULONG_PTR>(pj)))
 		{
-			// check if job is completed
-			if (!m_fCompleted)
+			// first caller becomes the owner
+			if (0 == ulpHead)
 			{
-				m_listjQueued.Append(pj);
-				BOOL fOwner = (pj == m_listjQueued.PtFirst());
-
-				// first caller becomes the owner
-				if (fOwner)
-				{
-					GPOS_ASSERT(NULL == m_pj);
-
-					m_pj = pj;
-					ejer = EjqrMain;
-				}
-				else
-				{
-					ejer = EjqrQueued;
-				}
-
-				pj->IncRefs();
+				GPOS_ASSERT(NULL == m_pj);
+
+				m_pj = pj;
+				return EjqrMain;
 			}
+
+			return EjqrQueued;
 		}
 	}
-
-	return ejer;
 }
 
 
@@ -103,29 +94,35 @@ CJobQueue::NotifyCompleted
 	CSchedulerContext *psc
 	)
 {
-	// scope for auto spinlock
+	// detach waiting jobs and mark queue as completed
+	ULONG_PTR ulpHead = 0;
+	do
 	{
-		CAutoSpinlock as(m_slock);
-		as.Lock();
-
-		GPOS_ASSERT(!m_fCompleted);
-		m_fCompleted = true;
+		ulpHead = m_ulpQueued;
+		GPOS_ASSERT(GPOPT_JOBQUEUE_COMPLETED != ulpHead);
 	}
+	while (!FCompareSwap(&m_ulpQueued, ulpHead, GPOPT_JOBQUEUE_COMPLETED));
+
+	CJob *pj = reinterpret_cast<CJob*>(ulpHead);
+	GPOS_ASSERT(NULL != pj);
 
-	GPOS_ASSERT(!m_listjQueued.FEmpty());
-	while (!m_listjQueued.FEmpty())
+	while (NULL != pj)
 	{
-		CJob *pj = m_listjQueued.RemoveHead();
+		// job may be recycled once released
+		CJob *pjNext = static_cast<CJob*>(pj->m_linkQueue.m_pvNext);
+		pj->m_linkQueue.m_pvNext = NULL;
 
 		// check if job execution has completed
 		if (1 == pj->UlpDecrRefs())
 		{
 			// update job as completed
-			psc->Psched()->CompleteQueued(pj);
+			psc->Psched()->CompleteQueued(pj, psc);
 
 			// recycle job
 			psc->Pjf()->Release(pj);
 		}
+
+		pj = pjNext;
 	}
 }
 
@@ -147,11 +144,16 @@ CJobQueue::OsPrintQueuedJobs
 {
 	os << "Job queue: " << std::endl;
 
-	CJob *pj = m_listjQueued.PtFirst();
+	CJob *pj = NULL;
+	if (!FCompleted())
+	{
+		pj = reinterpret_cast<CJob*>(m_ulpQueued);
+	}
+
 	while (NULL != pj)
 	{
 		pj->OsPrint(os);
-		pj = m_listjQueued.PtNext(pj);
+		pj = static_cast<CJob*>(pj->m_linkQueue.m_pvNext);
 	}
 
 	return os;
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CJobTrace.cpp
+//
+//	@doc:
+//		Implementation of per-worker recording of optimization job events
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/atomic.h"
+
+#include "gpopt/search/CJobTrace.h"
+#include "gpopt/xforms/CXformFactory.h"
+
+using namespace gpopt;
+
+// names of job types
+static const CHAR *rgszJobType[] =
+{
+	"Test",
+	"GroupOptimization",
+	"GroupImplementation",
+	"GroupExploration",
+	"GroupExpressionOptimization",
+	"GroupExpressionImplementation",
+	"GroupExpressionExploration",
+	"Transformation"
+};
+
+GPOS_CPL_ASSERT(GPOS_ARRAY_SIZE(rgszJobType) == CJob::EjtSentinel);
+
+// names of event types
+static const CHAR *rgszEventType[] =
+{
+	"completed",
+	"suspended",
+	"runnable",
+	"resumed"
+};
+
+GPOS_CPL_ASSERT(GPOS_ARRAY_SIZE(rgszEventType) == CJobTrace::EetSentinel);
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::CJobTrace
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CJobTrace::CJobTrace
+	(
+	IMemoryPool *pmp,
+	ULONG ulWorkers,
+	ULONG ulEvents
+	)
+	:
+	m_pmp(pmp),
+	m_ulWorkers(ulWorkers),
+	m_ulEvents(ulEvents),
+	m_rgring(NULL)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(0 < ulWorkers);
+	GPOS_ASSERT(0 < ulEvents);
+
+	m_rgring = GPOS_NEW_ARRAY(m_pmp, SRing, m_ulWorkers);
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		m_rgring[ul].m_ulpRecorded = 0;
+		m_rgring[ul].m_rgev = GPOS_NEW_ARRAY(m_pmp, SEvent, m_ulEvents);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::~CJobTrace
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CJobTrace::~CJobTrace()
+{
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		GPOS_DELETE_ARRAY(m_rgring[ul].m_rgev);
+	}
+
+	GPOS_DELETE_ARRAY(m_rgring);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::Record
+//
+//	@doc:
+//		Record an event in a worker's ring; workers sharing a ring reserve
+//		distinct slots
+//
+//---------------------------------------------------------------------------
+void
+CJobTrace::Record
+	(
+	ULONG ulWorker,
+	const SEvent &ev
+	)
+{
+	SRing &ring = m_rgring[ulWorker % m_ulWorkers];
+
+	const ULONG_PTR ulpSlot = UlpExchangeAdd(&ring.m_ulpRecorded, 1);
+	ring.m_rgev[ulpSlot % m_ulEvents] = ev;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::BeginExecution
+//
+//	@doc:
+//		Start recording an execution slice of a job
+//
+//---------------------------------------------------------------------------
+void
+CJobTrace::BeginExecution
+	(
+	SEvent *pev,
+	CJob *pj
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pev);
+	GPOS_ASSERT(NULL != pj);
+
+	pev->m_eet = EetSentinel;
+	pev->m_ejt = pj->Ejt();
+	pev->m_ulJobId = pj->UlId();
+	pev->m_ulGroupId = pj->UlGroupId();
+	pev->m_ulXformId = pj->UlXformId();
+	pev->m_ulStartUs = UlElapsedUS();
+	pev->m_ulDurationUs = 0;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::EndExecution
+//
+//	@doc:
+//		Record an execution slice with the given outcome
+//
+//---------------------------------------------------------------------------
+void
+CJobTrace::EndExecution
+	(
+	ULONG ulWorker,
+	SEvent *pev,
+	EEventType eet
+	)
+{
+	GPOS_ASSERT(NULL != pev);
+	GPOS_ASSERT(EetResumed != eet);
+
+	const ULONG ulEndUs = UlElapsedUS();
+
+	pev->m_eet = eet;
+	pev->m_ulDurationUs = ulEndUs - std::min(ulEndUs, pev->m_ulStartUs);
+
+	Record(ulWorker, *pev);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::RecordResume
+//
+//	@doc:
+//		Record the resumption of a suspended job
+//
+//---------------------------------------------------------------------------
+void
+CJobTrace::RecordResume
+	(
+	ULONG ulWorker,
+	CJob *pj
+	)
+{
+	SEvent ev;
+	BeginExecution(&ev, pj);
+	ev.m_eet = EetResumed;
+
+	Record(ulWorker, ev);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::UlEvents
+//
+//	@doc:
+//		Number of events kept for a worker
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobTrace::UlEvents
+	(
+	ULONG ulWorker
+	)
+	const
+{
+	GPOS_ASSERT(ulWorker < m_ulWorkers);
+
+	return (ULONG) std::min((ULONG_PTR) m_ulEvents, (ULONG_PTR) m_rgring[ulWorker].m_ulpRecorded);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::OsPrintEvent
+//
+//	@doc:
+//		Print a recorded event as a trace-event object
+//
+//---------------------------------------------------------------------------
+IOstream &
+CJobTrace::OsPrintEvent
+	(
+	IOstream &os,
+	ULONG ulWorker,
+	const SEvent &ev
+	)
+	const
+{
+	GPOS_ASSERT(EetSentinel > ev.m_eet);
+	GPOS_ASSERT(CJob::EjtSentinel > ev.m_ejt);
+
+	os
+		<< "{\"name\":\"" << rgszJobType[ev.m_ejt] << "\",\"cat\":\"job\"";
+
+	if (EetResumed == ev.m_eet)
+	{
+		os << ",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << ev.m_ulStartUs;
+	}
+	else
+	{
+		os << ",\"ph\":\"X\",\"ts\":" << ev.m_ulStartUs << ",\"dur\":" << ev.m_ulDurationUs;
+	}
+
+	os
+		<< ",\"pid\":0,\"tid\":" << ulWorker
+		<< ",\"args\":{\"job\":" << ev.m_ulJobId
+		<< ",\"event\":\"" << rgszEventType[ev.m_eet] << "\"";
+
+	if (gpos::ulong_max != ev.m_ulGroupId)
+	{
+		os << ",\"group\":" << ev.m_ulGroupId;
+	}
+
+	if (gpos::ulong_max != ev.m_ulXformId)
+	{
+		CXform *pxform = CXformFactory::Pxff()->Pxf((CXform::EXformId) ev.m_ulXformId);
+		os << ",\"xform\":\"" << pxform->SzId() << "\"";
+	}
+
+	return os << "}}";
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTrace::OsPrintChromeTrace
+//
+//	@doc:
+//		Export events in Chrome trace-event format; events of each worker
+//		are printed from oldest to newest
+//
+//---------------------------------------------------------------------------
+IOstream &
+CJobTrace::OsPrintChromeTrace
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "{\"traceEvents\":[";
+
+	BOOL fFirst = true;
+	for (ULONG ulWorker = 0; ulWorker < m_ulWorkers; ulWorker++)
+	{
+		if (!fFirst)
+		{
+			os << ",";
+		}
+		fFirst = false;
+
+		os
+			<< std::endl
+			<< "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ulWorker
+			<< ",\"args\":{\"name\":\"worker " << ulWorker << "\"}}";
+
+		const SRing &ring = m_rgring[ulWorker];
+		const ULONG_PTR ulpRecorded = ring.m_ulpRecorded;
+		const ULONG_PTR ulpFirst = ulpRecorded - UlEvents(ulWorker);
+		for (ULONG_PTR ulp = ulpFirst; ulp < ulpRecorded; ulp++)
+		{
+			os << "," << std::endl;
+			(void) OsPrintEvent(os, ulWorker, ring.m_rgev[ulp % m_ulEvents]);
+		}
+	}
+
+	return os << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+// EOF
+
@@ -9,6 +9,8 @@
 //		Implementation of group expression transformation job
 //---------------------------------------------------------------------------
 
+#include "gpos/memory/CAutoMemoryPoolRegion.h"
+
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/operators/CLogical.h"
 #include "gpopt/search/CGroup.h"
@@ -127,6 +129,36 @@ CJobTransformation::Init
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTransformation::UlGroupId
+//
+//	@doc:
+//		Id of the group of target group expression
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobTransformation::UlGroupId() const
+{
+	return m_pgexpr->Pgroup()->UlId();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTransformation::UlXformId
+//
+//	@doc:
+//		Id of the xform to apply
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobTransformation::UlXformId() const
+{
+	return (ULONG) m_pxform->Exfid();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobTransformation::EevtTransform
@@ -149,10 +181,22 @@ CJobTransformation::EevtTransform
 	CGroupExpression *pgexpr = pjt->m_pgexpr;
 	CXform *pxform = pjt->m_pxform;
 
+	if (pxform->FExploration() && psc->Peng()->FExplorationStopped())
+	{
+		// skip exploration xforms scheduled before exploration was stopped
+		return eevCompleted;
+	}
+
+	// scratch data of the xform, e.g. statistics derived to check its
+	// promise, is bump-allocated in a region of the local pool and given
+	// back at once; results are created in the global pool as they are
+	// inserted to memo
+	CAutoMemoryPoolRegion amprScratch(pmpLocal);
+
 	// insert transformation results to memo
 	CXformResult *pxfres = GPOS_NEW(pmpGlobal) CXformResult(pmpGlobal);
 	ULONG ulElapsedTime = 0;
-	pgexpr->Transform(pmpGlobal, pmpLocal, pxform, pxfres, &ulElapsedTime);
+	pgexpr->Transform(pmpGlobal, amprScratch.Pmp(), pxform, pxfres, &ulElapsedTime);
 	psc->Peng()->InsertXformResult(pgexpr->Pgroup(), pxfres, pxform->Exfid(), pgexpr, ulElapsedTime);
 	pxfres->Release();
 
@@ -202,7 +246,7 @@ CJobTransformation::ScheduleJob
 	// initialize job
 	CJobTransformation *pjt = PjConvert(pj);
 	pjt->Init(pgexpr, pxform);
-	psc->Psched()->Add(pjt, pjParent);
+	psc->Psched()->Add(pjt, pjParent, psc);
 }
 
 #ifdef GPOS_DEBUG
@@ -10,11 +10,17 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CSyncHashtableAccessByIter.h"
 #include "gpos/common/CSyncHashtableAccessByKey.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/sync/CAutoMutex.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/sync/CSpinlock.h"
+#include "gpos/task/CAutoTaskProxy.h"
+#include "gpos/task/CWorkerPoolManager.h"
 
 #include "gpopt/exception.h"
 
@@ -34,30 +40,39 @@
 using namespace gpopt;
 
 #define GPOPT_MEMO_HT_BUCKETS	50000
+
+// minimum number of groups to derive stats on multiple workers
+#define GPOPT_MEMO_PARALLEL_STATS_MIN_GROUPS	32
 			
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::CMemo
 //
 //	@doc:
-//		Ctor
+//		Ctor; the group expression hash table and the group array are
+//		allocated from the index pool, which must outlive the memo
 //
 //---------------------------------------------------------------------------
 CMemo::CMemo
 	(
-	IMemoryPool *pmp
+	IMemoryPool *pmp,
+	IMemoryPool *pmpIndex,
+	BOOL fSingleThreaded
 	)
 	:
 	m_pmp(pmp),
+	m_fSingleThreaded(fSingleThreaded),
 	m_pgroupRoot(NULL),
-	m_ulpGrps(0),
-	m_pmemotmap(NULL)
+	m_pmemotmap(NULL),
+	m_ulParallelStatsDerivations(0),
+	m_sarGroups(pmpIndex)
 {
 	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pmpIndex);
 
 	m_sht.Init
 		(
-		pmp,
+		pmpIndex,
 		GPOPT_MEMO_HT_BUCKETS,
 		GPOS_OFFSET(CGroupExpression, m_linkMemo),
 		0, /*cKeyOffset (0 because we use CGroupExpression class as key)*/
@@ -65,8 +80,6 @@ CMemo::CMemo
 		CGroupExpression::UlHash,
 		CGroupExpression::FEqual
 		);
-
-	m_listGroups.Init(GPOS_OFFSET(CGroup, m_link));
 }
 
 
@@ -80,13 +93,14 @@ CMemo::CMemo
 //---------------------------------------------------------------------------
 CMemo::~CMemo()
 {
-	CGroup *pgroup = m_listGroups.PtFirst();
-	while(NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
-		CGroup *pgroupNext = m_listGroups.PtNext(pgroup);
-		pgroup->Release();
-		
-		pgroup = pgroupNext;
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup)
+		{
+			pgroup->Release();
+		}
 	}
 
 	GPOS_DELETE(m_pmemotmap);
@@ -119,14 +133,16 @@ CMemo::SetRoot
 //		CMemo::Add
 //
 //	@doc:
-//		Add new group to list
+//		Add new group at the slot reserved for its id; publishing the group
+//		does not allocate, hence this is safe under the hash table's lock
 //
 //---------------------------------------------------------------------------
 void
 CMemo::Add
 	(
 	CGroup *pgroup,
-	CExpression *pexprOrigin // origin expression that produced the group
+	CExpression *pexprOrigin, // origin expression that produced the group
+	ULONG ulId
 	)
 {
 	GPOS_ASSERT(NULL != pgroup);
@@ -145,7 +161,6 @@ CMemo::Add
 	}
 	GPOS_ASSERT(NULL != pdp);
 
-	ULONG ulId = m_aul.TIncr();
 	pdp->AddRef();
 #ifdef GPOS_DEBUG
 	CGroupExpression *pgexpr = NULL;
@@ -160,8 +175,7 @@ CMemo::Add
 	}
 
 	GPOS_ASSERT(NULL != pgexpr);
-	m_listGroups.Push(pgroup);
-	(void) UlpExchangeAdd(&m_ulpGrps, 1);
+	m_sarGroups.Publish(ulId, pgroup);
 }
 
 
@@ -170,8 +184,10 @@ CMemo::Add
 //		CMemo::PgroupInsert
 //
 //	@doc:
-//		Helper for inserting group expression in target group
-//
+//		Helper for inserting group expression in target group; the id of
+//		a new target group, and the target group's slot for the group
+//		expression, are installed by the caller; return NULL if concurrent
+//		insertions used up that slot
 //
 //---------------------------------------------------------------------------
 CGroup *
@@ -180,7 +196,7 @@ CMemo::PgroupInsert
 	CGroup *pgroupTarget,
 	CGroupExpression *pgexpr,
 	CExpression *pexprOrigin,
-	BOOL fNewGroup
+	ULONG ulNewGroupId
 	)
 {
 	GPOS_ASSERT(NULL != pgroupTarget);
@@ -192,19 +208,24 @@ CMemo::PgroupInsert
 	CGroupExpression *pgexprFound = shta.PtLookup();
 	if (NULL == pgexprFound)
 	{
-		shta.Insert(pgexpr);
-
 		// group proxy scope
 		{
 			CGroupProxy gp(pgroupTarget);
-			gp.Insert(pgexpr);
+			if (!gp.FInsert(pgexpr))
+			{
+				return NULL;
+			}
 		}
 
-		if (fNewGroup)
+		if (gpos::ulong_max != ulNewGroupId)
 		{
-			Add(pgroupTarget, pexprOrigin);
+			Add(pgroupTarget, pexprOrigin, ulNewGroupId);
 		}
 
+		// other workers find the group expression, and a new group, only
+		// once the group has its id and properties
+		shta.Insert(pgexpr);
+
 		return pgexpr->Pgroup();
 	}
 
@@ -232,7 +253,7 @@ CMemo::FNewGroup
 
 	if (NULL == *ppgroupTarget && NULL == pgexpr)
 	{
-		*ppgroupTarget = GPOS_NEW(m_pmp) CGroup(m_pmp, fScalar);
+		*ppgroupTarget = GPOS_NEW(m_pmp) CGroup(m_pmp, fScalar, m_fSingleThreaded);
 
 		return true;
 	}
@@ -277,10 +298,15 @@ CMemo::PgroupInsert
 
 	// check if we may need to create a new group
 	BOOL fNewGroup = FNewGroup(&pgroupTarget, pgexprFound, pgexpr->Pop()->FScalar());
+	ULONG ulNewGroupId = gpos::ulong_max;
 	if (fNewGroup)
 	{
 		// we may add a new group to Memo, so we derive props here
 		(void) pexprOrigin->PdpDerive();
+
+		// reserve the group's id outside of the hash table's lock, since
+		// reserving may allocate
+		ulNewGroupId = (ULONG) m_sarGroups.UlpReserve();
 	}
 
 	if (NULL != pgexprFound)
@@ -289,7 +315,14 @@ CMemo::PgroupInsert
 	}
 	else
 	{
-		pgroupContainer = PgroupInsert(pgroupTarget, pgexpr, pexprOrigin, fNewGroup);
+		// install the target group's slot for the group expression outside
+		// of the locks taken to insert it, since installing may allocate
+		do
+		{
+			pgroupTarget->InstallGExprSlot();
+			pgroupContainer = PgroupInsert(pgroupTarget, pgexpr, pexprOrigin, ulNewGroupId);
+		}
+		while (NULL == pgroupContainer);
 	}
 
 	// if insertion failed, release group as needed
@@ -443,7 +476,7 @@ CMemo::PexprExtractPlan
 //		CMemo::Pgroup
 //
 //	@doc:
-//		Get group by id;
+//		Get group by id; NULL if there is no group with that id
 //
 //---------------------------------------------------------------------------
 CGroup *
@@ -452,18 +485,12 @@ CMemo::Pgroup
 	ULONG ulId
 	)
 {
-	CGroup *pgroup = m_listGroups.PtFirst();
-
-	while (NULL != pgroup)
+	if (ulId >= m_sarGroups.UlpSize())
 	{
-		if (ulId == pgroup->UlId())
-		{
-			return pgroup;
-		}
-		pgroup = m_listGroups.PtNext(pgroup);
+		return NULL;
 	}
 
-	return NULL;
+	return m_sarGroups[ulId];
 }
 #endif // GPOS_DEBUG
 
@@ -613,11 +640,14 @@ CMemo::GroupMerge()
 	BOOL fNewDupGroups = true;
 	while (fNewDupGroups)
 	{
-		CGroup *pgroup = m_listGroups.PtFirst();
-		while (NULL != pgroup)
+		const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+		for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 		{
-			pgroup->MergeGroup();
-			pgroup = m_listGroups.PtNext(pgroup);
+			CGroup *pgroup = m_sarGroups[ulp - 1];
+			if (NULL != pgroup)
+			{
+				pgroup->MergeGroup();
+			}
 
 			GPOS_CHECK_ABORT;
 		}
@@ -667,10 +697,15 @@ CMemo::OsPrint
 	IOstream &os
 	)
 {
-	CGroup *pgroup = m_listGroups.PtFirst();
-	
-	while (NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL == pgroup)
+		{
+			continue;
+		}
+
 		CAutoTrace at(m_pmp);
 
 		if (m_pgroupRoot == pgroup)
@@ -679,7 +714,6 @@ CMemo::OsPrint
 		}
 		
 		pgroup->OsPrint(at.Os());
-		pgroup = m_listGroups.PtNext(pgroup);
 
 		GPOS_CHECK_ABORT;
 	}
@@ -698,30 +732,356 @@ CMemo::OsPrint
 void
 CMemo::DeriveStatsIfAbsent
 	(
-	IMemoryPool *pmpLocal
+	IMemoryPool *pmpLocal,
+	ULONG ulWorkers
 	)
 {
-	CGroup *pgroup = m_listGroups.PtFirst();
+	if (!m_fSingleThreaded &&
+		1 < ulWorkers &&
+		GPOPT_MEMO_PARALLEL_STATS_MIN_GROUPS <= UlpGroups())
+	{
+		DeriveStatsParallel(pmpLocal, ulWorkers);
+		m_ulParallelStatsDerivations++;
+	}
 
-	while (NULL != pgroup)
+	// derive remaining stats, e.g. of groups marked as duplicates
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL == pgroup)
+		{
+			continue;
+		}
+
 		GPOS_ASSERT(!pgroup->FImplemented());
 		if (NULL == pgroup->Pstats())
 		{
-			CGroupExpression *pgexprFirst = CEngine::PgexprFirst(pgroup);
+			CEngine::DeriveStats(pmpLocal, m_pmp, pgroup, NULL /*prprel*/);
+		}
+
+		GPOS_CHECK_ABORT;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::UlStatsLevel
+//
+//	@doc:
+//		Compute stats derivation level of a logical group; leaf groups are
+//		on level 0, levels of visited groups are memoized by group id
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemo::UlStatsLevel
+	(
+	CGroup *pgroup,
+	ULONG *rgulLevel
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(!pgroup->FScalar());
+
+	if (pgroup->FDuplicateGroup())
+	{
+		// stats of a duplicate group are derived on the group it duplicates
+		pgroup = pgroup->PgroupDuplicate();
+	}
+
+	const ULONG ulId = pgroup->UlId();
+	GPOS_ASSERT(ulId < UlpGroups());
+	if (gpos::ulong_max != rgulLevel[ulId])
+	{
+		return rgulLevel[ulId];
+	}
+
+	ULONG ulLevel = 0;
+
+	CGroupExpression *pgexpr = NULL;
+	{
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprNextLogical(NULL /*pgexpr*/);
+	}
+
+	while (NULL != pgexpr)
+	{
+		const ULONG ulArity = pgexpr->UlArity();
+		for (ULONG ul = 0; ul < ulArity; ul++)
+		{
+			CGroup *pgroupChild = (*pgexpr)[ul];
+			if (!pgroupChild->FScalar())
+			{
+				ulLevel = std::max(ulLevel, UlStatsLevel(pgroupChild, rgulLevel) + 1);
+			}
+		}
+
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprNextLogical(pgexpr);
+	}
+
+	rgulLevel[ulId] = ulLevel;
+
+	return ulLevel;
+}
 
-			CExpressionHandle exprhdl(m_pmp);
-			exprhdl.Attach(pgexprFirst);
-			exprhdl.DeriveStats(pmpLocal, m_pmp, NULL, NULL);
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::DeriveStatsParallel
+//
+//	@doc:
+//		Derive stats of logical groups without stats on multiple workers;
+//		groups are ordered by level and a group is derived only once all
+//		groups on lower levels are done, hence stats are derived from the
+//		leaves to the root and child stats are found instead of being
+//		derived recursively; the calling task derives stats as well, so
+//		derivation completes even if no worker picks up the helper tasks;
+//		this function is not thread-safe with concurrent memo updates
+//
+//---------------------------------------------------------------------------
+void
+CMemo::DeriveStatsParallel
+	(
+	IMemoryPool *pmpLocal,
+	ULONG ulWorkers
+	)
+{
+	GPOS_ASSERT(1 < ulWorkers);
+
+	const ULONG ulIds = (ULONG) UlpGroups();
+	CAutoRg<ULONG> a_rgulLevel;
+	a_rgulLevel = GPOS_NEW_ARRAY(m_pmp, ULONG, ulIds);
+	for (ULONG ul = 0; ul < ulIds; ul++)
+	{
+		a_rgulLevel[ul] = gpos::ulong_max;
+	}
+
+	// compute levels of groups to derive stats on
+	ULONG ulGroups = 0;
+	ULONG ulLevels = 0;
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
+	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup && !pgroup->FScalar() && !pgroup->FDuplicateGroup() && NULL == pgroup->Pstats())
+		{
+			ulLevels = std::max(ulLevels, UlStatsLevel(pgroup, a_rgulLevel.Rgt()) + 1);
+			ulGroups++;
 		}
+	}
 
-		pgroup = m_listGroups.PtNext(pgroup);
+	if (0 == ulGroups)
+	{
+		return;
+	}
 
-		GPOS_CHECK_ABORT;
+	// order groups by level
+	CAutoRg<ULONG> a_rgulPos;
+	a_rgulPos = GPOS_NEW_ARRAY(m_pmp, ULONG, ulLevels + 1);
+	for (ULONG ul = 0; ul <= ulLevels; ul++)
+	{
+		a_rgulPos[ul] = 0;
+	}
+
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
+	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup && !pgroup->FScalar() && !pgroup->FDuplicateGroup() && NULL == pgroup->Pstats())
+		{
+			a_rgulPos[a_rgulLevel[pgroup->UlId()] + 1]++;
+		}
+	}
+
+	for (ULONG ul = 1; ul <= ulLevels; ul++)
+	{
+		a_rgulPos[ul] += a_rgulPos[ul - 1];
+	}
+
+	CAutoRg<CGroup*> a_rgpgroup;
+	a_rgpgroup = GPOS_NEW_ARRAY(m_pmp, CGroup*, ulGroups);
+	CAutoRg<ULONG> a_rgulLevelStart;
+	a_rgulLevelStart = GPOS_NEW_ARRAY(m_pmp, ULONG, ulGroups);
+
+	CAutoRg<ULONG> a_rgulNext;
+	a_rgulNext = GPOS_NEW_ARRAY(m_pmp, ULONG, ulLevels);
+	for (ULONG ul = 0; ul < ulLevels; ul++)
+	{
+		a_rgulNext[ul] = a_rgulPos[ul];
+	}
+
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
+	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup && !pgroup->FScalar() && !pgroup->FDuplicateGroup() && NULL == pgroup->Pstats())
+		{
+			const ULONG ulLevel = a_rgulLevel[pgroup->UlId()];
+			const ULONG ulPos = a_rgulNext[ulLevel]++;
+			a_rgpgroup[ulPos] = pgroup;
+			a_rgulLevelStart[ulPos] = a_rgulPos[ulLevel];
+		}
+	}
+
+	SStatsDerivation sd;
+	sd.m_pmpLocal = pmpLocal;
+	sd.m_pmpGlobal = m_pmp;
+	sd.m_rgpgroup = a_rgpgroup.Rgt();
+	sd.m_rgulLevelStart = a_rgulLevelStart.Rgt();
+	sd.m_ulGroups = ulGroups;
+	sd.m_ulpNext = 0;
+	sd.m_ulpDone = 0;
+	sd.m_ptskFailed = NULL;
+	sd.m_event.Init(&sd.m_mutex);
+
+	// the calling task is one of the workers
+	const ULONG ulHelpers = ulWorkers - 1;
+	CAutoRg<CTask*> a_rgptsk;
+	a_rgptsk = GPOS_NEW_ARRAY(m_pmp, CTask*, ulHelpers);
+
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+	pwpm->Prewarm(ulHelpers);
+	CAutoTaskProxy atp(m_pmp, pwpm);
+	for (ULONG ul = 0; ul < ulHelpers; ul++)
+	{
+		a_rgptsk[ul] = atp.PtskCreate(PvDeriveStats, &sd);
+
+		// store a pointer to optimizer's context in task local storage
+		a_rgptsk[ul]->Tls().Reset(m_pmp);
+		a_rgptsk[ul]->Tls().Store(COptCtxt::PoctxtFromTLS());
+	}
+
+	for (ULONG ul = 0; ul < ulHelpers; ul++)
+	{
+		atp.Schedule(a_rgptsk[ul]);
+	}
+
+	DeriveStats(&sd);
+
+	// wait for groups claimed by helper tasks; helper tasks that did
+	// not start are canceled when the task proxy is destroyed
+	CTask *ptskFailed = NULL;
+	{
+		CAutoMutex am(sd.m_mutex);
+		am.Lock();
+
+		while (sd.m_ulpDone < ulGroups && NULL == sd.m_ptskFailed)
+		{
+			sd.m_event.Wait();
+		}
+
+		ptskFailed = sd.m_ptskFailed;
+	}
+
+	if (NULL != ptskFailed)
+	{
+		// propagate error of failed helper task
+		atp.Wait(ptskFailed);
 	}
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::DeriveStats
+//
+//	@doc:
+//		Derive stats on claimed groups; a claimed group waits for all
+//		groups on lower levels, which are claimed before it
+//
+//---------------------------------------------------------------------------
+void
+CMemo::DeriveStats
+	(
+	SStatsDerivation *psd
+	)
+{
+	GPOS_ASSERT(NULL != psd);
+
+	while (true)
+	{
+		const ULONG ulPos = (ULONG) UlpExchangeAdd(&psd->m_ulpNext, 1);
+		if (ulPos >= psd->m_ulGroups)
+		{
+			return;
+		}
+
+		// wait for lower levels
+		{
+			CAutoMutex am(psd->m_mutex);
+			am.Lock();
+
+			while (psd->m_ulpDone < psd->m_rgulLevelStart[ulPos])
+			{
+				if (NULL != psd->m_ptskFailed)
+				{
+					return;
+				}
+
+				psd->m_event.Wait();
+			}
+		}
+
+		CGroup *pgroup = psd->m_rgpgroup[ulPos];
+		if (NULL == pgroup->Pstats())
+		{
+			CEngine::DeriveStats(psd->m_pmpLocal, psd->m_pmpGlobal, pgroup, NULL /*prprel*/);
+		}
+
+		// release tasks waiting for this level
+		{
+			CAutoMutex am(psd->m_mutex);
+			am.Lock();
+
+			psd->m_ulpDone++;
+			psd->m_event.Broadcast();
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::PvDeriveStats
+//
+//	@doc:
+//		Task function of parallel stats derivation
+//
+//---------------------------------------------------------------------------
+void *
+CMemo::PvDeriveStats
+	(
+	void *pv
+	)
+{
+	SStatsDerivation *psd = reinterpret_cast<SStatsDerivation*>(pv);
+
+	GPOS_TRY
+	{
+		DeriveStats(psd);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// release tasks waiting for the groups claimed by this task
+		{
+			CAutoMutex am(psd->m_mutex);
+			am.Lock();
+
+			if (NULL == psd->m_ptskFailed)
+			{
+				psd->m_ptskFailed = CTask::PtskSelf();
+			}
+			psd->m_event.Broadcast();
+		}
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	return NULL;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::ResetGroupStates
@@ -733,15 +1093,18 @@ CMemo::DeriveStatsIfAbsent
 void
 CMemo::ResetGroupStates()
 {
-	CGroup *pgroup = m_listGroups.PtFirst();
-
-	while (NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL == pgroup)
+		{
+			continue;
+		}
+
 		pgroup->ResetGroupState();
 		pgroup->ResetGroupJobQueues();
 		pgroup->ResetHasNewLogicalOperators();
-
-		pgroup = m_listGroups.PtNext(pgroup);
 	}
 }
 
@@ -804,11 +1167,14 @@ CMemo::ResetTreeMap()
 	}
 
 	// reset link map of all groups
-	CGroup *pgroup = m_listGroups.PtFirst();
-	while (NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
-		pgroup->ResetLinkMap();
-		pgroup = m_listGroups.PtNext(pgroup);
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup)
+		{
+			pgroup->ResetLinkMap();
+		}
 	}
 }
 
@@ -825,14 +1191,14 @@ ULONG
 CMemo::UlDuplicateGroups()
 {
 	ULONG ulDuplicates = 0;
-	CGroup *pgroup = m_listGroups.PtFirst();
-	while (NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
-		if (pgroup->FDuplicateGroup())
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup && pgroup->FDuplicateGroup())
 		{
 			ulDuplicates ++;
 		}
-		pgroup = m_listGroups.PtNext(pgroup);
 	}
 
 	return ulDuplicates;
@@ -851,11 +1217,14 @@ ULONG
 CMemo::UlGrpExprs()
 {
 	ULONG ulGExprs = 0;
-	CGroup *pgroup = m_listGroups.PtFirst();
-	while (NULL != pgroup)
+	const ULONG_PTR ulpGroups = m_sarGroups.UlpSize();
+	for (ULONG_PTR ulp = ulpGroups; 0 < ulp; ulp--)
 	{
-		ulGExprs += pgroup->UlGExprs();
-		pgroup = m_listGroups.PtNext(pgroup);
+		CGroup *pgroup = m_sarGroups[ulp - 1];
+		if (NULL != pgroup)
+		{
+			ulGExprs += pgroup->UlGExprs();
+		}
 	}
 
 	return ulGExprs;
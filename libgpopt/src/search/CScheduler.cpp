@@ -11,10 +11,14 @@
 
 #include "gpos/base.h"
 
+#include "gpos/common/CWallClock.h"
 #include "gpos/sync/CAutoMutex.h"
+#include "gpos/sync/CAutoSpinlock.h"
 
+#include "gpopt/engine/CEngine.h"
 #include "gpopt/search/CJob.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobTrace.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 
@@ -22,6 +26,16 @@
 
 using namespace gpopt;
 
+// traced event of each job execution result
+static const CJobTrace::EEventType rgeetJobResult[] =
+{
+	CJobTrace::EetRunnable,
+	CJobTrace::EetSuspended,
+	CJobTrace::EetCompleted
+};
+
+GPOS_CPL_ASSERT(GPOS_ARRAY_SIZE(rgeetJobResult) == CScheduler::EjrSentinel);
+
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -42,14 +56,23 @@ CScheduler::CScheduler
 #endif // GPOS_DEBUG
 	)
 	:
+	m_pmp(pmp),
+	m_rgwq(NULL),
 	m_spjl(pmp, ulJobs),
 	m_ulpTasksMax(ulpTasks),
 	m_ulpTasksActive(0),
+	m_ulpWorkers(0),
+	m_ulpJobTimeUs(0),
 	m_ulpTotal(0),
 	m_ulpRunning(0),
 	m_ulpQueued(0),
+	m_pjtrace(NULL),
+	m_ulExplorationDeadlineMs(gpos::ulong_max),
+	m_ulDeadlineMs(gpos::ulong_max),
+	m_fDeadlineExpired(false),
 	m_ulpStatsQueued(0),
 	m_ulpStatsDequeued(0),
+	m_ulpStatsStolen(0),
 	m_ulpStatsSuspended(0),
 	m_ulpStatsCompleted(0),
 	m_ulpStatsCompletedQueued(0),
@@ -62,8 +85,17 @@ CScheduler::CScheduler
 	// initialize pool of job links
 	m_spjl.Init(GPOS_OFFSET(SJobLink, m_ulId));
 
+	GPOS_ASSERT(0 < ulpTasks);
+
 	// initialize list of waiting new jobs
 	m_listjlWaiting.Init(GPOS_OFFSET(SJobLink, m_link));
+
+	// initialize per-worker deques
+	m_rgwq = GPOS_NEW_ARRAY(m_pmp, SWorkerQueue, m_ulpTasksMax);
+	for (ULONG_PTR ulp = 0; ulp < m_ulpTasksMax; ulp++)
+	{
+		m_rgwq[ulp].m_listjl.Init(GPOS_OFFSET(SJobLink, m_link));
+	}
 	
 	// initialize event for job queue
 	m_event.Init(&m_mutex);
@@ -95,6 +127,8 @@ CScheduler::~CScheduler()
 		);
 
 	GPOS_ASSERT(0 == m_event.CWaiters());
+
+	GPOS_DELETE_ARRAY(m_rgwq);
 }
 
 
@@ -133,6 +167,10 @@ CScheduler::ProcessJobs
 	CSchedulerContext *psc
 	)
 {
+	GPOS_ASSERT(this == psc->Psched());
+
+	RegisterWorker(psc);
+
 	while (true)
 	{
 		IncTasksActive();
@@ -152,6 +190,12 @@ CScheduler::ProcessJobs
 			break;
 		}
 
+		// do not park the last worker while jobs are queued
+		if (0 < m_ulpQueued && 0 == m_ulpTasksActive)
+		{
+			continue;
+		}
+
 		// wait until there is enough work to pick up
 		m_event.Wait();
 
@@ -160,13 +204,38 @@ CScheduler::ProcessJobs
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::RegisterWorker
+//
+//	@doc:
+// 		Assign a job deque to the worker running the given context;
+//		deques are handed out round-robin, in case more workers than
+//		expected run jobs they share deques
+//
+//---------------------------------------------------------------------------
+void
+CScheduler::RegisterWorker
+	(
+	CSchedulerContext *psc
+	)
+{
+	if (!psc->FWorker())
+	{
+		ULONG_PTR ulpWorker = UlpExchangeAdd(&m_ulpWorkers, 1);
+		psc->SetWorker((ULONG) (ulpWorker % m_ulpTasksMax));
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CScheduler::ExecuteJobs
 //
 //	@doc:
 // 		Job processing loop;
-//		keeps executing jobs as long as there is work queued;
+//		keeps executing jobs as long as there is work queued and the
+//		other active workers cannot take over the queued work;
 //
 //---------------------------------------------------------------------------
 void
@@ -178,14 +247,31 @@ CScheduler::ExecuteJobs
 	CJob *pj = NULL;
 	ULONG ulCount = 0;
 
+	// stop exploration if engine's memory exceeds the budget; the budget
+	// is soft, hence it is checked here and then every few jobs only
+	psc->Peng()->CheckMemoryBudget();
+
 	// keep retrieving jobs
-	while (NULL != (pj = PjRetrieve()))
+	while (NULL != (pj = PjRetrieve(psc)))
 	{
+		// stop exploration or abandon jobs if deadline has passed
+		CheckDeadline(psc);
+
 		// prepare for job execution
 		PreExecute(pj);
 
+		// describe job for tracing before it may be resumed or released
+		// by another worker
+		CJobTrace::SEvent ev;
+		if (NULL != m_pjtrace)
+		{
+			m_pjtrace->BeginExecution(&ev, pj);
+		}
+
 		// execute job
+		CWallClock clock;
 		BOOL fCompleted = FExecute(pj, psc);
+		RecordJobTime(clock.UlElapsedUS());
 
 #ifdef GPOS_DEBUG
 		// restrict parallelism to keep track of jobs
@@ -198,11 +284,17 @@ CScheduler::ExecuteJobs
 #endif // GPOS_DEBUG
 
 		// process job result
-		switch (EjrPostExecute(pj, fCompleted))
+		const EJobResult ejr = EjrPostExecute(pj, fCompleted);
+		if (NULL != m_pjtrace)
+		{
+			m_pjtrace->EndExecution(psc->UlWorker(), &ev, rgeetJobResult[ejr]);
+		}
+
+		switch (ejr)
 		{
 			case EjrCompleted:
 				// job is completed
-				Complete(pj);
+				Complete(pj, psc);
 
 #ifdef GPOS_DEBUG
 				if (GPOS_FTRACE(EopttracePrintJobScheduler))
@@ -220,7 +312,7 @@ CScheduler::ExecuteJobs
 
 			case EjrRunnable:
 				// child jobs have completed, job can immediately resume
-				Resume(pj);
+				Resume(pj, psc);
 				continue;
 
 			case EjrSuspended:
@@ -236,6 +328,14 @@ CScheduler::ExecuteJobs
 		{
 			GPOS_CHECK_ABORT;
 			ulCount = 0;
+
+			psc->Peng()->CheckMemoryBudget();
+		}
+
+		// park worker if there is too little work left
+		if (FDecreaseWorkers())
+		{
+			break;
 		}
 	}
 }
@@ -253,7 +353,8 @@ void
 CScheduler::Add
 	(
 	CJob *pj,
-	CJob *pjParent
+	CJob *pjParent,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(NULL != pj);
@@ -280,7 +381,7 @@ CScheduler::Add
 	// increment total number of jobs
 	(void) UlpExchangeAdd(&m_ulpTotal, 1);
 
-	Schedule(pj);
+	Schedule(pj, psc);
 }
 
 
@@ -295,13 +396,14 @@ CScheduler::Add
 void
 CScheduler::Resume
 	(
-	CJob *pj
+	CJob *pj,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(NULL != pj);
 	GPOS_ASSERT(0 == pj->UlpRefs());
 
-	Schedule(pj);
+	Schedule(pj, psc);
 }
 
 
@@ -310,16 +412,19 @@ CScheduler::Resume
 //		CScheduler::Schedule
 //
 //	@doc:
-//		Schedule job for execution
+//		Schedule job for execution; jobs scheduled by a worker are pushed to
+//		the tail of its deque
 //
 //---------------------------------------------------------------------------
 void
 CScheduler::Schedule
 	(
-	CJob *pj
+	CJob *pj,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(NULL != pj);
+	GPOS_ASSERT_IMP(NULL != psc, this == psc->Psched());
 	GPOS_ASSERT_IMP(FTrackingJobs(), m_mutex.FOwned());
 
 	// get job link
@@ -345,8 +450,21 @@ CScheduler::Schedule
 	}
 #endif // GPOS_DEBUG
 
-	// add to waiting list
-	m_listjlWaiting.Push(pjl);
+	if (NULL != psc && psc->FWorker())
+	{
+		// add to worker's deque
+		SWorkerQueue &wq = m_rgwq[psc->UlWorker()];
+
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+
+		wq.m_listjl.Append(pjl);
+	}
+	else
+	{
+		// add to shared waiting list
+		m_listjlWaiting.Push(pjl);
+	}
 
 	// increment number of queued jobs
 	(void) UlpExchangeAdd(&m_ulpQueued, 1);
@@ -502,12 +620,18 @@ CScheduler::EjrPostExecute
 //		CScheduler::PjRetrieve
 //
 //	@doc:
-//		Retrieve next runnable job from queue
+//		Retrieve next runnable job; the worker's own deque is checked first,
+//		then the shared list, then the deques of other workers
 //
 //---------------------------------------------------------------------------
 CJob *
-CScheduler::PjRetrieve()
+CScheduler::PjRetrieve
+	(
+	CSchedulerContext *psc
+	)
 {
+	GPOS_ASSERT(psc->FWorker());
+
 #ifdef GPOS_DEBUG
 	// restrict parallelism to keep track of jobs
 	CAutoMutex am(m_mutex);
@@ -518,7 +642,18 @@ CScheduler::PjRetrieve()
 #endif // GPOS_DEBUG
 
 	// retrieve runnable job from lists of waiting jobs
-	SJobLink *pjl = m_listjlWaiting.Pop();
+	const ULONG ulWorker = psc->UlWorker();
+	SJobLink *pjl = PjlPop(ulWorker);
+	if (NULL == pjl)
+	{
+		pjl = m_listjlWaiting.Pop();
+	}
+
+	if (NULL == pjl)
+	{
+		pjl = PjlSteal(ulWorker);
+	}
+
 	CJob *pj = NULL;
 
 	if (NULL != pjl)
@@ -553,6 +688,78 @@ CScheduler::PjRetrieve()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::PjlPop
+//
+//	@doc:
+//		Pop most recently queued job link from a worker's deque
+//
+//---------------------------------------------------------------------------
+CScheduler::SJobLink *
+CScheduler::PjlPop
+	(
+	ULONG ulWorker
+	)
+{
+	GPOS_ASSERT(ulWorker < m_ulpTasksMax);
+
+	SWorkerQueue &wq = m_rgwq[ulWorker];
+
+	CAutoSpinlock as(wq.m_slock);
+	as.Lock();
+
+	if (wq.m_listjl.FEmpty())
+	{
+		return NULL;
+	}
+
+	return wq.m_listjl.RemoveTail();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::PjlSteal
+//
+//	@doc:
+//		Steal least recently queued job link from the deque of another
+//		worker; victims are visited starting from the next worker
+//
+//---------------------------------------------------------------------------
+CScheduler::SJobLink *
+CScheduler::PjlSteal
+	(
+	ULONG ulWorker
+	)
+{
+	GPOS_ASSERT(ulWorker < m_ulpTasksMax);
+
+	for (ULONG_PTR ulp = 1; ulp < m_ulpTasksMax; ulp++)
+	{
+		SWorkerQueue &wq = m_rgwq[(ulWorker + ulp) % m_ulpTasksMax];
+
+		// skip empty deques without taking their lock
+		if (wq.m_listjl.FEmpty())
+		{
+			continue;
+		}
+
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+
+		if (!wq.m_listjl.FEmpty())
+		{
+			(void) UlpExchangeAdd(&m_ulpStatsStolen, 1);
+
+			return wq.m_listjl.RemoveHead();
+		}
+	}
+
+	return NULL;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CScheduler::Suspend
@@ -598,7 +805,8 @@ CScheduler::Suspend
 void
 CScheduler::Complete
 	(
-	CJob *pj
+	CJob *pj,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -613,7 +821,7 @@ CScheduler::Complete
 	}
 #endif // GPOS_DEBUG
 
-	ResumeParent(pj);
+	ResumeParent(pj, psc);
 
 	// update statistics
 	(void) UlpExchangeAdd(&m_ulpTotal, -1);
@@ -632,7 +840,8 @@ CScheduler::Complete
 void
 CScheduler::CompleteQueued
 	(
-	CJob *pj
+	CJob *pj,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -651,7 +860,7 @@ CScheduler::CompleteQueued
 	}
 #endif // GPOS_DEBUG
 
-	ResumeParent(pj);
+	ResumeParent(pj, psc);
 
 	// update statistics
 	(void) UlpExchangeAdd(&m_ulpTotal, -1);
@@ -665,13 +874,15 @@ CScheduler::CompleteQueued
 //		CScheduler::ResumeParent
 //
 //	@doc:
-//		Resume parent job
+//		Resume parent job; the parent is queued at the worker that
+//		completed its last child
 //
 //---------------------------------------------------------------------------
 void
 CScheduler::ResumeParent
 	(
-	CJob *pj
+	CJob *pj,
+	CSchedulerContext *psc
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -691,8 +902,13 @@ CScheduler::ResumeParent
 			}
 #endif // GPOS_DEBUG)
 
+			if (NULL != m_pjtrace)
+			{
+				m_pjtrace->RecordResume(UlTraceWorker(psc), pjParent);
+			}
+
 			// reschedule parent
-			Resume(pjParent);
+			Resume(pjParent, psc);
 
 			// update statistics
 			(void) UlpExchangeAdd(&m_ulpStatsResumed, 1);
@@ -701,6 +917,91 @@ CScheduler::ResumeParent
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::UlTraceWorker
+//
+//	@doc:
+//		Index of the trace ring to record events of the given context;
+//		events recorded outside of workers go to the first ring
+//
+//---------------------------------------------------------------------------
+ULONG
+CScheduler::UlTraceWorker
+	(
+	CSchedulerContext *psc
+	)
+{
+	if (NULL == psc || !psc->FWorker())
+	{
+		return 0;
+	}
+
+	return psc->UlWorker();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::SetDeadline
+//
+//	@doc:
+//		Set deadline, in milliseconds from now, for stopping exploration
+//		and for abandoning outstanding jobs; gpos::ulong_max for none
+//
+//---------------------------------------------------------------------------
+void
+CScheduler::SetDeadline
+	(
+	ULONG ulExplorationDeadlineMs,
+	ULONG ulDeadlineMs
+	)
+{
+	GPOS_ASSERT(ulExplorationDeadlineMs <= ulDeadlineMs);
+
+	m_clockDeadline.Restart();
+	m_ulExplorationDeadlineMs = ulExplorationDeadlineMs;
+	m_ulDeadlineMs = ulDeadlineMs;
+	m_fDeadlineExpired = false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::CheckDeadline
+//
+//	@doc:
+//		Check deadline before dispatching a job; past the exploration
+//		deadline the engine stops exploring, past the deadline jobs are
+//		abandoned as soon as the root group has a plan
+//
+//---------------------------------------------------------------------------
+void
+CScheduler::CheckDeadline
+	(
+	CSchedulerContext *psc
+	)
+{
+	if (m_fDeadlineExpired || gpos::ulong_max == m_ulExplorationDeadlineMs)
+	{
+		return;
+	}
+
+	const ULONG ulElapsedMs = m_clockDeadline.UlElapsedMS();
+	if (ulElapsedMs < m_ulExplorationDeadlineMs)
+	{
+		return;
+	}
+
+	psc->Peng()->StopExploration();
+
+	if (ulElapsedMs >= m_ulDeadlineMs && psc->Peng()->FRootPlanFound())
+	{
+		m_fDeadlineExpired = true;
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CScheduler::PrintStats
@@ -714,10 +1015,11 @@ CScheduler::PrintStats() const
 {
 	GPOS_TRACE_FORMAT
 		(
-		"Job statistics: Queued=%d Dequeued=%d Suspended=%d "
+		"Job statistics: Queued=%d Dequeued=%d Stolen=%d Suspended=%d "
 		                "Resumed=%d CompletedQueued=%d Completed=%d",
 		m_ulpStatsQueued,
 		m_ulpStatsDequeued,
+		m_ulpStatsStolen,
 		m_ulpStatsSuspended,
 		m_ulpStatsResumed,
 		m_ulpStatsCompletedQueued,
@@ -764,6 +1066,21 @@ CScheduler::OsPrintActiveJobs
 		pjl = m_listjlWaiting.PtNext(pjl);
 	}
 
+	for (ULONG_PTR ulp = 0; ulp < m_ulpTasksMax; ulp++)
+	{
+		SWorkerQueue &wq = m_rgwq[ulp];
+
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+
+		pjl = wq.m_listjl.PtFirst();
+		while(NULL != pjl)
+		{
+			pjl->m_pj->OsPrint(os);
+			pjl = wq.m_listjl.PtNext(pjl);
+		}
+	}
+
 	os << std::endl << "List of suspended jobs: " << std::endl;
 	pj = m_listjSuspended.PtFirst();
 	while(NULL != pj)
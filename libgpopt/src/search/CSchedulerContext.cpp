@@ -34,6 +34,7 @@ CSchedulerContext::CSchedulerContext()
 	m_pmpGlobal(NULL),
 	m_pmpLocal(NULL),
 	m_psched(NULL),
+	m_ulWorker(gpos::ulong_max),
 	m_fInit(false)
 {}
 
@@ -57,6 +57,12 @@ void gpos_init(struct gpos_init_params *params);
  */
 int gpos_set_threads(int min, int max);
 
+/*
+ * pin worker threads to processors, or unpin them;
+ * return 0 for successful completion, 1 for error
+ */
+int gpos_pin_threads(bool pin);
+
 /*
  * execute function as a GPOS task using current thread;
  * return 0 for successful completion, 1 for error
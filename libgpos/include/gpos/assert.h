@@ -43,8 +43,9 @@
 // if-and-only-if assert
 #define GPOS_ASSERT_IFF(x,y)	GPOS_ASSERT((!(x) || (y)) && (!(y) || (x)))
 
-// compile assert
-#define GPOS_CPL_ASSERT(x)		extern int assert_array[ (x) ? 1 : -1 ]
+// compile assert; may also be used in function bodies, e.g. to check
+// template parameters
+#define GPOS_CPL_ASSERT(x)		extern int assert_array[ (x) ? 1 : -1 ] __attribute__((unused))
 
 // debug assert, with message
 #define GPOS_ASSERT_MSG(x,msg)  GPOS_ASSERT((x)&&(msg))
@@ -6,7 +6,7 @@
 //		CBitSet.h
 //
 //	@doc:
-//		Implementation of bitset as linked list of bitvectors
+//		Implementation of bitset as array of words
 //---------------------------------------------------------------------------
 #ifndef GPOS_CBitSet_H
 #define GPOS_CBitSet_H
@@ -16,6 +16,11 @@
 #include "gpos/common/CBitVector.h"
 #include "gpos/common/CList.h"
 
+// number of bits in a word of a bitset
+#define GPOS_BITSET_WORD_BITS		(64)
+
+// number of words a bitset stores inline before allocating from its pool
+#define GPOS_BITSET_INLINE_WORDS	(4)
 
 namespace gpos
 {
@@ -25,7 +30,13 @@ namespace gpos
 	//		CBitSet
 	//
 	//	@doc:
-	//		Linked list of CBitSetLink's
+	//		Bitset stored as a contiguous array of words.
+	//
+	//		The array covers the words between the lowest and the highest word
+	//		with a bit set; all bits outside of it are clear. Hence, equal sets
+	//		have equal arrays, and set operations work word by word on the
+	//		overlapping part of two arrays. Small sets are kept in inline
+	//		storage; larger sets allocate their array from the memory pool.
 	//
 	//---------------------------------------------------------------------------
 	class CBitSet : public CRefCount
@@ -35,87 +46,104 @@ namespace gpos
 		
 		protected:
 
-			//---------------------------------------------------------------------------
-			//	@class:
-			//		CBitSetLink
-			//
-			//	@doc:
-			//		bit vector + offset + link
-			//
-			//---------------------------------------------------------------------------
-			class CBitSetLink
-			{
-				private:
-				
-					// private copy ctor
-					CBitSetLink(const CBitSetLink &);
-
-					// offset
-					ULONG m_ulOffset;
-					
-					// bitvector
-					CBitVector *m_pbv;
-
-				public:
-				
-					// ctor
-                    explicit
-                    CBitSetLink(IMemoryPool *, ULONG ulOffset, ULONG cSizeBits);
-
-        			explicit
-					CBitSetLink(IMemoryPool *, const CBitSetLink &);
-					
-					// dtor
-					~CBitSetLink();
-
-					// accessor
-					ULONG UlOffset() const
-					{
-						return m_ulOffset;
-					}
-					
-					// accessor
-					CBitVector *Pbv() const
-					{
-						return m_pbv;
-					}
-										
-					// list link
-					SLink m_link;
-					
-			}; // class CBitSetLink
-		
-			// list of bit set links
-			typedef CList<CBitSetLink> BSLList;
-			BSLList m_bsllist;
-		
-			// pool to allocate links from
+			// pool to allocate words from
 			IMemoryPool *m_pmp;
 		
-			// size of individual bitvectors
-			ULONG m_cSizeBits;
-			
+			// granularity of allocations in words
+			ULONG m_cWordsChunk;
+
+			// index of first stored word
+			ULONG m_ulWordFirst;
+
+			// number of stored words
+			ULONG m_cWords;
+
+			// number of words that fit into the array
+			ULONG m_cWordsCapacity;
+
+			// stored words; points to inline storage or to an allocated array
+			ULLONG *m_rgull;
+
+			// inline storage
+			ULLONG m_rgullInline[GPOS_BITSET_INLINE_WORDS];
+
 			// number of elements
 			ULONG m_cElements;
 		
 			// private copy ctor
 			CBitSet(const CBitSet&);
 			
-			// find link with offset less or equal to given value
-			CBitSetLink *PbslLocate(ULONG, CBitSetLink * = NULL) const;
-			
+			// word holding given bit
+			static
+			ULONG UlWord
+				(
+				ULONG ulBit
+				)
+			{
+				return ulBit / GPOS_BITSET_WORD_BITS;
+			}
+
+			// mask of given bit in its word
+			static
+			ULLONG UllMask
+				(
+				ULONG ulBit
+				)
+			{
+				return ((ULLONG) 1) << (ulBit % GPOS_BITSET_WORD_BITS);
+			}
+
+			// number of bits set in word
+			static
+			ULONG UlPopCount
+				(
+				ULLONG ull
+				)
+			{
+				return (ULONG) __builtin_popcountll(ull);
+			}
+
+			// position of lowest bit set in non-empty word
+			static
+			ULONG UlLowestBit
+				(
+				ULLONG ull
+				)
+			{
+				GPOS_ASSERT(0 != ull);
+				return (ULONG) __builtin_ctzll(ull);
+			}
+
+			// word with given index, zero if not stored
+			ULLONG UllWord
+				(
+				ULONG ulWord
+				)
+				const
+			{
+				if (ulWord - m_ulWordFirst < m_cWords)
+				{
+					return m_rgull[ulWord - m_ulWordFirst];
+				}
+
+				return 0;
+			}
+
+			// extend stored words to cover given range of words
+			void Reserve(ULONG ulWordFirst, ULONG ulWordEnd);
+
+			// drop clear words at both ends of stored words
+			void Trim();
+
 			// reset set
 			void Clear();
 			
-			// compute target offset
-			ULONG UlOffset(ULONG) const;
-			
 			// re-compute size of set
 			void RecomputeSize();
 			
 		public:
 				
-			// ctor
+			// ctor; size is the granularity of allocations in bits
 			CBitSet(IMemoryPool *pmp, ULONG cSizeBits = 256);
 			CBitSet(IMemoryPool *pmp, const CBitSet &);
 			
@@ -22,7 +22,7 @@ namespace gpos
 	//
 	//	@doc:
 	//		Iterator for bitset's; defined as friend, ie can access bitset's 
-	//		internal links
+	//		internal words
 	//
 	//---------------------------------------------------------------------------
 	class CBitSetIter
@@ -32,11 +32,8 @@ namespace gpos
 			// bitset
 			const CBitSet &m_bs;
 
-			// current cursor position (in current link)
-			ULONG m_ulCursor;
-				
-			// current cursor link
-			CBitSet::CBitSetLink *m_pbsl;
+			// current bit, gpos::ulong_max before first advance
+			ULONG m_ulBit;
 		
 			// is iterator active or exhausted
 			BOOL m_fActive;
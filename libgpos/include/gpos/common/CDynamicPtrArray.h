@@ -15,6 +15,9 @@
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/clibwrapper.h"
 
+// default number of elements a dynamic pointer array stores inline
+#define GPOS_DYNAMIC_PTR_ARRAY_INLINE	(4)
+
 namespace gpos
 {
 	
@@ -26,10 +29,12 @@ namespace gpos
 	//		CDynamicPtrArray
 	//
 	//	@doc:
-	//		Simply dynamic array for pointer types
+	//		Simply dynamic array for pointer types;
+	//		the first ulInline elements are stored in the array object itself,
+	//		the elements move to an allocated array once they do not fit
 	//
 	//---------------------------------------------------------------------------
-	template <class T, void (*pfnDestroy)(T*)>
+	template <class T, void (*pfnDestroy)(T*), ULONG ulInline = GPOS_DYNAMIC_PTR_ARRAY_INLINE>
 	class CDynamicPtrArray : public CRefCount
 	{
 		private:
@@ -51,6 +56,9 @@ namespace gpos
 
 			// actual array
 			T **m_ppt;
+
+			// inline storage
+			T *m_rgptInline[ulInline];
 			
 			// comparison function for pointers
 			static INT PtrCmp(const void *pv1, const void *pv2)
@@ -72,7 +80,7 @@ namespace gpos
             }
 
 			// private copy ctor
-			CDynamicPtrArray<T, pfnDestroy> (const CDynamicPtrArray<T, pfnDestroy> &);
+			CDynamicPtrArray(const CDynamicPtrArray &);
 			
 			// resize function
 			void Resize(ULONG ulNewSize)
@@ -84,10 +92,11 @@ namespace gpos
 
                 if (m_ulSize > 0)
                 {
-                    GPOS_ASSERT(NULL != m_ppt);
-
                     clib::PvMemCpy(ppt, m_ppt, sizeof(T*) * m_ulSize);
+                }
 
+                if (m_ppt != m_rgptInline)
+                {
                     GPOS_DELETE_ARRAY(m_ppt);
                 }
 
@@ -100,26 +109,30 @@ namespace gpos
 		
 			// ctor
 			explicit
-			CDynamicPtrArray<T, pfnDestroy> (IMemoryPool *pmp, ULONG ulMinSize = 4, ULONG ulExp = 10)
+			CDynamicPtrArray(IMemoryPool *pmp, ULONG ulMinSize = 4, ULONG ulExp = 10)
             :
             m_pmp(pmp),
-            m_ulAllocated(0),
+            m_ulAllocated(ulInline),
             m_ulMinSize(std::max((ULONG)4, ulMinSize)),
             m_ulSize(0),
             m_ulExp(std::max((ULONG)2, ulExp)),
-            m_ppt(NULL)
+            m_ppt(m_rgptInline)
             {
                 GPOS_ASSERT(NULL != pfnDestroy && "No valid destroy function specified");
 
                 // do not allocate in constructor; defer allocation to first insertion
+                // that does not fit into inline storage
             }
 
 			// dtor
-			~CDynamicPtrArray<T, pfnDestroy> ()
+			~CDynamicPtrArray()
             {
                 Clear();
 
-                GPOS_DELETE_ARRAY(m_ppt);
+                if (m_ppt != m_rgptInline)
+                {
+                    GPOS_DELETE_ARRAY(m_ppt);
+                }
             }
 	
 			// clear elements
@@ -151,7 +164,7 @@ namespace gpos
             }
 			
 			// append array -- flatten it
-			void AppendArray(const CDynamicPtrArray<T, pfnDestroy> *pdrg)
+			void AppendArray(const CDynamicPtrArray *pdrg)
             {
                 GPOS_ASSERT(NULL != pdrg);
                 GPOS_ASSERT(this != pdrg && "Cannot append array to itself");
@@ -191,7 +204,7 @@ namespace gpos
             }
 			
 			// equality check
-			BOOL FEqual(const CDynamicPtrArray<T, pfnDestroy> *pdrg) const
+			BOOL FEqual(const CDynamicPtrArray *pdrg) const
             {
                 BOOL fEqual = (UlLength() == pdrg->UlLength());
 
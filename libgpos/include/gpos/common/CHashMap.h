@@ -16,9 +16,13 @@
 #define GPOS_CHashMap_H
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/CDynamicPtrArray.h"
 
+// maximum number of entries allocated by the first insertion into a hash map
+#define GPOS_HASHMAP_INITIAL_ENTRIES	(8)
+
 namespace gpos
 {	
 	// fwd declaration
@@ -36,6 +40,14 @@ namespace gpos
 	//	@doc:
 	//		Hash map
 	//
+	//		Key/value pairs are stored in an array in insertion order; an
+	//		open-addressing table of slots, each holding the hash value of a
+	//		key and the index of its entry, is probed linearly with robin hood
+	//		insertion, i.e., an inserted key takes over the slot of a key that
+	//		is closer to its home slot. Both arrays double when the entries are
+	//		full, keeping at most half of the slots in use; growing re-inserts
+	//		the stored hash values and does not call the hash function.
+	//
 	//---------------------------------------------------------------------------
 	template <class K, class T, 
 				ULONG (*pfnHash)(const K*), 
@@ -49,223 +61,282 @@ namespace gpos
 
 		private:
 		
-			//---------------------------------------------------------------------------
-			//	@class:
-			//		CHashMapElem
-			//
-			//	@doc:
-			//		Anchor for key/value pair
-			//
-			//---------------------------------------------------------------------------		
-			class CHashMapElem
+			// key/value pair
+			struct SEntry
 			{
-				private:
-				
-					// key/value pair
-					K *m_pk;
-					T *m_pt;
-					
-					// own objects
-					BOOL m_fOwn;
-					
-					// private copy ctor
-					CHashMapElem(const CHashMapElem &);
-				
-				public:
-				
-					// ctor
-					CHashMapElem(K *pk, T *pt, BOOL fOwn)
-                    :
-                    m_pk(pk),
-                    m_pt(pt),
-                    m_fOwn(fOwn)
-                    {
-                        GPOS_ASSERT(NULL != pk);
-                    }
-
-					// dtor 
-					~CHashMapElem()
-                    {
-                        // in case of a temporary hashmap element for lookup we do NOT own the
-                        // objects, otherwise call destroy functions
-                        if (m_fOwn)
-                        {
-                            pfnDestroyK(m_pk);
-                            pfnDestroyT(m_pt);
-                        }
-                    }
-
-					// key accessor
-					K *Pk() const
-					{
-						return m_pk;
-					}
+				K *m_pk;
+				T *m_pt;
+			};
 
-					// value accessor
-					T *Pt() const
-					{
-						return m_pt;
-					}
-					
-					// replace value
-					void ReplaceValue(T *ptNew)
-                    {
-                        if (m_fOwn)
-                        {
-                            pfnDestroyT(m_pt);
-                        }
-                        m_pt = ptNew;
-                    }
-
-					// equality operator -- map elements are equal if their keys match
-					BOOL operator == (const CHashMapElem &hme) const
-					{
-						return pfnEq(m_pk, hme.m_pk);
-					}
+			// slot of the open-addressing table
+			struct SSlot
+			{
+				// spread hash value of key
+				ULONG m_ulHash;
+
+				// index of entry plus one, zero if slot is empty
+				ULONG m_ulEntry;
 			};
 
 			// memory pool
 			IMemoryPool *const m_pmp;
 			
-			// size
+			// size hint, caps the number of entries allocated by first insertion
 			ULONG m_ulSize;
 		
 			// number of entries
 			ULONG m_ulEntries;
 
-			// each hash chain is an array of hashmap elements
-			typedef CDynamicPtrArray<CHashMapElem, CleanupDelete> DrgHashChain;
-			DrgHashChain **const m_ppdrgchain;
+			// number of entries that fit into the entry array
+			ULONG m_ulCapacity;
 
-			// array for keys
-			// We use CleanupNULL because the keys are owned by the hash table
-			typedef CDynamicPtrArray<K, CleanupNULL> DrgKeys;
-			DrgKeys *const m_pdrgKeys;
+			// entries in insertion order
+			SEntry *m_rgentry;
 
-			DrgPi *const m_pdrgPiFilledBuckets;
+			// number of slots, a power of two
+			ULONG m_ulSlots;
+
+			// slots
+			SSlot *m_rgslot;
 
 			// private copy ctor
 			CHashMap(const CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> &);
 			
-			// lookup appropriate hash chain in static table, may be NULL if
-			// no elements have been inserted yet
-			DrgHashChain **PpdrgChain(const K *pk) const
+			// spread hash value over all bits, since slots are chosen by the
+			// low bits and client hash functions may leave them constant
+			static
+			ULONG UlSpread
+				(
+				ULONG ulHash
+				)
+			{
+				ulHash ^= ulHash >> 16;
+				ulHash *= 0x85ebca6b;
+				ulHash ^= ulHash >> 13;
+				ulHash *= 0xc2b2ae35;
+				ulHash ^= ulHash >> 16;
+
+				return ulHash;
+			}
+
+			// distance of a slot from the home slot of given hash value
+			ULONG UlDistance
+				(
+				ULONG ulHash,
+				ULONG ulSlot
+				)
+				const
 			{
-				GPOS_ASSERT(NULL != m_ppdrgchain);
-				return &m_ppdrgchain[pfnHash(pk) % m_ulSize];
+				return (ulSlot - ulHash) & (m_ulSlots - 1);
+			}
+
+			// index of entry with given key, gpos::ulong_max if not found
+			ULONG UlLookup
+				(
+				const K *pk,
+				ULONG ulHash
+				)
+				const
+			{
+				if (0 == m_ulEntries)
+				{
+					return gpos::ulong_max;
+				}
+
+				const ULONG ulMask = m_ulSlots - 1;
+				ULONG ulSlot = ulHash & ulMask;
+				for (ULONG ulDist = 0; ; ulDist++)
+				{
+					const SSlot &slot = m_rgslot[ulSlot];
+
+					// key would have taken over any slot closer to its home
+					if (0 == slot.m_ulEntry || UlDistance(slot.m_ulHash, ulSlot) < ulDist)
+					{
+						return gpos::ulong_max;
+					}
+
+					if (ulHash == slot.m_ulHash && pfnEq(m_rgentry[slot.m_ulEntry - 1].m_pk, pk))
+					{
+						return slot.m_ulEntry - 1;
+					}
+
+					ulSlot = (ulSlot + 1) & ulMask;
+				}
+			}
+
+			// insert entry into slots, displacing entries closer to their home
+			void InsertSlot
+				(
+				ULONG ulHash,
+				ULONG ulEntry
+				)
+			{
+				SSlot slot;
+				slot.m_ulHash = ulHash;
+				slot.m_ulEntry = ulEntry + 1;
+
+				const ULONG ulMask = m_ulSlots - 1;
+				ULONG ulSlot = ulHash & ulMask;
+				for (ULONG ulDist = 0; ; ulDist++)
+				{
+					SSlot &slotCur = m_rgslot[ulSlot];
+					if (0 == slotCur.m_ulEntry)
+					{
+						slotCur = slot;
+						return;
+					}
+
+					const ULONG ulDistCur = UlDistance(slotCur.m_ulHash, ulSlot);
+					if (ulDistCur < ulDist)
+					{
+						std::swap(slot, slotCur);
+						ulDist = ulDistCur;
+					}
+
+					ulSlot = (ulSlot + 1) & ulMask;
+				}
+			}
+
+			// double entries and slots
+			void Grow()
+			{
+				const ULONG ulCapacity =
+					(0 == m_ulCapacity) ?
+					std::min(m_ulSize, (ULONG) GPOS_HASHMAP_INITIAL_ENTRIES) :
+					2 * m_ulCapacity;
+
+				ULONG ulSlots = 1;
+				while (ulSlots < 2 * ulCapacity)
+				{
+					ulSlots <<= 1;
+				}
+
+				CAutoRg<SEntry> a_rgentry;
+				a_rgentry = GPOS_NEW_ARRAY(m_pmp, SEntry, ulCapacity);
+				SSlot *rgslot = GPOS_NEW_ARRAY(m_pmp, SSlot, ulSlots);
+				(void) clib::PvMemSet(rgslot, 0, ulSlots * sizeof(SSlot));
+
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					a_rgentry[ul] = m_rgentry[ul];
+				}
+
+				SEntry *rgentryOld = m_rgentry;
+				SSlot *rgslotOld = m_rgslot;
+				const ULONG ulSlotsOld = m_ulSlots;
+
+				m_rgentry = a_rgentry.RgtReset();
+				m_ulCapacity = ulCapacity;
+				m_rgslot = rgslot;
+				m_ulSlots = ulSlots;
+
+				for (ULONG ul = 0; ul < ulSlotsOld; ul++)
+				{
+					if (0 != rgslotOld[ul].m_ulEntry)
+					{
+						InsertSlot(rgslotOld[ul].m_ulHash, rgslotOld[ul].m_ulEntry - 1);
+					}
+				}
+
+				GPOS_DELETE_ARRAY(rgentryOld);
+				GPOS_DELETE_ARRAY(rgslotOld);
 			}
 
 			// clear elements
 			void Clear()
-            {
-                for (ULONG i = 0; i < m_pdrgPiFilledBuckets->UlLength(); i++)
-                {
-                    // release each hash chain
-                    m_ppdrgchain[*(*m_pdrgPiFilledBuckets)[i]]->Release();
-                }
-                m_ulEntries = 0;
-                m_pdrgPiFilledBuckets->Clear();
-            }
-	
-			// lookup an element by its key
-			void Lookup(const K *pk, CHashMapElem **pphme) const
-            {
-                GPOS_ASSERT(NULL != pphme);
-
-                CHashMapElem hme(const_cast<K*>(pk), NULL /*T*/, false /*fOwn*/);
-                CHashMapElem *phme = NULL;
-                DrgHashChain **ppdrgchain = PpdrgChain(pk);
-                if (NULL != *ppdrgchain)
-                {
-                    phme = (*ppdrgchain)->PtLookup(&hme);
-                    GPOS_ASSERT_IMP(NULL != phme, *phme == hme);
-                }
-
-                *pphme = phme;
-            }
+			{
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					pfnDestroyK(m_rgentry[ul].m_pk);
+					pfnDestroyT(m_rgentry[ul].m_pt);
+				}
+
+				m_ulEntries = 0;
+				if (0 < m_ulSlots)
+				{
+					(void) clib::PvMemSet(m_rgslot, 0, m_ulSlots * sizeof(SSlot));
+				}
+			}
 
 		public:
 		
 			// ctor
 			CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> (IMemoryPool *pmp, ULONG ulSize = 128)
-            :
-            m_pmp(pmp),
-            m_ulSize(ulSize),
-            m_ulEntries(0),
-            m_ppdrgchain(GPOS_NEW_ARRAY(m_pmp, DrgHashChain*, m_ulSize)),
-            m_pdrgKeys(GPOS_NEW(m_pmp) DrgKeys(m_pmp)),
-            m_pdrgPiFilledBuckets(GPOS_NEW(pmp) DrgPi(pmp))
-            {
-                GPOS_ASSERT(ulSize > 0);
-                (void) clib::PvMemSet(m_ppdrgchain, 0, m_ulSize * sizeof(DrgHashChain*));
-            }
+			:
+			m_pmp(pmp),
+			m_ulSize(ulSize),
+			m_ulEntries(0),
+			m_ulCapacity(0),
+			m_rgentry(NULL),
+			m_ulSlots(0),
+			m_rgslot(NULL)
+			{
+				GPOS_ASSERT(ulSize > 0);
+			}
 
 			// dtor
 			~CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> ()
-            {
-                // release all hash chains
-                Clear();
+			{
+				// release all entries
+				Clear();
 
-                GPOS_DELETE_ARRAY(m_ppdrgchain);
-                m_pdrgKeys->Release();
-                m_pdrgPiFilledBuckets->Release();
-            }
+				GPOS_DELETE_ARRAY(m_rgentry);
+				GPOS_DELETE_ARRAY(m_rgslot);
+			}
 
 			// insert an element if key is not yet present
 			BOOL FInsert(K *pk, T *pt)
-            {
-                if (NULL != PtLookup(pk))
-                {
-                    return false;
-                }
+			{
+				GPOS_ASSERT(NULL != pk);
 
-                DrgHashChain **ppdrgchain = PpdrgChain(pk);
-                if (NULL == *ppdrgchain)
-                {
-                    *ppdrgchain = GPOS_NEW(m_pmp) DrgHashChain(m_pmp);
-                    INT iBucket = pfnHash(pk) % m_ulSize;
-                    m_pdrgPiFilledBuckets->Append(GPOS_NEW(m_pmp) INT(iBucket));
-                }
+				const ULONG ulHash = UlSpread(pfnHash(pk));
+				if (gpos::ulong_max != UlLookup(pk, ulHash))
+				{
+					return false;
+				}
 
-                CHashMapElem *phme = GPOS_NEW(m_pmp) CHashMapElem(pk, pt, true /*fOwn*/);
-                (*ppdrgchain)->Append(phme);
+				if (m_ulEntries == m_ulCapacity)
+				{
+					Grow();
+				}
 
-                m_ulEntries++;
+				m_rgentry[m_ulEntries].m_pk = pk;
+				m_rgentry[m_ulEntries].m_pt = pt;
+				InsertSlot(ulHash, m_ulEntries);
 
-                m_pdrgKeys->Append(pk);
+				m_ulEntries++;
 
-                return true;
-            }
+				return true;
+			}
 			
 			// lookup a value by its key
 			T *PtLookup(const K *pk) const
-            {
-                CHashMapElem *phme = NULL;
-                Lookup(pk, &phme);
-                if (NULL != phme)
-                {
-                    return phme->Pt();
-                }
+			{
+				const ULONG ulEntry = UlLookup(pk, UlSpread(pfnHash(pk)));
+				if (gpos::ulong_max != ulEntry)
+				{
+					return m_rgentry[ulEntry].m_pt;
+				}
 
-                return NULL;
-            }
+				return NULL;
+			}
 
 			// replace the value in a map entry with a new given value
 			BOOL FReplace(const K *pk, T *ptNew)
-            {
-                GPOS_ASSERT(NULL != pk);
+			{
+				GPOS_ASSERT(NULL != pk);
 
-                BOOL fSuccess = false;
-                CHashMapElem *phme = NULL;
-                Lookup(pk, &phme);
-                if (NULL != phme)
-                {
-                    phme->ReplaceValue(ptNew);
-                    fSuccess = true;
-                }
+				const ULONG ulEntry = UlLookup(pk, UlSpread(pfnHash(pk)));
+				if (gpos::ulong_max == ulEntry)
+				{
+					return false;
+				}
 
-                return fSuccess;
-            }
+				pfnDestroyT(m_rgentry[ulEntry].m_pt);
+				m_rgentry[ulEntry].m_pt = ptNew;
+
+				return true;
+			}
 
 			// return number of map entries
 			ULONG UlEntries() const
@@ -280,4 +351,3 @@ namespace gpos
 #endif // !GPOS_CHashMap_H
 
 // EOF
-
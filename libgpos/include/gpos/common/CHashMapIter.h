@@ -42,27 +42,18 @@ namespace gpos
 			// map to iterate
 			const TMap *m_ptm;
 
-			// current hashchain
-			ULONG m_ulChain;
-
-			// current key
+			// number of entries visited, the current one included
 			ULONG m_ulKey;
 
-			// is initialized?
-			BOOL m_fInit;
-
 			// private copy ctor
 			CHashMapIter(const CHashMapIter<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> &);
 			
-			// method to return the current element
-			const typename TMap::CHashMapElem *Phme() const
-            {
-                typename TMap::CHashMapElem *phme = NULL;
-                K *k = (*(m_ptm->m_pdrgKeys))[m_ulKey-1];
-                m_ptm->Lookup(k, &phme);
-
-                return phme;
-            }
+			// current entry
+			const typename TMap::SEntry &Entry() const
+			{
+				GPOS_ASSERT(0 < m_ulKey && "iterator uninitialized");
+				return m_ptm->m_rgentry[m_ulKey - 1];
+			}
 
 		public:
 		
@@ -70,7 +61,6 @@ namespace gpos
 			CHashMapIter<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> (TMap *ptm)
             :
             m_ptm(ptm),
-            m_ulChain(0),
             m_ulKey(0)
             {
                 GPOS_ASSERT(NULL != ptm);
@@ -81,39 +71,30 @@ namespace gpos
 			~CHashMapIter<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> ()
 			{}
 
-			// advance iterator to next element
+			// advance iterator to next element; entries are visited in
+			// insertion order
 			BOOL FAdvance()
-            {
-                if (m_ulKey < m_ptm->m_pdrgKeys->UlLength())
-                {
-                    m_ulKey++;
-                    return true;
-                }
-
-                return false;
-            }
+			{
+				if (m_ulKey < m_ptm->m_ulEntries)
+				{
+					m_ulKey++;
+					return true;
+				}
+
+				return false;
+			}
 			
 			// current key
 			const K *Pk() const
-            {
-                const typename TMap::CHashMapElem *phme = Phme();
-                if (NULL != phme)
-                {
-                    return phme->Pk();
-                }
-                return NULL;
-            }
+			{
+				return Entry().m_pk;
+			}
 
 			// current value
 			const T *Pt() const
-            {
-                const typename TMap::CHashMapElem *phme = Phme();
-                if (NULL != phme)
-                {
-                    return phme->Pt();
-                }
-                return NULL;
-            }
+			{
+				return Entry().m_pt;
+			}
 
 	}; // class CHashMapIter
 
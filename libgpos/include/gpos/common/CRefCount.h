@@ -29,6 +29,9 @@
 #define GPOS_WIPED_MEM_PATTERN		0xCcCcCcCcCcCcCcCc
 #endif
 
+// bit of the reference counter marking objects counted without atomic operations
+#define GPOS_REFCOUNT_SINGLE_THREADED	(((ULONG_PTR) 1) << (sizeof(ULONG_PTR) * 8 - 1))
+
 namespace gpos
 {
 	//---------------------------------------------------------------------------
@@ -43,7 +46,9 @@ namespace gpos
 	{
 		private:
 		
-			// reference counter -- first in class to be in sync with Check()
+			// reference counter -- first in class to be in sync with Check();
+			// the highest bit marks objects only referenced by a single
+			// thread, which are counted without atomic operations
 			volatile ULONG_PTR m_ulpRefs;
 			
 #ifdef GPOS_DEBUG
@@ -66,6 +71,17 @@ namespace gpos
 				m_ulpRefs(1)
 			{}
 
+			// ctor of an object whose owner knows whether it is shared
+			// between threads
+			explicit
+			CRefCount
+				(
+				BOOL fSingleThreaded
+				)
+				:
+				m_ulpRefs(fSingleThreaded ? (1 | GPOS_REFCOUNT_SINGLE_THREADED) : 1)
+			{}
+
 			// dtor
 			virtual ~CRefCount()
 			{
@@ -73,13 +89,28 @@ namespace gpos
 				// e.g., a ctor has thrown
 				GPOS_ASSERT(NULL == ITask::PtskSelf() ||
 							ITask::PtskSelf()->FPendingExc() ||
-							0 == m_ulpRefs);
+							0 == UlpRefCount());
 			}
 
 			// return ref-count
 			ULONG_PTR UlpRefCount() const
 			{
-				return m_ulpRefs;
+				return m_ulpRefs & ~GPOS_REFCOUNT_SINGLE_THREADED;
+			}
+
+			// is ref-count maintained without atomic operations
+			BOOL FSingleThreaded() const
+			{
+				return 0 != (m_ulpRefs & GPOS_REFCOUNT_SINGLE_THREADED);
+			}
+
+			// count without atomic operations from now on; the caller must
+			// hold the only reference, and no other thread may reach the object
+			void SetSingleThreaded()
+			{
+				GPOS_ASSERT(1 == UlpRefCount());
+
+				m_ulpRefs |= GPOS_REFCOUNT_SINGLE_THREADED;
 			}
 
 			// return true if calling object's destructor is allowed
@@ -95,7 +126,14 @@ namespace gpos
 #ifdef GPOS_DEBUG
 				Check();
 #endif // GPOS_DEBUG				
-				(void) UlpExchangeAdd(&m_ulpRefs, 1);
+				if (FSingleThreaded())
+				{
+					m_ulpRefs++;
+				}
+				else
+				{
+					(void) UlpExchangeAdd(&m_ulpRefs, 1);
+				}
 			}
 
 			// count down
@@ -104,7 +142,17 @@ namespace gpos
 #ifdef GPOS_DEBUG	
 				Check();
 #endif // GPOS_DEBUG
-				if (1 == UlpExchangeAdd(&m_ulpRefs, -1))
+				ULONG_PTR ulpRefs = 0;
+				if (FSingleThreaded())
+				{
+					ulpRefs = m_ulpRefs--;
+				}
+				else
+				{
+					ulpRefs = UlpExchangeAdd(&m_ulpRefs, -1);
+				}
+
+				if (1 == (ulpRefs & ~GPOS_REFCOUNT_SINGLE_THREADED))
 				{
 					// the following check is not thread-safe -- we intentionally allow this to capture
 					// the exceptional case where ref-count wrongly reaching zero
@@ -133,6 +181,20 @@ namespace gpos
 					prc->Release();
 				}
 			}
+
+			// count given object without atomic operations if the caller
+			// holds its only reference -- handles NULL pointers
+			static
+			void SafeSetSingleThreaded
+				(
+				CRefCount *prc
+				)
+			{
+				if (NULL != prc && 1 == prc->UlpRefCount())
+				{
+					prc->SetSingleThreaded();
+				}
+			}
 	
 	}; // class CRefCount
 }
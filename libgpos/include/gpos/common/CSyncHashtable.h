@@ -6,27 +6,34 @@
 //		CSyncHashtable.h
 //
 //	@doc:
-//		Allocation-less static hashtable; 
+//		Allocation-less sharded hashtable;
 //		Manages client objects without additional allocations; this is a
 //		requirement for system programming tasks to ensure the hashtable
 //		works in exception situations, e.g. OOM;
 //
-//		1)	Hashtable is static and cannot resize during operations;
-//		2)	expects target type to have SLink (see CList.h) and Key
+//		1)	each bucket requested at initialization becomes a shard with
+//			its own spinlock and hash chains, sitting on its own cache line;
+//		2)	a resizable hashtable doubles the hash chains of a shard once
+//			they get too long; growth runs after the shard's spinlock is
+//			released and is skipped if allocation fails or the table is
+//			being iterated, so the table never fails for lack of memory;
+//		3)	expects target type to have SLink (see CList.h) and Key
 //			members with appopriate accessors;
-//		3)	clients must provide their own hash function;
-//		4)	hashtable synchronizes through spinlocks on each bucket;
+//		4)	clients must provide their own hash function;
+//		5)	hashtable synchronizes through spinlocks on each shard;
 //---------------------------------------------------------------------------
 #ifndef GPOS_CSyncHashtable_H
 #define GPOS_CSyncHashtable_H
 
 #include "gpos/base.h"
 
-#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CList.h"
 #include "gpos/sync/CAutoSpinlock.h"
 #include "gpos/task/CAutoSuspendAbort.h"
 
+// average chain length above which a shard of a resizable hashtable grows
+#define GPOS_SHT_LOAD_FACTOR	2
+
 namespace gpos
 {
 
@@ -48,7 +55,12 @@ namespace gpos
 	//		CSyncHashtable<T, K, S>
 	//
 	//	@doc:
-	//		Allocation-less static hash table;
+	//		Allocation-less sharded hash table;
+	//
+	//		A key's hash value selects its shard and, within the shard, its
+	//		bucket; since a key never moves to another shard, holding the
+	//		shard's spinlock is sufficient to access the key's bucket even
+	//		while other shards grow.
 	//
 	//		Ideally the offset of the key would be a template parameter too in order
 	//		to avoid accidental tampering with this value -- not all compiler allow 
@@ -66,41 +78,66 @@ namespace gpos
 
 		private:
 	
-			// hash bucket is a pair of list, spinlock
-			struct SBucket
+			// shard is a spinlock and the bucket array it protects
+			struct SShard
 			{
 				private:
 			
 					// no copy ctor
-					SBucket(const SBucket &);
+					SShard(const SShard &);
 
 				public:
 			
 					// ctor
-					SBucket() {};
+					SShard() {};
 				
-					// spinlock to protect bucket
+					// spinlock to protect shard
 					S m_slock;
 				
-					// hash chain
-					CList<T> m_list;
+					// hash chains
+					CList<T> *m_rglist;
+
+					// hash chain of the shard until it grows
+					CList<T> m_listInitial;
 
-#ifdef GPOS_DEBUG
-					// bucket number
-					ULONG m_ulBucket;
-#endif // GPOS_DEBUG
+					// number of buckets
+					ULONG m_cSize;
 
+					// number of entries
+					ULONG m_ulEntries;
+
+					// allocation holding the hash chains if the shard has
+					// grown, NULL before
+					void *m_pvGrown;
 			};
 
-			// range of buckets
-			SBucket *m_rgbucket;
-		
-			// number of ht buckets
-			ULONG m_cSize;
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// allocation holding the shards
+			void *m_pvShards;
+
+			// cache-line aligned range of shards
+			BYTE *m_pbShards;
+
+			// distance between two shards, a multiple of the cache line size
+			ULONG m_ulShardStride;
+
+			// number of shards
+			ULONG m_cShards;
 
 			// number of ht entries
 			volatile ULONG_PTR m_ulpEntries;
+
+			// number of active iterators; shards do not grow while non-zero
+			volatile ULONG_PTR m_ulpIters;
+
+			// do shards grow with the number of entries
+			BOOL m_fResizable;
 		
+			// offset of link
+			ULONG m_cLinkOffset;
+
 			// offset of key
 			ULONG m_cKeyOffset;
 
@@ -112,9 +149,9 @@ namespace gpos
 
 			// pointer to key equality function
 			BOOL (*m_pfuncEqual)(const K&, const K&);
-				
-			// function to compute bucket index for key
-			ULONG UlBucketIndex
+
+			// hash value of key
+			ULONG UlHash
 				(
 				const K &key
 				)
@@ -122,19 +159,40 @@ namespace gpos
 			{
 				GPOS_ASSERT(FValid(key) && "Invalid key is inaccessible");
 
-				return m_pfuncHash(key) % m_cSize;
+				return m_pfuncHash(key);
 			}
 
-			// function to get bucket by index
-			SBucket &Bucket
+			// function to compute shard index for hash value
+			ULONG UlShardIndex
+				(
+				ULONG ulHash
+				)
+				const
+			{
+				return ulHash % m_cShards;
+			}
+
+			// function to compute bucket index within shard for hash value
+			ULONG UlBucketIndex
+				(
+				ULONG ulHash,
+				ULONG cSize
+				)
+				const
+			{
+				return (ulHash / m_cShards) % cSize;
+			}
+
+			// function to get shard by index
+			SShard &Shard
 				(
 				const ULONG ulIndex
 				)
 				const
 			{
-				GPOS_ASSERT(ulIndex < m_cSize && "Invalid bucket index");
+				GPOS_ASSERT(ulIndex < m_cShards && "Invalid shard index");
 
-				return m_rgbucket[ulIndex];
+				return *reinterpret_cast<SShard*>(m_pbShards + ulIndex * m_ulShardStride);
 			}
 
 			// extract key out of type
@@ -162,6 +220,122 @@ namespace gpos
 				return !m_pfuncEqual(key, *m_pkeyInvalid);
 			}
 
+			// allocate memory aligned to a cache line; return NULL
+			// if the memory could not be allocated
+			BYTE *PbAllocAligned
+				(
+				ULONG ulBytes,
+				void **ppvAlloc
+				)
+				const
+			{
+				void *pv = m_pmp->PvAllocate(ulBytes + GPOS_CACHE_LINE_SIZE - 1, __FILE__, __LINE__);
+				*ppvAlloc = pv;
+				if (NULL == pv)
+				{
+					return NULL;
+				}
+
+				ULONG_PTR ulp = (ULONG_PTR) pv + GPOS_CACHE_LINE_SIZE - 1;
+				return (BYTE *) (ulp - ulp % GPOS_CACHE_LINE_SIZE);
+			}
+
+			// initialize a range of empty hash chains
+			void InitBuckets
+				(
+				BYTE *pb,
+				ULONG cSize
+				)
+				const
+			{
+				CList<T> *rglist = reinterpret_cast<CList<T>*>(pb);
+				for (ULONG ul = 0; ul < cSize; ul++)
+				{
+					new(rglist + ul) CList<T>();
+					rglist[ul].Init(m_cLinkOffset);
+				}
+			}
+
+			// check if shard has outgrown its buckets
+			BOOL FOverloaded
+				(
+				const SShard &shard
+				)
+				const
+			{
+				return m_fResizable && shard.m_ulEntries / GPOS_SHT_LOAD_FACTOR > shard.m_cSize;
+			}
+
+			// double the buckets of a shard if it is still overloaded;
+			// growth allocates, hence it must be called without holding
+			// any spinlock, including the shard's
+			void Grow
+				(
+				SShard &shard
+				)
+			{
+				GPOS_ASSERT_NO_SPINLOCK;
+
+				if (0 != m_ulpIters)
+				{
+					return;
+				}
+
+				// growth may happen while unwinding, do not react to aborts
+				CAutoSuspendAbort asa;
+
+				const ULONG cSize = shard.m_cSize;
+				const ULONG cSizeNew = 2 * cSize;
+
+				void *pvGrown = NULL;
+				BYTE *pb = PbAllocAligned(cSizeNew * GPOS_SIZEOF(CList<T>), &pvGrown);
+				if (NULL == pb)
+				{
+					// keep operating with longer chains
+					return;
+				}
+				InitBuckets(pb, cSizeNew);
+
+				// memory to release after growing, the new buckets if
+				// another thread got ahead of us
+				void *pvFree = pvGrown;
+
+				// scope for spinlock
+				{
+					CAutoSpinlock alock(shard.m_slock);
+					alock.Lock();
+
+					if (cSize == shard.m_cSize && FOverloaded(shard) && 0 == m_ulpIters)
+					{
+						CList<T> *rglist = reinterpret_cast<CList<T>*>(pb);
+
+						// move entries while preserving their order within a chain
+						for (ULONG ul = 0; ul < cSize; ul++)
+						{
+							CList<T> &list = shard.m_rglist[ul];
+
+							T *pt = NULL;
+							while (NULL != (pt = list.PtFirst()))
+							{
+								list.Remove(pt);
+								rglist[UlBucketIndex(UlHash(Key(pt)), cSizeNew)].Append(pt);
+							}
+						}
+
+						pvFree = shard.m_pvGrown;
+
+						shard.m_rglist = rglist;
+						shard.m_cSize = cSizeNew;
+						shard.m_pvGrown = pvGrown;
+					}
+				}
+
+				if (NULL != pvFree)
+				{
+					m_pmp->Free(pvFree);
+				}
+			}
+
 		public:
 	
 			// type definition of function used to cleanup element
@@ -170,9 +344,15 @@ namespace gpos
 			// ctor
 			CSyncHashtable<T, K, S>()
 				:
-				m_rgbucket(NULL),
-				m_cSize(0),
+				m_pmp(NULL),
+				m_pvShards(NULL),
+				m_pbShards(NULL),
+				m_ulShardStride(0),
+				m_cShards(0),
 				m_ulpEntries(0),
+				m_ulpIters(0),
+				m_fResizable(false),
+				m_cLinkOffset(gpos::ulong_max),
 				m_cKeyOffset(gpos::ulong_max),
 				m_pkeyInvalid(NULL)
 			{}
@@ -185,7 +365,10 @@ namespace gpos
                 Cleanup();
             }
 		
-			// Initialization of hashtable
+			// Initialization of hashtable; the table starts with cSize
+			// buckets, each protected by its own spinlock; a resizable table
+			// adds buckets as needed, other tables never allocate after
+			// initialization
 			void Init
 				(
 				IMemoryPool *pmp,
@@ -194,49 +377,67 @@ namespace gpos
 				ULONG cKeyOffset,
 				const K *pkeyInvalid,
 				ULONG (*pfuncHash)(const K&),
-				BOOL (*pfuncEqual)(const K&, const K&)
+				BOOL (*pfuncEqual)(const K&, const K&),
+				BOOL fResizable = true
 				)
             {
-                GPOS_ASSERT(NULL == m_rgbucket);
-                GPOS_ASSERT(0 == m_cSize);
+                GPOS_ASSERT(NULL == m_pbShards);
+                GPOS_ASSERT(0 == m_cShards);
+                GPOS_ASSERT(0 < cSize);
                 GPOS_ASSERT(NULL != pkeyInvalid);
                 GPOS_ASSERT(NULL != pfuncHash);
                 GPOS_ASSERT(NULL != pfuncEqual);
 
-                m_cSize = cSize;
+                m_pmp = pmp;
+                m_cLinkOffset = cLinkOffset;
                 m_cKeyOffset = cKeyOffset;
                 m_pkeyInvalid = pkeyInvalid;
                 m_pfuncHash = pfuncHash;
                 m_pfuncEqual = pfuncEqual;
+                m_fResizable = fResizable;
 
-                m_rgbucket = GPOS_NEW_ARRAY(pmp, SBucket, m_cSize);
+                m_ulShardStride = GPOS_CACHE_LINE_SIZE *
+                    ((GPOS_SIZEOF(SShard) + GPOS_CACHE_LINE_SIZE - 1) / GPOS_CACHE_LINE_SIZE);
 
-                // NOTE: 03/25/2008; since it's the only allocation in the
-                //		constructor the protection is not needed strictly speaking;
-                //		Using auto range here just for cleanliness;
-                CAutoRg<SBucket> argbucket;
-                argbucket = m_rgbucket;
+                m_pbShards = PbAllocAligned(cSize * m_ulShardStride, &m_pvShards);
+                GPOS_OOM_CHECK(m_pbShards);
 
-                for(ULONG i = 0; i < m_cSize; i ++)
+                m_cShards = cSize;
+                for (ULONG ul = 0; ul < m_cShards; ul++)
                 {
-                    m_rgbucket[i].m_list.Init(cLinkOffset);
-    #ifdef GPOS_DEBUG
-                    // add serial number
-                    m_rgbucket[i].m_ulBucket = i;
-    #endif // GPOS_DEBUG
+                    SShard *pshard = new(&Shard(ul)) SShard();
+                    pshard->m_listInitial.Init(m_cLinkOffset);
+                    pshard->m_rglist = &pshard->m_listInitial;
+                    pshard->m_cSize = 1;
+                    pshard->m_ulEntries = 0;
+                    pshard->m_pvGrown = NULL;
                 }
-
-                // unhook from protector
-                argbucket.RgtReset();
             }
 
-			// dealloc bucket range and reset members
+			// dealloc shards and reset members
 			void Cleanup()
             {
-                GPOS_DELETE_ARRAY(m_rgbucket);
-                m_rgbucket = NULL;
+                GPOS_ASSERT(0 == m_ulpIters);
+
+                for (ULONG ul = 0; ul < m_cShards; ul++)
+                {
+                    SShard &shard = Shard(ul);
+                    if (NULL != shard.m_pvGrown)
+                    {
+                        m_pmp->Free(shard.m_pvGrown);
+                    }
+
+                    shard.~SShard();
+                }
 
-                m_cSize = 0;
+                if (NULL != m_pvShards)
+                {
+                    m_pmp->Free(m_pvShards);
+                }
+
+                m_pvShards = NULL;
+                m_pbShards = NULL;
+                m_cShards = 0;
             }
 
 			// iterate over all entries and call destroy function on each entry
@@ -280,18 +481,29 @@ namespace gpos
 
                 GPOS_ASSERT(FValid(key));
 
-                // determine target bucket
-                SBucket &bucket = Bucket(UlBucketIndex(key));
+                // determine target shard
+                const ULONG ulHash = UlHash(key);
+                SShard &shard = Shard(UlShardIndex(ulHash));
+                BOOL fOverloaded = false;
 
-                // acquire auto spinlock
-                CAutoSpinlock alock(bucket.m_slock);
-                alock.Lock();
+                // scope for spinlock
+                {
+                    CAutoSpinlock alock(shard.m_slock);
+                    alock.Lock();
 
-                // inserting at bucket's head is required by hashtable iteration
-                bucket.m_list.Prepend(pt);
+                    // inserting at bucket's head is required by hashtable iteration
+                    shard.m_rglist[UlBucketIndex(ulHash, shard.m_cSize)].Prepend(pt);
+                    shard.m_ulEntries++;
+                    fOverloaded = FOverloaded(shard);
+                }
 
                 // increase number of entries
                 (void) UlpExchangeAdd(&m_ulpEntries, 1);
+
+                if (fOverloaded)
+                {
+                    Grow(shard);
+                }
             }
 
 			// return number of entries
@@ -300,6 +512,18 @@ namespace gpos
 				return m_ulpEntries;
 			}
 
+			// return number of buckets; may be stale while shards grow
+			ULONG UlBuckets() const
+			{
+				ULONG cSize = 0;
+				for (ULONG ul = 0; ul < m_cShards; ul++)
+				{
+					cSize += Shard(ul).m_cSize;
+				}
+
+				return cSize;
+			}
+
 	}; // class CSyncHashtable
 
 }
@@ -307,4 +531,3 @@ namespace gpos
 #endif // !GPOS_CSyncHashtable_H
 
 // EOF
-
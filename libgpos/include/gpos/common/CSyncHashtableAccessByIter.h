@@ -70,7 +70,7 @@ namespace gpos
 			CSyncHashtableAccessByIter<T, K, S>
 				(CSyncHashtableIter<T, K, S> &iter)
             :
-            Base(iter.m_ht, iter.m_ulBucketIndex),
+            Base(iter.m_ht, iter.m_ulShardIndex, iter.m_ulBucketIndex),
             m_iter(iter)
             {
             }
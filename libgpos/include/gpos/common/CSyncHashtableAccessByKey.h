@@ -6,9 +6,9 @@
 //		CSyncHashtableAccessByKey.h
 //
 //	@doc:
-//		Accessor for allocation-less static hashtable;
+//		Accessor for allocation-less sharded hashtable;
 //		The Accessor is instantiated with a target key. Throughout its life
-//		time, the accessor holds the spinlock on the target key's bucket --
+//		time, the accessor holds the spinlock on the target key's shard --
 //		regardless of whether or not the key exists in the hashtable; this 
 //		allows clients to implement more complex functionality than simple
 //		test-and-insert/remove functions; acquiring and releasing locks is
@@ -29,7 +29,7 @@ namespace gpos
 	//		CSyncHashtableAccessByKey<T, K, S>
 	//
 	//	@doc:
-	//		Accessor class to encapsulate locking of a hashtable bucket based on
+	//		Accessor class to encapsulate locking of a hashtable shard based on
 	//		a passed key; has to know all template parameters of the hashtable
 	//		class in order to link to the target hashtable; see file doc for more
 	//		details on the rationale behind this class
@@ -70,19 +70,20 @@ namespace gpos
 			// returns true if current bucket matches key
 			BOOL FMatchingBucket(const K &key) const
             {
-                ULONG ulBucketIndex = Base::Sht().UlBucketIndex(key);
+                ULONG ulHash = Base::Sht().UlHash(key);
 
-                return &(Base::Sht().Bucket(ulBucketIndex)) == &(Base::Bucket());
+                return &(Base::Sht().Shard(Base::Sht().UlShardIndex(ulHash))) == &(Base::Shard()) &&
+                       &(Base::Shard().m_rglist[Base::Sht().UlBucketIndex(ulHash, Base::UlBuckets())]) == &(Base::Bucket());
             }
 #endif // GPOS_DEBUG
 
 		public:
 	
-			// ctor - acquires spinlock on target bucket
+			// ctor - acquires spinlock on target bucket's shard
 			CSyncHashtableAccessByKey<T, K, S>
 				(CSyncHashtable<T, K, S> &ht, const K &key)
             :
-            Base(ht, ht.UlBucketIndex(key)),
+            Base(ht, ht.UlHash(key)),
             m_key(key)
             {
             }
@@ -9,9 +9,9 @@
 //		Base hashtable accessor class; provides primitives to operate
 //		on a target bucket in the hashtable.
 //
-//		Throughout its life time, the accessor holds the spinlock on a
-//		target bucket; this allows clients to implement more complex
-//		functionality than simple test-and-insert/remove functions.
+//		Throughout its life time, the accessor holds the spinlock on the
+//		shard of a target bucket; this allows clients to implement more
+//		complex functionality than simple test-and-insert/remove functions.
 //
 //---------------------------------------------------------------------------
 #ifndef GPOS_CSyncHashtableAccessorBase_H_
@@ -31,7 +31,7 @@ namespace gpos
 	//		CSyncHashtableAccessorBase<T, K, S>
 	//
 	//	@doc:
-	//		Accessor class to encapsulate locking of a hashtable bucket;
+	//		Accessor class to encapsulate locking of a hashtable shard;
 	//		has to know all template parameters of the hashtable class in order
 	//		to link to the target hashtable; see file doc for more details on the
 	//		rationale behind this class
@@ -43,41 +43,90 @@ namespace gpos
 
 		private:
 
-			// shorthand for buckets
-			typedef struct CSyncHashtable<T, K, S>::SBucket SBucket;
+			// shorthand for shards
+			typedef struct CSyncHashtable<T, K, S>::SShard SShard;
 
 			// target hashtable
 			CSyncHashtable<T, K, S> &m_ht;
 
+			// shard to operate on
+			SShard &m_shard;
+
 			// bucket to operate on
-			SBucket &m_bucket;
+			CList<T> *m_plist;
+
+			// set when the shard has outgrown its buckets
+			BOOL m_fOverloaded;
 
 			// no copy ctor
 			CSyncHashtableAccessorBase<T, K, S>
 				(const CSyncHashtableAccessorBase<T, K, S>&);
 
+			// count an added element
+			void AddEntry()
+            {
+                m_shard.m_ulEntries++;
+                m_fOverloaded = m_ht.FOverloaded(m_shard);
+
+                // increase number of entries
+                (void) UlpExchangeAdd(&(m_ht.m_ulpEntries), 1);
+            }
+
 		protected:
 
-			// ctor - protected to restrict instantiation to children
+			// ctor - protected to restrict instantiation to children;
+			// accesses the bucket of given hash value
+			CSyncHashtableAccessorBase<T, K, S>
+				(
+				CSyncHashtable<T, K, S> &ht,
+				ULONG ulHash
+				)
+            :
+            m_ht(ht),
+            m_shard(m_ht.Shard(m_ht.UlShardIndex(ulHash))),
+            m_plist(NULL),
+            m_fOverloaded(false)
+            {
+                // acquire spin lock on shard
+                m_shard.m_slock.Lock();
+
+                // shard cannot grow while we hold its lock
+                m_plist = &m_shard.m_rglist[m_ht.UlBucketIndex(ulHash, m_shard.m_cSize)];
+            }
+
+			// ctor - protected to restrict instantiation to children;
+			// accesses a bucket of given shard by position; positions beyond
+			// the shard's bucket count wrap around
 			CSyncHashtableAccessorBase<T, K, S>
 				(
 				CSyncHashtable<T, K, S> &ht,
+				ULONG ulShardIndex,
 				ULONG ulBucketIndex
 				)
             :
             m_ht(ht),
-            m_bucket(m_ht.Bucket(ulBucketIndex))
+            m_shard(m_ht.Shard(ulShardIndex)),
+            m_plist(NULL),
+            m_fOverloaded(false)
             {
-                // acquire spin lock on bucket
-                m_bucket.m_slock.Lock();
+                // acquire spin lock on shard
+                m_shard.m_slock.Lock();
+
+                m_plist = &m_shard.m_rglist[ulBucketIndex % m_shard.m_cSize];
             }
 
 			// dtor
 			virtual
 			~CSyncHashtableAccessorBase<T, K, S>()
             {
-                // unlock bucket
-                m_bucket.m_slock.Unlock();
+                // unlock shard
+                m_shard.m_slock.Unlock();
+
+                // growing allocates and must be done without holding the lock
+                if (m_fOverloaded)
+                {
+                    m_ht.Grow(m_shard);
+                }
             }
 
 			// accessor to hashtable
@@ -86,16 +135,28 @@ namespace gpos
 				return m_ht;
 			}
 
+			// accessor to maintained shard
+			SShard& Shard() const
+			{
+				return m_shard;
+			}
+
 			// accessor to maintained bucket
-			SBucket& Bucket() const
+			CList<T>& Bucket() const
 			{
-				return m_bucket;
+				return *m_plist;
+			}
+
+			// number of buckets in maintained shard
+			ULONG UlBuckets() const
+			{
+				return m_shard.m_cSize;
 			}
 
 			// returns the first element in the hash chain
 			T *PtFirst() const
             {
-                return m_bucket.m_list.PtFirst();
+                return m_plist->PtFirst();
             }
 
 			// finds the element next to the given one
@@ -104,9 +165,9 @@ namespace gpos
                 GPOS_ASSERT(NULL != pt);
 
                 // make sure element is in this hash chain
-                GPOS_ASSERT(GPOS_OK == m_bucket.m_list.EresFind(pt));
+                GPOS_ASSERT(GPOS_OK == m_plist->EresFind(pt));
 
-                return m_bucket.m_list.PtNext(pt);
+                return m_plist->PtNext(pt);
             }
 
 			// inserts element at the head of hash chain
@@ -114,10 +175,8 @@ namespace gpos
             {
                 GPOS_ASSERT(NULL != pt);
 
-                m_bucket.m_list.Prepend(pt);
-
-                // increase number of entries
-                (void) UlpExchangeAdd(&(m_ht.m_ulpEntries), 1);
+                m_plist->Prepend(pt);
+                AddEntry();
             }
 
 			// adds first element before second element
@@ -126,12 +185,10 @@ namespace gpos
                 GPOS_ASSERT(NULL != pt);
 
                 // make sure element is in this hash chain
-                GPOS_ASSERT(GPOS_OK == m_bucket.m_list.EresFind(ptNext));
+                GPOS_ASSERT(GPOS_OK == m_plist->EresFind(ptNext));
 
-                m_bucket.m_list.Prepend(pt, ptNext);
-
-                // increase number of entries
-                (void) UlpExchangeAdd(&(m_ht.m_ulpEntries), 1);
+                m_plist->Prepend(pt, ptNext);
+                AddEntry();
             }
 
 			// adds first element after second element
@@ -140,12 +197,10 @@ namespace gpos
                 GPOS_ASSERT(NULL != pt);
 
                 // make sure element is in this hash chain
-                GPOS_ASSERT(GPOS_OK == m_bucket.m_list.EresFind(ptPrev));
-
-                m_bucket.m_list.Append(pt, ptPrev);
+                GPOS_ASSERT(GPOS_OK == m_plist->EresFind(ptPrev));
 
-                // increase number of entries
-                (void) UlpExchangeAdd(&(m_ht.m_ulpEntries), 1);
+                m_plist->Append(pt, ptPrev);
+                AddEntry();
             }
 
 		public:
@@ -154,7 +209,8 @@ namespace gpos
 			void Remove(T *pt)
             {
                 // not NULL and is-list-member checks are done in CList
-                m_bucket.m_list.Remove(pt);
+                m_plist->Remove(pt);
+                m_shard.m_ulEntries--;
 
                 // decrease number of entries
                 (void) UlpExchangeAdd(&(m_ht.m_ulpEntries), -1);
@@ -6,7 +6,7 @@
 //		CSyncHashtableIter.h
 //
 //	@doc:
-//		Iterator for allocation-less static hashtable; this class encapsulates
+//		Iterator for allocation-less sharded hashtable; this class encapsulates
 //		the state of iteration process (the current bucket we iterate through
 //		and iterator position); it also allows advancing iterator's position
 //		in the hash table; accessing the element at current iterator's
@@ -56,7 +56,10 @@ namespace gpos
 			// target hashtable
 			CSyncHashtable<T, K, S> &m_ht;
 
-			// index of bucket to operate on
+			// index of shard to operate on
+			ULONG m_ulShardIndex;
+
+			// index of bucket within shard to operate on
 			ULONG m_ulBucketIndex;
 
 			// a slab of memory to manufacture an invalid element; we enforce
@@ -73,10 +76,19 @@ namespace gpos
 			void InsertInvalidElement()
             {
                 m_fInvalidInserted = false;
-                while (m_ulBucketIndex < m_ht.m_cSize)
+                while (m_ulShardIndex < m_ht.m_cShards)
                 {
                     CSyncHashtableAccessByIter<T, K, S> shtitacc(*this);
 
+                    // shards do not grow while we iterate
+                    if (m_ulBucketIndex >= shtitacc.UlBuckets())
+                    {
+                        // shard is exhausted, move on to the next one
+                        m_ulShardIndex++;
+                        m_ulBucketIndex = 0;
+                        continue;
+                    }
+
                     T *ptFirst = shtitacc.PtFirst();
                     T *ptFirstValid = NULL;
 
@@ -124,10 +136,15 @@ namespace gpos
 			CSyncHashtableIter<T, K, S>(CSyncHashtable<T, K, S> &ht)
             :
             m_ht(ht),
+            m_ulShardIndex(0),
             m_ulBucketIndex(0),
             m_ptInvalid(NULL),
             m_fInvalidInserted(false)
             {
+                // prevent shards from growing, which would move elements
+                // across buckets
+                (void) UlpExchangeAdd(&(m_ht.m_ulpIters), 1);
+
                 m_ptInvalid = (T*)m_rgInvalid;
 
                 // get a reference to invalid element's key
@@ -151,12 +168,14 @@ namespace gpos
                     CSyncHashtableAccessByIter<T, K, S> shtitacc(*this);
                     shtitacc.Remove(m_ptInvalid);
                 }
+
+                (void) UlpExchangeAdd(&(m_ht.m_ulpIters), -1);
             }
 
 			// advances iterator
 			BOOL FAdvance()
             {
-                GPOS_ASSERT(m_ulBucketIndex < m_ht.m_cSize &&
+                GPOS_ASSERT(m_ulShardIndex < m_ht.m_cShards &&
                             "Advancing an exhausted iterator");
 
                 if (!m_fInvalidInserted)
@@ -178,16 +197,17 @@ namespace gpos
                     }
                 }
 
-                return (m_ulBucketIndex < m_ht.m_cSize);
+                return (m_ulShardIndex < m_ht.m_cShards);
             }
 
 			// rewinds the iterator to the beginning
 			void RewindIterator()
             {
-                GPOS_ASSERT(m_ulBucketIndex >= m_ht.m_cSize &&
+                GPOS_ASSERT(m_ulShardIndex >= m_ht.m_cShards &&
                             "Rewinding an un-exhausted iterator");
                 GPOS_ASSERT(!m_fInvalidInserted && "Invalid element from previous iteration exists, cannot rewind");
 
+                m_ulShardIndex = 0;
                 m_ulBucketIndex = 0;
             }
 
@@ -0,0 +1,300 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSyncSegmentedArray.h
+//
+//	@doc:
+//		Template-based append-only array of pointers with lock-free append;
+//
+//		Elements are stored in segments of geometrically growing size, so
+//		iterating the array walks a handful of contiguous blocks instead of
+//		chasing one link per element; segments are never moved or freed
+//		before the array is destroyed, hence the address of a slot is stable;
+//
+//		Appending is thread safe and may run concurrently with iteration;
+//		an iterator may observe a NULL slot for an append in progress;
+//		appending may be split into reserving a slot, which allocates, and
+//		publishing the element, which does not; a reserved slot stays NULL
+//		if no element is published at it; the segment of the next slot may
+//		also be installed ahead, so that a later append does not allocate;
+//
+//		Removing an element clears its slot, which is not reused;
+//---------------------------------------------------------------------------
+#ifndef GPOS_CSyncSegmentedArray_H
+#define GPOS_CSyncSegmentedArray_H
+
+#include "gpos/base.h"
+#include "gpos/sync/atomic.h"
+
+// maximum number of segments; the array holds at most
+// 2^(ulFirstBits + GPOS_SEGMENTED_ARRAY_SEGMENTS) - 2^ulFirstBits elements
+#define GPOS_SEGMENTED_ARRAY_SEGMENTS	(32)
+
+// default number of bits of the size of the first segment
+#define GPOS_SEGMENTED_ARRAY_FIRST_BITS	(4)
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CSyncSegmentedArray<class T>
+	//
+	//	@doc:
+	//		Append-only array of pointers to T; segment i holds
+	//		2^(ulFirstBits + i) slots; elements are not owned by the array
+	//
+	//---------------------------------------------------------------------------
+	template<class T>
+	class CSyncSegmentedArray
+	{
+		private:
+
+			// memory pool for segments; must be thread safe if the
+			// array is appended to concurrently
+			IMemoryPool *m_pmp;
+
+			// number of bits of the size of the first segment
+			const ULONG m_ulFirstBits;
+
+			// segment directory; segments are installed on first use
+			T ** volatile m_rgppt[GPOS_SEGMENTED_ARRAY_SEGMENTS];
+
+			// number of reserved slots
+			volatile ULONG_PTR m_ulpSize;
+
+			// no copy ctor
+			CSyncSegmentedArray(const CSyncSegmentedArray&);
+
+			// back-off after too many attempts
+			void CheckBackOff(ULONG &ulAttempts) const
+			{
+				if (++ulAttempts == GPOS_SPIN_ATTEMPTS)
+				{
+					// back-off
+					clib::USleep(GPOS_SPIN_BACKOFF);
+
+					ulAttempts = 0;
+
+					GPOS_CHECK_ABORT;
+				}
+			}
+
+			// number of slots of given segment
+			ULONG_PTR UlpSegmentSize(ULONG ulSegment) const
+			{
+				return ((ULONG_PTR) 1) << (m_ulFirstBits + ulSegment);
+			}
+
+			// map position to segment and offset within the segment
+			void Locate
+				(
+				ULONG_PTR ulpPos,
+				ULONG *pulSegment,
+				ULONG_PTR *pulpOffset
+				)
+				const
+			{
+				// positions of segment i are [2^(f+i) - 2^f, 2^(f+i+1) - 2^f)
+				const ULONG_PTR ulpBiased = ulpPos + UlpSegmentSize(0);
+				ULONG ulBit = m_ulFirstBits;
+				while (0 != (ulpBiased >> (ulBit + 1)))
+				{
+					ulBit++;
+				}
+
+				*pulSegment = ulBit - m_ulFirstBits;
+				*pulpOffset = ulpBiased - (((ULONG_PTR) 1) << ulBit);
+			}
+
+			// install given segment unless another thread did so already
+			void EnsureSegment
+				(
+				ULONG ulSegment
+				)
+			{
+				GPOS_ASSERT(GPOS_SEGMENTED_ARRAY_SEGMENTS > ulSegment);
+
+				if (NULL != m_rgppt[ulSegment])
+				{
+					return;
+				}
+
+				const ULONG_PTR ulpSlots = UlpSegmentSize(ulSegment);
+				T **ppt = GPOS_NEW_ARRAY(m_pmp, T*, ulpSlots);
+				(void) clib::PvMemSet(ppt, 0, ulpSlots * sizeof(T*));
+
+				if (!FCompareSwap<T*>((T* volatile **) &m_rgppt[ulSegment], NULL, ppt))
+				{
+					// another thread installed the segment first
+					GPOS_DELETE_ARRAY(ppt);
+				}
+			}
+
+		public:
+
+			// ctor
+			CSyncSegmentedArray
+				(
+				IMemoryPool *pmp,
+				ULONG ulFirstBits = GPOS_SEGMENTED_ARRAY_FIRST_BITS
+				)
+				:
+				m_pmp(pmp),
+				m_ulFirstBits(ulFirstBits),
+				m_ulpSize(0)
+			{
+				GPOS_ASSERT(NULL != pmp);
+				GPOS_ASSERT(ulFirstBits + GPOS_SEGMENTED_ARRAY_SEGMENTS <= sizeof(ULONG_PTR) * 8);
+
+				for (ULONG ul = 0; ul < GPOS_SEGMENTED_ARRAY_SEGMENTS; ul++)
+				{
+					m_rgppt[ul] = NULL;
+				}
+			}
+
+			// dtor
+			~CSyncSegmentedArray()
+			{
+				for (ULONG ul = 0; ul < GPOS_SEGMENTED_ARRAY_SEGMENTS; ul++)
+				{
+					GPOS_DELETE_ARRAY(m_rgppt[ul]);
+				}
+			}
+
+			// reserve a slot, return its position; the slot is NULL until
+			// an element is published at it
+			ULONG_PTR UlpReserve()
+			{
+				ULONG ulAttempts = 0;
+
+				// keep spinning until a slot is reserved; the segment holding
+				// the slot is installed before reservation, so running out of
+				// memory leaves no reserved slot behind
+				while (true)
+				{
+					const ULONG_PTR ulpPos = m_ulpSize;
+					ULONG ulSegment = 0;
+					ULONG_PTR ulpOffset = 0;
+					Locate(ulpPos, &ulSegment, &ulpOffset);
+					EnsureSegment(ulSegment);
+
+					if (FCompareSwap((ULONG_PTR *) &m_ulpSize, ulpPos, ulpPos + 1))
+					{
+						return ulpPos;
+					}
+
+					CheckBackOff(ulAttempts);
+				}
+			}
+
+			// publish element at a reserved slot
+			void Publish
+				(
+				ULONG_PTR ulpPos,
+				T *pt
+				)
+			{
+				GPOS_ASSERT(NULL != pt);
+
+#ifdef GPOS_DEBUG
+				BOOL fPublished =
+#endif // GPOS_DEBUG
+					FCompareSwap<T>((volatile T**) PptSlot(ulpPos), NULL, pt);
+
+				GPOS_ASSERT(fPublished && "Slot is already published");
+			}
+
+			// is the segment holding the next slot installed, i.e. does
+			// appending the next element not allocate
+			BOOL FNextInstalled() const
+			{
+				ULONG ulSegment = 0;
+				ULONG_PTR ulpOffset = 0;
+				Locate(m_ulpSize, &ulSegment, &ulpOffset);
+
+				return NULL != m_rgppt[ulSegment];
+			}
+
+			// install the segment holding the next slot
+			void InstallNext()
+			{
+				ULONG ulSegment = 0;
+				ULONG_PTR ulpOffset = 0;
+				Locate(m_ulpSize, &ulSegment, &ulpOffset);
+				EnsureSegment(ulSegment);
+			}
+
+			// remove element at given position; the slot becomes NULL
+			void Remove
+				(
+				ULONG_PTR ulpPos
+				)
+			{
+				T *pt = *PptSlot(ulpPos);
+				GPOS_ASSERT(NULL != pt && "Slot is empty");
+
+#ifdef GPOS_DEBUG
+				BOOL fRemoved =
+#endif // GPOS_DEBUG
+					FCompareSwap<T>((volatile T**) PptSlot(ulpPos), pt, NULL);
+
+				GPOS_ASSERT(fRemoved && "Slot is removed concurrently");
+			}
+
+			// append element, return its position
+			ULONG_PTR UlpAppend
+				(
+				T *pt
+				)
+			{
+				GPOS_ASSERT(NULL != pt);
+
+				const ULONG_PTR ulpPos = UlpReserve();
+				Publish(ulpPos, pt);
+
+				return ulpPos;
+			}
+
+			// number of elements, including appends in progress
+			ULONG_PTR UlpSize() const
+			{
+				return m_ulpSize;
+			}
+
+			// slot at given position; the slot's address never changes
+			T * const *PptSlot
+				(
+				ULONG_PTR ulpPos
+				)
+				const
+			{
+				GPOS_ASSERT(ulpPos < m_ulpSize);
+
+				ULONG ulSegment = 0;
+				ULONG_PTR ulpOffset = 0;
+				Locate(ulpPos, &ulSegment, &ulpOffset);
+
+				return &m_rgppt[ulSegment][ulpOffset];
+			}
+
+			// element at given position; NULL if its append is in progress,
+			// nothing was published at the reserved slot, or the element
+			// was removed
+			T *operator []
+				(
+				ULONG_PTR ulpPos
+				)
+				const
+			{
+				return *PptSlot(ulpPos);
+			}
+
+	}; // class CSyncSegmentedArray
+}
+
+#endif // !GPOS_CSyncSegmentedArray_H
+
+// EOF
@@ -37,6 +37,9 @@ namespace gpos
 	// thread description record
 	typedef pthread_t PTHREAD_T;
 
+	// key for thread-specific data
+	typedef pthread_key_t PTHREAD_KEY_T;
+
 	// set of signals
 	typedef sigset_t SIGSET_T;
 }
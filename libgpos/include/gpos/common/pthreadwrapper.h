@@ -107,6 +107,18 @@ namespace gpos
 		// get the calling thread ID
 		PTHREAD_T PthrdtPthreadSelf();
 
+		// create a key for thread-specific data
+		INT IPthreadKeyCreate(PTHREAD_KEY_T *pkey, void (*pfnDestructor)(void*));
+
+		// delete a key for thread-specific data
+		void PthreadKeyDelete(PTHREAD_KEY_T key);
+
+		// get thread-specific data of the calling thread
+		void *PvPthreadGetSpecific(PTHREAD_KEY_T key);
+
+		// set thread-specific data of the calling thread
+		INT IPthreadSetSpecific(PTHREAD_KEY_T key, const void *pv);
+
 		// set signal mask for thread
 		void PthreadSigMask(INT iMode, const SIGSET_T *pset, SIGSET_T *psetOld);
 
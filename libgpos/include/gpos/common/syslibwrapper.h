@@ -38,6 +38,29 @@ namespace gpos {
 		// close the descriptor being used to write to the system logger
 		void CloseLog();
 
+		// map anonymous private memory; return NULL on failure
+		void *PvMapAnonymous(SIZE_T ulSize);
+
+		// unmap memory obtained by PvMapAnonymous
+		void Unmap(void *pv, SIZE_T ulSize);
+
+		// advise the kernel to back a mapped range with transparent huge pages;
+		// return false if huge pages are not supported
+		BOOL FAdviseHugePages(void *pv, SIZE_T ulSize);
+
+		// block while the value at the given address equals the expected
+		// value, until woken up or the timeout expires
+		void FutexWait(volatile ULONG *pul, ULONG ulExpected, ULONG ulTimeoutUs);
+
+		// wake up threads blocked on the given address
+		void FutexWake(volatile ULONG *pul, ULONG ulWaiters);
+
+		// bind calling thread to the processor at the given position, modulo
+		// their number, among the processors the process may run on, or to
+		// all of them if gpos::ulong_max is passed; return false if binding
+		// is not supported
+		BOOL FBindToCpu(ULONG ulCpu);
+
 
 	} //namespace syslib
 }
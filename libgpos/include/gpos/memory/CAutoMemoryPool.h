@@ -68,7 +68,8 @@ namespace gpos
 				ELeakCheck elc = ElcExc,
 				CMemoryPoolManager::EAllocType ept = CMemoryPoolManager::EatTracker,
 				BOOL fThreadSafe = true,
-				ULLONG ullCapacity = gpos::ullong_max
+				ULLONG ullCapacity = gpos::ullong_max,
+				BOOL fHugePages = false
 				);
 
 			// dtor
@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CAutoMemoryPoolRegion.h
+//
+//	@doc:
+//		Guard for a region sub-pool serving the scratch data of a single
+//		unit of work
+//---------------------------------------------------------------------------
+#ifndef GPOS_CAutoMemoryPoolRegion_H
+#define GPOS_CAutoMemoryPoolRegion_H
+
+#include "gpos/base.h"
+#include "gpos/common/CStackObject.h"
+#include "gpos/memory/CMemoryPoolRegion.h"
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CAutoMemoryPoolRegion
+	//
+	//	@doc:
+	//		Creates a region of a parent pool and drops it when going out of
+	//		scope, including when an exception is thrown; all memory of the
+	//		region is returned to the parent at once
+	//
+	//---------------------------------------------------------------------------
+	class CAutoMemoryPoolRegion : public CStackObject
+	{
+		private:
+
+			// region
+			CMemoryPoolRegion *m_pmpr;
+
+			// private copy ctor
+			CAutoMemoryPoolRegion(const CAutoMemoryPoolRegion &);
+
+		public:
+
+			// ctor
+			explicit
+			CAutoMemoryPoolRegion
+				(
+				IMemoryPool *pmpParent
+				)
+				:
+				m_pmpr(NULL)
+			{
+				GPOS_ASSERT(NULL != pmpParent);
+
+				m_pmpr = GPOS_NEW(pmpParent) CMemoryPoolRegion(pmpParent);
+			}
+
+			// dtor
+			~CAutoMemoryPoolRegion()
+			{
+				m_pmpr->Drop();
+			}
+
+			// accessor of region
+			IMemoryPool *Pmp() const
+			{
+				return m_pmpr;
+			}
+
+	}; // class CAutoMemoryPoolRegion
+}
+
+#endif // !GPOS_CAutoMemoryPoolRegion_H
+
+// EOF
+
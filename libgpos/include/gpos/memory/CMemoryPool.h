@@ -75,6 +75,10 @@ namespace gpos
 
 				// allocation request size
 				ULONG m_ulAlloc;
+
+				// tag assigned by allocation profile, zero if not profiled;
+				// occupies what would otherwise be padding
+				ULONG m_ulProfileTag;
 			};
 
 			// reference counter
@@ -120,6 +124,28 @@ namespace gpos
 			static
 			const ULONG_PTR m_ulpInvalid;
 
+			// allocation size of a block finalized by GPOS_NEW, given the
+			// address returned by PvAllocate
+			static
+			ULONG UlAllocSizeOfBlock
+				(
+				const void *pv
+				)
+			{
+				return UlAllocSize(static_cast<const SAllocHeader*>(pv)->m_ulAlloc);
+			}
+
+			// pool recorded in the header of a block finalized by GPOS_NEW,
+			// given the address returned by PvAllocate
+			static
+			const IMemoryPool *PmpOfBlock
+				(
+				const void *pv
+				)
+			{
+				return static_cast<const SAllocHeader*>(pv)->m_pmp;
+			}
+
 		public:
 
 			// dtor
@@ -164,6 +190,10 @@ namespace gpos
 			// set allocation header and footer, return pointer to user data
 			void *PvFinalizeAlloc(void *pv, ULONG ulAlloc, EAllocationType eat);
 
+			// record allocation in the profile of the calling task, if any
+			static
+			void RecordProfiledAlloc(void *pv, const CHAR *szFile, ULONG ulLine);
+
 			// return allocation to owning memory pool
 			static
 			void FreeAlloc(void *pv, EAllocationType eat);
@@ -0,0 +1,199 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.h
+//
+//	@doc:
+//		Memory pool that carves allocations out of large chunks by bumping
+//		a pointer; individual frees are ignored and all chunks are returned
+//		to the underlying pool when the arena is torn down.
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolArena_H
+#define GPOS_CMemoryPoolArena_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/CSpinlock.h"
+
+// default size of the first chunk requested by an arena
+#define GPOS_MEM_ARENA_CHUNK_MIN (64 * 1024)
+
+// chunk size stops doubling once it reaches this size
+#define GPOS_MEM_ARENA_CHUNK_MAX (4 * 1024 * 1024)
+
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolArena
+	//
+	//	@doc:
+	//
+	//		Arena memory pool for allocations that share the lifetime of the
+	//		pool, e.g. all objects created during one optimization session.
+	//
+	//		Memory is handed out from the current chunk by advancing an offset;
+	//		when the chunk is exhausted, a new chunk of twice the size (up to a
+	//		maximum) is requested from the underlying pool. Requests that do not
+	//		fit into a regular chunk get a dedicated chunk, which is linked
+	//		behind the current one so that the remaining space is not wasted.
+	//
+	//		Free is a no-op; tear-down walks the chunk list once, so its cost
+	//		is proportional to the number of chunks rather than the number of
+	//		allocations.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolArena : public CMemoryPool
+	{
+		private:
+
+			// chunk header, stored at the beginning of each chunk
+			struct SChunk
+			{
+				// next chunk in list
+				SChunk *m_pchunkNext;
+
+				// total size, including header
+				ULONG m_ulTotal;
+
+				// used size, including header
+				ULONG m_ulUsed;
+
+				// init
+				void Init
+					(
+					ULONG ulTotal,
+					SChunk *pchunkNext
+					)
+				{
+					m_pchunkNext = pchunkNext;
+					m_ulTotal = ulTotal;
+					m_ulUsed = GPOS_MEM_ALIGNED_STRUCT_SIZE(SChunk);
+				}
+
+				// check if there is enough space for allocation request
+				BOOL FFit
+					(
+					ULONG ulAlloc
+					)
+					const
+				{
+					return (m_ulTotal - m_ulUsed >= ulAlloc);
+				}
+			};
+
+			// chunk that serves allocations, head of chunk list
+			SChunk *m_pchunkCurrent;
+
+			// size of the first chunk to request from the underlying pool
+			const ULONG m_ulChunkSizeMin;
+
+			// size of the next regular chunk to request from the underlying pool
+			ULONG m_ulChunkSize;
+
+			// number of chunks held by the arena
+			ULONG m_ulChunks;
+
+			// total size of chunks obtained from the underlying pool
+			ULLONG m_ullReserved;
+
+			// max memory to allow in the pool;
+			// if equal to ULLONG, checks for exceeding max memory are bypassed
+			const ULLONG m_ullCapacity;
+
+			// spinlock to protect the current chunk if pool is thread-safe
+			CSpinlockOS m_slock;
+
+			// allocate a new chunk from underlying pool and link it into the list
+			SChunk *PchunkNew(ULONG ulAlloc);
+
+#ifdef GPOS_DEBUG
+			// check if a particular allocation is sound for this memory pool
+			void CheckAllocation(void *pv);
+#endif // GPOS_DEBUG
+
+			// private copy ctor
+			CMemoryPoolArena(CMemoryPoolArena &);
+
+		public:
+
+			// ctor
+			CMemoryPoolArena
+				(
+				IMemoryPool *pmp,
+				ULLONG ullCapacity,
+				BOOL fThreadSafe,
+				BOOL fOwnsUnderlying,
+				ULONG ulChunkSizeMin = GPOS_MEM_ARENA_CHUNK_MIN
+				);
+
+			// dtor
+			virtual
+			~CMemoryPoolArena();
+
+			// allocate memory
+			virtual
+			void *PvAllocate
+				(
+				const ULONG ulBytes,
+				const CHAR *szFile,
+				const ULONG ulLine
+				);
+
+			// free memory - memory is released when the memory pool is torn down
+			virtual
+			void Free
+				(
+#ifdef GPOS_DEBUG
+				void *pv
+#else
+				void *
+#endif // GPOS_DEBUG
+				)
+			{
+#ifdef GPOS_DEBUG
+				CheckAllocation(pv);
+#endif // GPOS_DEBUG
+			}
+
+			// return all chunks to the underlying pool
+			virtual
+			void TearDown();
+
+			// check if the pool stores a pointer to itself at the end of
+			// the header of each allocated object;
+			virtual
+			BOOL FStoresPoolPointer() const
+			{
+				return true;
+			}
+
+			// return total allocated size
+			virtual
+			ULLONG UllTotalAllocatedSize() const
+			{
+				return m_ullReserved;
+			}
+
+			// number of chunks held by the arena
+			ULONG UlChunks() const
+			{
+				return m_ulChunks;
+			}
+	};
+}
+
+#endif // !GPOS_CMemoryPoolArena_H
+
+// EOF
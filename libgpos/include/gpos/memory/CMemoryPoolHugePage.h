@@ -0,0 +1,274 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolHugePage.h
+//
+//	@doc:
+//		Memory pool that serves large requests from memory regions backed
+//		by transparent huge pages
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolHugePage_H
+#define GPOS_CMemoryPoolHugePage_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/CList.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/CSpinlock.h"
+
+// size of a huge page
+#define GPOS_MEM_HUGE_PAGE_SIZE			(2 * 1024 * 1024)
+
+// size of a region mapped from the OS
+#define GPOS_MEM_HUGE_PAGE_REGION_SIZE	(16 * GPOS_MEM_HUGE_PAGE_SIZE)
+
+// unit of allocation within a region
+#define GPOS_MEM_HUGE_PAGE_GRANULE		(16 * 1024)
+
+// number of granules in a region
+#define GPOS_MEM_HUGE_PAGE_GRANULES		(GPOS_MEM_HUGE_PAGE_REGION_SIZE / GPOS_MEM_HUGE_PAGE_GRANULE)
+
+// number of words in a region's granule bitmap
+#define GPOS_MEM_HUGE_PAGE_BITMAP_WORDS	(GPOS_MEM_HUGE_PAGE_GRANULES / 64)
+
+// number of slots of the table of huge pages owned by the pool; at most
+// half of them hold pages, i.e. the pool maps up to 4GB of regions
+#define GPOS_MEM_HUGE_PAGE_TABLE_SIZE	(4096)
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolHugePage
+	//
+	//	@doc:
+	//
+	//		Base memory pool for pools with large working sets; pools request
+	//		it instead of the default base pool when created with huge pages
+	//		enabled.
+	//
+	//		Requests of at least a granule are carved out of regions that are
+	//		mapped from the OS and advised to be backed by transparent huge
+	//		pages; this keeps large chunks of arenas, stacks and hash tables
+	//		on few TLB entries. Requests larger than a region get a mapping of
+	//		their own, rounded up to a multiple of the huge page size. Smaller
+	//		requests, and all requests if mapping fails, are passed to the
+	//		underlying pool as they are, without a header of this pool.
+	//
+	//		On free, memory of the pool is told apart from memory of the
+	//		underlying pool by looking up its huge page in a table of the
+	//		pages of all regions and of the first page of all mappings; the
+	//		table is read without locking, and lookups are repeated if the
+	//		table was rehashed meanwhile to drop removed entries.
+	//
+	//		If the kernel does not support transparent huge pages, regions are
+	//		backed by regular pages.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolHugePage : public CMemoryPool
+	{
+		private:
+
+			// origin of an allocation
+			enum EAllocOrigin
+			{
+				EaoRegion,		// carved out of a region
+				EaoMapping		// dedicated mapping
+			};
+
+			// region mapped from the OS
+			struct SRegion
+			{
+				// link for list of regions
+				SLink m_link;
+
+				// start of mapped memory
+				BYTE *m_pb;
+
+				// number of free granules
+				ULONG m_ulFree;
+
+				// did the kernel accept to back the region by huge pages
+				BOOL m_fHugePages;
+
+				// granule bitmap, a set bit marks a used granule
+				ULLONG m_rgullUsed[GPOS_MEM_HUGE_PAGE_BITMAP_WORDS];
+			};
+
+			// header of an allocation
+			struct SAllocHeader
+			{
+				// link for list of dedicated mappings
+				SLink m_link;
+
+				// region of allocation, NULL for a dedicated mapping
+				SRegion *m_pregion;
+
+				// size of allocation including header; granules for regions
+				ULLONG m_ullSize;
+
+				// origin of allocation
+				ULONG m_ulOrigin;
+			};
+
+			// list of regions
+			CList<SRegion> m_listRegions;
+
+			// list of dedicated mappings
+			CList<SAllocHeader> m_listMappings;
+
+			// number of regions backed by huge pages
+			ULONG m_ulHugePageRegions;
+
+			// size of memory mapped from the OS
+			ULLONG m_ullMapped;
+
+			// two open-addressing tables of huge page numbers owned by the
+			// pool, one of which is in use while the other one is rebuilt by
+			// rehashing; zero marks an empty slot, ULONG_PTR_MAX a removed entry
+			volatile ULONG_PTR m_rgrgulpPages[2][GPOS_MEM_HUGE_PAGE_TABLE_SIZE];
+
+			// index of the page table in use
+			volatile ULONG m_ulPageTable;
+
+			// incremented before and after rehashing, odd while rehashing
+			volatile ULONG_PTR m_ulpPageTableVersion;
+
+			// number of pages in the page table
+			ULONG m_ulPages;
+
+			// number of non-empty slots of the page table, i.e. pages and
+			// removed entries
+			ULONG m_ulPageSlots;
+
+			// spinlock protecting regions, mappings and the page table
+			CSpinlockOS m_slock;
+
+			// huge page number of an address
+			static
+			ULONG_PTR UlpPage
+				(
+				const void *pv
+				)
+			{
+				return ((ULONG_PTR) pv) / GPOS_MEM_HUGE_PAGE_SIZE;
+			}
+
+			// first slot to probe for a huge page number
+			static
+			ULONG UlPageSlot
+				(
+				ULONG_PTR ulpPage
+				)
+			{
+				// multiplicative hashing spreads consecutive pages
+				return (ULONG) (ulpPage * 2654435761U) & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1);
+			}
+
+			// copy the pages of the page table in use into the other table
+			// without removed entries, and switch tables
+			void RehashPages();
+
+			// add huge pages starting at given page-aligned address to the
+			// page table; return false if the table is full
+			BOOL FInsertPages(const void *pv, ULONG ulPages);
+
+			// remove huge pages starting at given address from the page table
+			void RemovePages(const void *pv, ULONG ulPages);
+
+			// is address within memory mapped by the pool
+			BOOL FOwned(const void *pv) const;
+
+			// map memory aligned to huge page size and advise the kernel to back
+			// it by huge pages; return NULL on failure
+			static
+			void *PvMapAligned(SIZE_T ulSize, BOOL *pfHugePages);
+
+			// map a new region and link it into the list
+			SRegion *PregionNew();
+
+			// unmap a region
+			void UnmapRegion(SRegion *pregion);
+
+			// find a run of free granules in a region, return its index or
+			// ulong_max if none was found
+			static
+			ULONG UlFindRun(const SRegion *pregion, ULONG ulGranules);
+
+			// set granules of a run as used or free
+			static
+			void MarkRun(SRegion *pregion, ULONG ulFirst, ULONG ulGranules, BOOL fUsed);
+
+			// allocate from regions
+			void *PvAllocateFromRegion(ULONG ulGranules);
+
+			// allocate a dedicated mapping
+			void *PvAllocateMapping(ULLONG ullSize);
+
+			// private copy ctor
+			CMemoryPoolHugePage(CMemoryPoolHugePage &);
+
+		public:
+
+			// ctor
+			CMemoryPoolHugePage
+				(
+				IMemoryPool *pmp,
+				BOOL fOwnsUnderlying
+				);
+
+			// dtor
+			virtual
+			~CMemoryPoolHugePage();
+
+			// allocate memory
+			virtual
+			void *PvAllocate
+				(
+				const ULONG ulBytes,
+				const CHAR *szFile,
+				const ULONG ulLine
+				);
+
+			// free memory
+			virtual
+			void Free(void *pv);
+
+			// return all regions to the OS and tear down the pool
+			virtual
+			void TearDown();
+
+			// return size of memory mapped from the OS
+			virtual
+			ULLONG UllTotalAllocatedSize() const
+			{
+				return m_ullMapped;
+			}
+
+			// number of mapped regions
+			ULONG UlRegions() const
+			{
+				return m_listRegions.UlSize();
+			}
+
+			// number of regions the kernel accepted to back by huge pages
+			ULONG UlHugePageRegions() const
+			{
+				return m_ulHugePageRegions;
+			}
+	};
+}
+
+#endif // !GPOS_CMemoryPoolHugePage_H
+
+// EOF
+
@@ -42,7 +42,9 @@ namespace gpos
 			enum EAllocType
 			{
 				EatTracker,
-				EatStack
+				EatStack,
+				EatArena,
+				EatThreadCache
 			};
 
 		private:
@@ -60,6 +62,10 @@ namespace gpos
 			// all created pools use this as their underlying allocator
 			IMemoryPool *m_pmpBase;
 
+			// base pool mapping large chunks backed by huge pages; used as
+			// underlying allocator by pools created with huge pages enabled
+			IMemoryPool *m_pmpHugePage;
+
 			// memory pool in which all objects created by the manager itself
 			// are allocated - must be thread-safe
 			IMemoryPool *m_pmpInternal;
@@ -108,7 +114,8 @@ namespace gpos
 				(
 				EAllocType eat,
 				ULLONG ullCapacity,
-				BOOL fThreadSafe
+				BOOL fThreadSafe,
+				BOOL fHugePages
 				);
 #endif // GPOS_DEBUG
 
@@ -130,6 +137,18 @@ namespace gpos
 				CMemoryPoolManager::EAllocType ept,
 				BOOL fThreadSafe,
 				ULLONG ullCapacity
+				)
+			{
+				return PmpCreate(ept, fThreadSafe, ullCapacity, false /*fHugePages*/);
+			}
+
+			// create new memory pool, optionally on top of huge pages
+			IMemoryPool *PmpCreate
+				(
+				CMemoryPoolManager::EAllocType ept,
+				BOOL fThreadSafe,
+				ULLONG ullCapacity,
+				BOOL fHugePages
 				);
 				
 			// release memory pool
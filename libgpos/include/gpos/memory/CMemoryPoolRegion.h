@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolRegion.h
+//
+//	@doc:
+//		Short-lived arena sub-pool of a parent pool that is dropped as a
+//		whole once its owner is done with it
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolRegion_H
+#define GPOS_CMemoryPoolRegion_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/memory/CMemoryPoolArena.h"
+
+// size of the first chunk of a region
+#define GPOS_MEM_REGION_CHUNK_MIN (8 * 1024)
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolRegion
+	//
+	//	@doc:
+	//
+	//		Arena allocated from, and carving its chunks out of, a parent pool.
+	//		A region serves the scratch data of a single unit of work, e.g.
+	//		the statistics derived to check the promise of an xform, and is
+	//		used by a single thread.
+	//
+	//		Allocation bumps a pointer and free does not give back memory. The
+	//		owner drops the region when done; the region then returns all its
+	//		chunks to the parent at once and deletes itself. No allocation of
+	//		a region may be used once it is dropped.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolRegion : public CMemoryPoolArena
+	{
+		private:
+
+			// private copy ctor
+			CMemoryPoolRegion(CMemoryPoolRegion &);
+
+		public:
+
+			// ctor
+			explicit
+			CMemoryPoolRegion(IMemoryPool *pmpParent);
+
+			// dtor; regions delete themselves when dropped
+			virtual
+			~CMemoryPoolRegion();
+
+			// return all chunks to the parent and delete the region
+			void Drop();
+	};
+}
+
+#endif // !GPOS_CMemoryPoolRegion_H
+
+// EOF
+
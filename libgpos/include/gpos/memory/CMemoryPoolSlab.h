@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolSlab.h
+//
+//	@doc:
+//		Memory pool serving objects of a single type out of contiguous slabs
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolSlab_H
+#define GPOS_CMemoryPoolSlab_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/CSpinlock.h"
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolSlab
+	//
+	//	@doc:
+	//
+	//		Pool for objects of a fixed size that are created and destroyed at
+	//		high rates, e.g. memo group expressions.
+	//
+	//		Like CSyncPool, the pool pre-carves storage for many objects at
+	//		once; unlike CSyncPool, it does not construct objects up-front, so
+	//		it serves any class allocated by GPOS_NEW and freed by GPOS_DELETE,
+	//		including ref-counted ones.
+	//
+	//		Blocks are carved out of slabs obtained from the underlying pool;
+	//		freed blocks are kept in a free list and are reused before the
+	//		current slab is advanced. Objects allocated close in time are
+	//		thus adjacent in memory. Slabs are returned to the underlying pool
+	//		when the pool is torn down.
+	//
+	//		Requests exceeding the object size are passed to the underlying
+	//		pool; on free, the two are told apart by the request size recorded
+	//		in the allocation header, hence the pool only serves GPOS_NEW.
+	//
+	//		In debug builds, slabs holding objects that were not freed are
+	//		left to the underlying pool at tear down, so that the objects are
+	//		reported as leaks of the underlying pool.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolSlab : public CMemoryPool
+	{
+		private:
+
+			// slab header, followed by blocks
+			struct SSlab
+			{
+				// next slab
+				SSlab *m_pslabNext;
+			};
+
+			// free block
+			struct SBlock
+			{
+				// next free block
+				SBlock *m_pblockNext;
+			};
+
+			// size of a block, fits an allocation of the object size
+			const ULONG m_ulBlockSize;
+
+			// number of blocks per slab
+			const ULONG m_ulSlabBlocks;
+
+			// list of slabs
+			SSlab *m_pslabFirst;
+
+			// list of freed blocks
+			SBlock *m_pblockFree;
+
+			// next unused block of the most recent slab
+			BYTE *m_pbNext;
+
+			// end of the most recent slab
+			BYTE *m_pbEnd;
+
+			// number of slabs
+			ULONG m_ulSlabs;
+
+			// number of blocks in use
+			ULONG m_ulLive;
+
+			// spinlock
+			CSpinlockOS m_slock;
+
+			// allocate a new slab; requires spinlock
+			BOOL FNewSlab();
+
+			// check if a request of given size is served by a slab
+			BOOL FSlabSize
+				(
+				ULONG ulBytes
+				)
+				const
+			{
+				return ulBytes <= m_ulBlockSize;
+			}
+
+#ifdef GPOS_DEBUG
+			// check if a slab holds blocks that were not freed
+			BOOL FHoldsLiveBlocks(SSlab *pslab) const;
+#endif // GPOS_DEBUG
+
+			// private copy ctor
+			CMemoryPoolSlab(CMemoryPoolSlab &);
+
+		public:
+
+			// ctor
+			CMemoryPoolSlab
+				(
+				IMemoryPool *pmp,
+				ULONG ulObjectSize,
+				ULONG ulSlabBlocks,
+				BOOL fThreadSafe,
+				BOOL fOwnsUnderlying
+				);
+
+			// dtor
+			virtual
+			~CMemoryPoolSlab();
+
+			// allocate memory
+			virtual
+			void *PvAllocate
+				(
+				const ULONG ulBytes,
+				const CHAR *szFile,
+				const ULONG ulLine
+				);
+
+			// free memory
+			virtual
+			void Free(void *pv);
+
+			// return all slabs to the underlying pool
+			virtual
+			void TearDown();
+
+			// check if the pool stores a pointer to itself at the end of
+			// the header of each allocated object;
+			virtual
+			BOOL FStoresPoolPointer() const
+			{
+				return true;
+			}
+
+			// return total allocated size
+			virtual
+			ULLONG UllTotalAllocatedSize() const
+			{
+				return (ULLONG) m_ulSlabs * (GPOS_MEM_ALIGNED_STRUCT_SIZE(SSlab) + (ULLONG) m_ulBlockSize * m_ulSlabBlocks);
+			}
+
+			// number of blocks in use
+			ULONG UlLive() const
+			{
+				return m_ulLive;
+			}
+
+			// number of slabs
+			ULONG UlSlabs() const
+			{
+				return m_ulSlabs;
+			}
+
+			// size of memory needed to allocate an object of given size
+			// using GPOS_NEW
+			static
+			ULONG UlObjectBlockSize(ULONG ulObjectSize)
+			{
+				return GPOS_MEM_ALIGNED_SIZE(CMemoryPool::UlAllocSize(ulObjectSize));
+			}
+	};
+}
+
+#endif // !GPOS_CMemoryPoolSlab_H
+
+// EOF
+
@@ -26,6 +26,9 @@
 #include "gpos/sync/CAutoSpinlock.h"
 #include "gpos/sync/CSpinlock.h"
 
+// number of size classes with free lists
+#define GPOS_MEM_STACK_SIZE_CLASSES	(5)
+
 
 namespace gpos
 {
@@ -40,8 +43,11 @@ namespace gpos
 	//		the block size, the blocks are skipped and the request is satisfied
 	//		from the underlying pool.
 	//
-	//		Note that this pool does not free up  memory, regardless of free
-	//		calls, until it is torn down.
+	//		Small allocations are rounded up to one of a few size classes;
+	//		freeing such an allocation puts it on the free list of its class,
+	//		from where it is handed out again to the next request of the same
+	//		class. Other allocations are not reclaimed until the pool is torn
+	//		down, and no memory is returned to the underlying pool before that.
 	//
 	//---------------------------------------------------------------------------
 	class CMemoryPoolStack : public CMemoryPool
@@ -87,9 +93,27 @@ namespace gpos
 				}
 			};
 
+			// header preceding each allocation; pools stacked on top of this
+			// one free by address only, so the size class is kept here
+			struct SAllocHeader
+			{
+				// index of size class, or ulong_max if allocation is not recycled
+				ULONG m_ulSizeClass;
+			};
+
+			// link of a free list, stored in the freed allocation
+			struct SFreeLink
+			{
+				// next free allocation of the same size class
+				SFreeLink *m_pflNext;
+			};
+
 			// currently used block
 			SBlockDescriptor *m_pbd;
 
+			// heads of free lists, one per size class
+			SFreeLink *m_rgpflFree[GPOS_MEM_STACK_SIZE_CLASSES];
+
 			// size of reserved memory;
 			// this includes total allocated memory and pending allocations;
 			volatile ULLONG m_ullReserved;
@@ -110,9 +134,18 @@ namespace gpos
 			// allocate block from underlying pool
 			SBlockDescriptor *PbdNew(ULONG ulSize);
 
-			// find block to provide memory for allocation request
+			// find block to provide memory for allocation request;
+			// spinlock must be held by caller if pool is thread-safe
 			SBlockDescriptor *PbdProvider(CAutoSpinlock &as, ULONG ulAlloc);
 
+			// size class of an aligned allocation request
+			static
+			ULONG UlSizeClass(ULONG ulAlloc);
+
+			// allocation size of a size class
+			static
+			ULONG UlSizeClassBytes(ULONG ulSizeClass);
+
 			// acquire spinlock if pool is thread-safe
 			void SLock(CAutoSpinlock &as)
 			{
@@ -163,21 +196,10 @@ namespace gpos
 				const ULONG ulLine
 				);
 
-			// free memory - memory is released when the memory pool is torn down
+			// free memory - small allocations are recycled, memory is
+			// released when the memory pool is torn down
 			virtual
-			void Free
-				(
-#ifdef GPOS_DEBUG
-				void *pv
-#else
-				void *
-#endif // GPOS_DEBUG
-				)
-			{
-#ifdef GPOS_DEBUG
-				CheckAllocation(pv);
-#endif // GPOS_DEBUG
-			}
+			void Free(void *pv);
 
 			// return all used memory to the underlying pool and tear it down
 			virtual
@@ -0,0 +1,305 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolThreadCache.h
+//
+//	@doc:
+//		Memory pool that serves small allocations from per-thread caches
+//		and only synchronizes threads when caches are refilled or flushed.
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolThreadCache_H
+#define GPOS_CMemoryPoolThreadCache_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/CList.h"
+#include "gpos/common/pthreadtypes.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/CSpinlock.h"
+
+// number of size classes served from thread caches
+#define GPOS_MEM_TC_SIZE_CLASSES	(7)
+
+// number of pools whose magazines a thread can find directly
+#define GPOS_MEM_TC_THREAD_SLOTS	(16)
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolThreadCache
+	//
+	//	@doc:
+	//
+	//		Thread-caching memory pool; small allocations are rounded up to one
+	//		of a few size classes and served from a cache ("magazine") owned by
+	//		the calling thread, without taking any lock.
+	//
+	//		Magazines exchange objects with a central free list per size class
+	//		in batches, so the pool's spinlock is taken once per batch instead
+	//		of once per allocation. The central lists are refilled by carving
+	//		chunks obtained from the underlying pool.
+	//
+	//		Large allocations bypass the caches and go to the underlying pool.
+	//		Chunks and magazines are only returned to the underlying pool when
+	//		the pool is torn down.
+	//
+	//		If the pool is not thread-safe, a single magazine owned by the pool
+	//		is used and no locking takes place.
+	//
+	//		All pools share one thread-specific data key; it refers to a small
+	//		table per thread that maps pool ids to the thread's magazines.
+	//		Pool ids are never reused, so entries of destroyed pools are simply
+	//		overwritten. A pool whose entry is overwritten by another pool
+	//		looks up the thread's magazine in its list of magazines again.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolThreadCache : public CMemoryPool
+	{
+		private:
+
+			// link of a free list, stored in the freed allocation
+			struct SFreeLink
+			{
+				// next free allocation of the same size class
+				SFreeLink *m_pflNext;
+			};
+
+			// header of a cached allocation
+			struct SAllocHeader
+			{
+				// unused, keeps size class adjacent to user data
+				ULONG m_ulPadding;
+
+				// index of size class
+				ULONG m_ulSizeClass;
+			};
+
+			// header of a large allocation, made from the underlying pool
+			struct SLargeHeader
+			{
+				// link for list of large allocations
+				SLink m_link;
+
+				// allocation size, including header
+				ULONG m_ulAlloc;
+
+				// always ulong_max
+				ULONG m_ulSizeClass;
+			};
+
+			// per-thread cache of free allocations
+			struct SMagazine
+			{
+				// free allocations per size class
+				SFreeLink *m_rgpfl[GPOS_MEM_TC_SIZE_CLASSES];
+
+				// number of free allocations per size class
+				ULONG m_rgulCount[GPOS_MEM_TC_SIZE_CLASSES];
+
+				// next magazine of the pool
+				SMagazine *m_pmagNext;
+
+				// thread owning the magazine
+				PTHREAD_T m_pthrdt;
+
+				// init
+				void Init(SMagazine *pmagNext);
+			};
+
+			// magazines of the calling thread, indexed by pool id
+			struct SThreadSlots
+			{
+				// ids of pools owning the magazines, zero for empty slots
+				ULONG_PTR m_rgulpPoolId[GPOS_MEM_TC_THREAD_SLOTS];
+
+				// magazines
+				SMagazine *m_rgpmag[GPOS_MEM_TC_THREAD_SLOTS];
+			};
+
+			// chunk header, stored at the beginning of each chunk
+			struct SChunk
+			{
+				// next chunk of the pool
+				SChunk *m_pchunkNext;
+
+				// total size, including header
+				ULONG m_ulTotal;
+
+				// used size, including header
+				ULONG m_ulUsed;
+			};
+
+			// central free lists per size class
+			SFreeLink *m_rgpflCentral[GPOS_MEM_TC_SIZE_CLASSES];
+
+			// chunk that is carved into new allocations, head of chunk list
+			SChunk *m_pchunkCurrent;
+
+			// magazines of all threads that used the pool
+			SMagazine *m_pmagFirst;
+
+			// magazine used when the pool is not thread-safe, or if no
+			// thread-specific data key is available
+			SMagazine m_magShared;
+
+			// list of large allocations
+			CList<SLargeHeader> m_listLarge;
+
+			// size of memory obtained from the underlying pool
+			ULLONG m_ullReserved;
+
+			// max memory to allow in the pool;
+			// if equal to ULLONG, checks for exceeding max memory are bypassed
+			const ULLONG m_ullCapacity;
+
+			// unique id of the pool
+			const ULONG_PTR m_ulpId;
+
+			// spinlock protecting central free lists, chunks, magazine list
+			// and large allocations
+			CSpinlockOS m_slock;
+
+			// key of thread-specific slot tables, shared by all pools
+			static
+			PTHREAD_KEY_T m_keySlots;
+
+			// is the thread-specific data key valid
+			static
+			BOOL m_fKeySlotsValid;
+
+			// pool for slot tables
+			static
+			IMemoryPool *m_pmpSlots;
+
+			// last assigned pool id
+			static
+			volatile ULONG_PTR m_ulpLastId;
+
+			// slot table of the calling thread, created on first use
+			static
+			SThreadSlots *PtsSelf();
+
+			// release slot table of an exiting thread
+			static
+			void DestroySlots(void *pv);
+
+			// magazine of the calling thread
+			SMagazine *PmagSelf();
+
+			// move a batch of allocations from central list to magazine;
+			// return false if memory is exhausted
+			BOOL FRefill(SMagazine *pmag, ULONG ulSizeClass);
+
+			// move a batch of allocations from magazine to central list
+			void Flush(SMagazine *pmag, ULONG ulSizeClass);
+
+			// allocate memory from underlying pool, checking capacity
+			void *PvAllocateUnderlying(CAutoSpinlock &as, ULONG ulAlloc);
+
+			// allocate memory that bypasses the caches
+			void *PvAllocateLarge(ULONG ulAlloc);
+
+			// acquire spinlock if pool is thread-safe
+			void SLock(CAutoSpinlock &as)
+			{
+				if (FThreadSafe())
+				{
+					as.Lock();
+				}
+			}
+
+			// release spinlock if pool is thread-safe
+			void SUnlock(CAutoSpinlock &as)
+			{
+				if (FThreadSafe())
+				{
+					as.Unlock();
+				}
+			}
+
+			// size class of an aligned allocation request
+			static
+			ULONG UlSizeClass(ULONG ulAlloc);
+
+			// allocation size of a size class, including header
+			static
+			ULONG UlSizeClassBytes(ULONG ulSizeClass);
+
+			// number of allocations moved between magazine and central list
+			static
+			ULONG UlBatch(ULONG ulSizeClass);
+
+			// private copy ctor
+			CMemoryPoolThreadCache(CMemoryPoolThreadCache &);
+
+		public:
+
+			// ctor
+			CMemoryPoolThreadCache
+				(
+				IMemoryPool *pmp,
+				ULLONG ullCapacity,
+				BOOL fThreadSafe,
+				BOOL fOwnsUnderlying
+				);
+
+			// dtor
+			virtual
+			~CMemoryPoolThreadCache();
+
+			// allocate memory
+			virtual
+			void *PvAllocate
+				(
+				const ULONG ulBytes,
+				const CHAR *szFile,
+				const ULONG ulLine
+				);
+
+			// free memory
+			virtual
+			void Free(void *pv);
+
+			// return all used memory to the underlying pool and tear it down
+			virtual
+			void TearDown();
+
+			// check if the pool stores a pointer to itself at the end of
+			// the header of each allocated object;
+			virtual
+			BOOL FStoresPoolPointer() const
+			{
+				return true;
+			}
+
+			// return total allocated size
+			virtual
+			ULLONG UllTotalAllocatedSize() const
+			{
+				return m_ullReserved;
+			}
+
+			// create key of thread-specific slot tables; slot tables are
+			// allocated from the given pool
+			static
+			void InitThreadKey(IMemoryPool *pmp);
+
+			// release slot table of the calling thread and delete the key
+			static
+			void ReleaseThreadKey();
+	};
+}
+
+#endif // !GPOS_CMemoryPoolThreadCache_H
+
+// EOF
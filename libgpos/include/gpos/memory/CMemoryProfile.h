@@ -0,0 +1,233 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryProfile.h
+//
+//	@doc:
+//		Per-call-site allocation profile collected by tracker memory pools
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryProfile_H
+#define GPOS_CMemoryProfile_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/io/IOstream.h"
+#include "gpos/sync/CSpinlock.h"
+
+// max number of distinct call sites in a profile; further sites are
+// accumulated in a single overflow entry
+#define GPOS_MEM_PROFILE_SITES				(1024)
+
+// number of lifetime buckets of a call site
+#define GPOS_MEM_PROFILE_LIFETIME_BUCKETS	(5)
+
+// number of records of live allocations per record chunk
+#define GPOS_MEM_PROFILE_RECORD_CHUNK		(4096)
+
+// max number of record chunks; frees of allocations that find no
+// record are not recorded
+#define GPOS_MEM_PROFILE_RECORD_CHUNKS		(1024)
+
+namespace gpos
+{
+	// prototypes
+	class IMemoryPool;
+	class ITask;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryProfile
+	//
+	//	@doc:
+	//
+	//		Aggregates allocation counts, bytes, peak live bytes and object
+	//		lifetimes per allocating (file, line) pair.
+	//
+	//		A profile records the allocations of the task that activated it
+	//		and of tasks spawned by that task afterwards, e.g. the workers of
+	//		an optimization; allocations of other tasks are not affected.
+	//		Allocations are recorded when objects are created with GPOS_NEW,
+	//		so objects placed in arena, region or slab pools are attributed to
+	//		their own call site rather than to the chunk allocation of the pool.
+	//
+	//		Sites are kept in a fixed-size open-addressing table keyed by the
+	//		address of the file name and the line number. Each recorded
+	//		allocation is tagged with the index of a record that holds its
+	//		site and allocation serial number, so that the free can be
+	//		attributed to the site; records are reused after a free.
+	//
+	//		Object lifetime is measured in allocations recorded by the profile
+	//		between allocating and freeing the object; lifetimes are bucketed
+	//		in powers of 16, i.e. [0, 16), [16, 256), [256, 4K), [4K, 64K)
+	//		and [64K, inf).
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryProfile
+	{
+		private:
+
+			// counters of an allocating call site
+			struct SSite
+			{
+				// file name, NULL if entry is unused
+				const CHAR *m_szFile;
+
+				// line in file
+				ULONG m_ulLine;
+
+				// number of allocations
+				ULLONG m_ullAllocs;
+
+				// number of frees
+				ULLONG m_ullFrees;
+
+				// total number of user bytes allocated
+				ULLONG m_ullBytes;
+
+				// user bytes allocated and not yet freed
+				ULLONG m_ullLiveBytes;
+
+				// max value of live bytes
+				ULLONG m_ullPeakLiveBytes;
+
+				// number of freed objects per lifetime bucket
+				ULLONG m_rgullLifetime[GPOS_MEM_PROFILE_LIFETIME_BUCKETS];
+			};
+
+			// record of a live allocation
+			struct SRecord
+			{
+				// user address of allocation, NULL if record is unused
+				const void *m_pv;
+
+				// allocating call site
+				SSite *m_psite;
+
+				// serial number of allocation
+				ULLONG m_ullSerial;
+
+				// tag of next unused record, zero if none
+				ULONG m_ulTagNextFree;
+			};
+
+			// pool for record chunks
+			IMemoryPool *m_pmp;
+
+			// call site table
+			SSite m_rgsite[GPOS_MEM_PROFILE_SITES];
+
+			// entry for sites that do not fit into the table
+			SSite m_siteOverflow;
+
+			// site pointers, used for sorting when printing
+			SSite *m_rgpsite[GPOS_MEM_PROFILE_SITES + 1];
+
+			// number of used entries of the table
+			ULONG m_ulSites;
+
+			// chunks of records
+			SRecord *m_rgprec[GPOS_MEM_PROFILE_RECORD_CHUNKS];
+
+			// number of records carved from chunks
+			ULONG m_ulRecords;
+
+			// tag of first unused record, zero if none
+			ULONG m_ulTagFree;
+
+			// number of recorded allocations
+			ULLONG m_ullSerial;
+
+			// task that activated the profile, NULL if profile is not active
+			ITask *m_ptsk;
+
+			// spinlock protecting the counters
+			CSpinlockOS m_slock;
+
+			// number of active profiles
+			static
+			volatile ULONG_PTR m_ulpActive;
+
+			// find or insert entry of a call site; requires spinlock
+			SSite *PsiteLookup(const CHAR *szFile, ULONG ulLine);
+
+			// record of given tag
+			SRecord *Prec(ULONG ulTag) const
+			{
+				GPOS_ASSERT(0 < ulTag && ulTag <= m_ulRecords);
+
+				const ULONG ulPos = ulTag - 1;
+				return &m_rgprec[ulPos / GPOS_MEM_PROFILE_RECORD_CHUNK][ulPos % GPOS_MEM_PROFILE_RECORD_CHUNK];
+			}
+
+			// tag of an unused record, zero if none is available; requires spinlock
+			ULONG UlTagNew();
+
+			// print a single call site
+			static
+			void PrintSite(IOstream &os, const SSite *psite);
+
+			// comparator of sites, orders by allocated bytes descending
+			static
+			INT ICompareSites(const void *pv1, const void *pv2);
+
+			// lifetime bucket of an object
+			static
+			ULONG UlLifetimeBucket(ULLONG ullLifetime);
+
+			// private copy ctor
+			CMemoryProfile(const CMemoryProfile &);
+
+		public:
+
+			// ctor
+			explicit
+			CMemoryProfile(IMemoryPool *pmp);
+
+			// dtor
+			~CMemoryProfile();
+
+			// start recording allocations of the calling task
+			void Activate();
+
+			// stop recording; counters are kept
+			void Deactivate();
+
+			// is profile active
+			BOOL FActive() const
+			{
+				return NULL != m_ptsk;
+			}
+
+			// record an allocation, return tag to be passed when it is freed
+			ULONG UlRecordAllocation(const void *pv, const CHAR *szFile, ULONG ulLine, ULONG ulBytes);
+
+			// record a free of an object; ignored unless the object was
+			// recorded by this profile
+			void RecordFree(const void *pv, ULONG ulTag, ULONG ulBytes);
+
+			// number of distinct call sites recorded
+			ULONG UlSites();
+
+			// print the call sites with the most allocated bytes;
+			// prints all sites if ulTop is zero
+			IOstream &OsPrint(IOstream &os, ULONG ulTop);
+
+			// profile of the calling task, NULL if its allocations are not profiled
+			static
+			CMemoryProfile *PmprofSelf();
+
+	}; // class CMemoryProfile
+}
+
+#endif // !GPOS_CMemoryProfile_H
+
+// EOF
+
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedString.h
+//
+//	@doc:
+//		Immutable string stored once in the global interned string table
+//---------------------------------------------------------------------------
+#ifndef GPOS_CInternedString_H
+#define GPOS_CInternedString_H
+
+#include "gpos/base.h"
+#include "gpos/common/CList.h"
+#include "gpos/string/CWStringConst.h"
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CInternedString
+	//
+	//	@doc:
+	//		Entry of the interned string table.
+	//
+	//		The string is kept as UTF-8 bytes; a wide copy for consumers of
+	//		CWStringBase is only decoded when it is first asked for. Equal
+	//		strings are interned to the same entry, so two interned strings
+	//		are equal iff they are the same object (or, equivalently, have the
+	//		same id). Entries are reference counted through the table, which
+	//		drops an entry once its last reference is released.
+	//
+	//---------------------------------------------------------------------------
+	class CInternedString
+	{
+		friend class CInternedStringTable;
+
+		public:
+
+			// lookup key: UTF-8 bytes and their length
+			struct SKey
+			{
+				// UTF-8 bytes, not necessarily null terminated
+				const CHAR *m_sz;
+
+				// number of bytes
+				ULONG m_ulLength;
+
+				// hash function
+				static
+				ULONG UlHash(const SKey &key);
+
+				// equality function
+				static
+				BOOL FEqual(const SKey &keyFst, const SKey &keySnd);
+
+				// invalid key
+				static
+				const SKey m_keyInvalid;
+			};
+
+		private:
+
+			// key holding the null terminated UTF-8 bytes
+			SKey m_key;
+
+			// hash of the UTF-8 bytes
+			ULONG m_ulHash;
+
+			// id, unique among the strings of the table
+			ULONG m_ulId;
+
+			// number of references; protected by the lock of the
+			// table's bucket holding the entry
+			ULONG m_ulRefs;
+
+			// wide copy of the string, decoded on first use
+			const CWStringConst * volatile m_pstr;
+
+			// link for the interned string table
+			SLink m_link;
+
+			// ctor
+			CInternedString
+				(
+				const CHAR *sz,
+				ULONG ulLength,
+				ULONG ulHash
+				)
+				:
+				m_ulHash(ulHash),
+				m_ulId(gpos::ulong_max),
+				m_ulRefs(1),
+				m_pstr(NULL)
+			{
+				m_key.m_sz = sz;
+				m_key.m_ulLength = ulLength;
+			}
+
+			// private copy ctor
+			CInternedString(const CInternedString &);
+
+		public:
+
+			// null terminated UTF-8 bytes
+			const CHAR *Sz() const
+			{
+				return m_key.m_sz;
+			}
+
+			// number of UTF-8 bytes
+			ULONG UlLength() const
+			{
+				return m_key.m_ulLength;
+			}
+
+			// hash of the string's contents
+			ULONG UlHash() const
+			{
+				return m_ulHash;
+			}
+
+			// id of the string
+			ULONG UlId() const
+			{
+				return m_ulId;
+			}
+
+			// wide copy of the string; lives as long as the entry
+			const CWStringConst *Pstr() const;
+
+	}; // class CInternedString
+}
+
+#endif // !GPOS_CInternedString_H
+
+// EOF
+
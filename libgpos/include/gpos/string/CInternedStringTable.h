@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedStringTable.h
+//
+//	@doc:
+//		Global table of interned strings
+//---------------------------------------------------------------------------
+#ifndef GPOS_CInternedStringTable_H
+#define GPOS_CInternedStringTable_H
+
+#include "gpos/base.h"
+#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/CSyncHashtableAccessByKey.h"
+#include "gpos/string/CInternedString.h"
+#include "gpos/sync/CSpinlock.h"
+
+// initial number of buckets of the interned string table
+#define GPOS_INTERNED_STRING_HT_SIZE	(1024)
+
+// size of the stack buffer used for encoding short strings
+#define GPOS_INTERNED_STRING_BUFFER	(256)
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CInternedStringTable
+	//
+	//	@doc:
+	//		Global singleton holding every interned string once.
+	//
+	//		Strings are keyed by their UTF-8 encoding; interning a string that
+	//		is already in the table returns the existing entry, so callers
+	//		may compare and hash interned strings by identity. Interning adds
+	//		a reference to the entry which the caller releases once done; an
+	//		entry is dropped with its last reference, so strings of metadata
+	//		that went out of use do not accumulate in long-lived processes.
+	//
+	//---------------------------------------------------------------------------
+	class CInternedStringTable
+	{
+		friend class CInternedString;
+
+		private:
+
+			// global instance
+			static
+			CInternedStringTable *m_pist;
+
+			// memory pool holding the table and its strings
+			IMemoryPool *m_pmp;
+
+			// short hand for the table of strings
+			typedef CSyncHashtable<
+						CInternedString,
+						CInternedString::SKey,
+						CSpinlockOS> StringTable;
+
+			// short hand for table accessor
+			typedef CSyncHashtableAccessByKey<
+						CInternedString,
+						CInternedString::SKey,
+						CSpinlockOS> StringTableAccessor;
+
+			// strings
+			StringTable m_sht;
+
+			// number of strings interned so far; used for assigning ids
+			volatile ULONG_PTR m_ulpStrings;
+
+			// ctor
+			CInternedStringTable(IMemoryPool *pmp);
+
+			// private copy ctor
+			CInternedStringTable(const CInternedStringTable &);
+
+			// lookup UTF-8 bytes, add a new entry if they are not found
+			const CInternedString *PisLookupOrInsert
+				(
+				const CHAR *sz,
+				ULONG ulLength
+				);
+
+			// decode the wide copy of an entry unless another thread did so already
+			void DecodeWide(CInternedString *pis);
+
+			// delete an entry that is no longer in the table
+			static
+			void DeleteEntry(CInternedString *pis);
+
+		public:
+
+			// dtor
+			~CInternedStringTable()
+			{
+				GPOS_ASSERT(NULL == m_pist &&
+							"Interned string table has not been shut down");
+			}
+
+			// initialize global instance
+			static
+			GPOS_RESULT EresInit();
+
+			// destroy global instance
+			void Shutdown();
+
+			// global accessor
+			static
+			CInternedStringTable *Pist()
+			{
+				return m_pist;
+			}
+
+			// intern a wide string; the caller owns a reference to the result
+			const CInternedString *PisIntern(const CWStringBase *pstr);
+
+			// intern a null terminated wide character buffer; the caller owns
+			// a reference to the result
+			const CInternedString *PisIntern(const WCHAR *wsz);
+
+			// add a reference to an interned string
+			void AddRef(const CInternedString *pis);
+
+			// release a reference to an interned string, drop the string
+			// with its last reference
+			void Release(const CInternedString *pis);
+
+			// number of strings interned so far, including dropped ones
+			ULONG UlStrings() const
+			{
+				return (ULONG) m_ulpStrings;
+			}
+
+			// number of bytes needed for the UTF-8 encoding of a wide buffer
+			static
+			ULONG UlUtf8Length(const WCHAR *wsz, ULONG ulLength);
+
+			// encode a wide buffer as UTF-8; the target must be large enough
+			// for UlUtf8Length bytes
+			static
+			void EncodeUtf8(CHAR *sz, const WCHAR *wsz, ULONG ulLength);
+
+			// number of wide characters encoded in UTF-8 bytes
+			static
+			ULONG UlWideLength(const CHAR *sz, ULONG ulLength);
+
+			// decode UTF-8 bytes produced by EncodeUtf8; the target must be
+			// large enough for UlWideLength characters
+			static
+			void DecodeUtf8(WCHAR *wsz, const CHAR *sz, ULONG ulLength);
+
+	}; // class CInternedStringTable
+}
+
+#endif // !GPOS_CInternedStringTable_H
+
+// EOF
+
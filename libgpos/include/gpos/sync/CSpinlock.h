@@ -20,6 +20,9 @@
 //		The acquisition of spinlocks of rank 0 or higher are tracked in the
 //		process context; the implementation is fortified with simple asserts
 //		to prevent self-deadlock;
+//
+//		Contended locks spin with exponential backoff and then park the
+//		waiting thread until the lock is released;
 //---------------------------------------------------------------------------
 #ifndef GPOS_CSpinlock_H
 #define GPOS_CSpinlock_H
@@ -29,8 +32,23 @@
 #include "gpos/task/CWorkerId.h"
 
 #include "gpos/common/CList.h"
+#include "gpos/common/syslibwrapper.h"
 #include "gpos/sync/atomic.h"
 
+// number of spinlock ranks, for which contention is counted
+#define GPOS_SPIN_RANKS		1024
+
+// maximum number of pause instructions between two attempts to acquire
+// a contended lock before the waiting thread is parked
+#define GPOS_SPIN_PAUSE_MAX	1024
+
+// hint to the processor that the thread is spinning
+#if defined(GPOS_i386) || defined(GPOS_i686) || defined(GPOS_x86_64)
+#define GPOS_SPIN_PAUSE()	__asm__ __volatile__ ("pause" ::: "memory")
+#else
+#define GPOS_SPIN_PAUSE()	__asm__ __volatile__ ("" ::: "memory")
+#endif
+
 namespace gpos
 {
 
@@ -50,7 +68,33 @@ namespace gpos
 		
 			// rank of spinlock
 			ULONG m_ulRank;
-		
+
+			// number of contended acquisitions per rank
+			static
+			volatile ULONG_PTR m_rgulpContentions[GPOS_SPIN_RANKS];
+
+		protected:
+
+			// lock states
+			enum ELockState
+			{
+				ElsUnlocked = 0,
+				ElsLocked,
+				ElsContended	// locked, threads may be parked
+			};
+
+			// count a contended acquisition of a lock of given rank
+			static
+			void RecordContention
+				(
+				ULONG ulRank
+				)
+			{
+				GPOS_ASSERT(ulRank < GPOS_SPIN_RANKS);
+
+				(void) UlpExchangeAdd(&m_rgulpContentions[ulRank], 1);
+			}
+
 		public:
 
 			// ctor
@@ -87,6 +131,22 @@ namespace gpos
 			{
 				return m_ulRank;
 			}
+
+			// number of contended acquisitions of locks of given rank
+			static
+			ULONG_PTR UlpContentions
+				(
+				ULONG ulRank
+				)
+			{
+				GPOS_ASSERT(ulRank < GPOS_SPIN_RANKS);
+
+				return m_rgulpContentions[ulRank];
+			}
+
+			// print number of contended acquisitions for all contended ranks
+			static
+			IOstream &OsPrintContentions(IOstream &os);
 			
 #ifdef GPOS_DEBUG
 			// test whether we own the spinlock
@@ -121,11 +181,75 @@ namespace gpos
 		// lock indicator -- lock counter is not usable in asserts
 		BOOL m_fLocked;
 
-		// actual lock counter
-		ULONG_PTR m_ulpLock;
+		// lock state
+		volatile ULONG m_ulLock;
 		
 		// counter for collisions
 		ULONG_PTR m_ulpCollisions;
+
+		// acquire contended lock; spin with exponential backoff first, then
+		// mark the lock as contended and park until it is released
+		void LockContended()
+		{
+			RecordContention(ulRank);
+
+			ULONG ulAttempts = 0;
+			for (ULONG ulPauses = 1; ulPauses <= GPOS_SPIN_PAUSE_MAX; ulPauses *= 2)
+			{
+				ulAttempts++;
+
+				// do not attempt a sync'd update unless the lock is likely to be free
+				if (ElsUnlocked == m_ulLock && FCompareSwap(&m_ulLock, ElsUnlocked, ElsLocked))
+				{
+					gpos::UlpExchangeAdd(&m_ulpCollisions, ulAttempts);
+					return;
+				}
+
+				// assert it is not us who holds the lock
+				GPOS_ASSERT(!FOwned() && "self-deadlock detected");
+
+				for (ULONG ul = 0; ul < ulPauses; ul++)
+				{
+					GPOS_SPIN_PAUSE();
+				}
+			}
+
+			while (true)
+			{
+				ulAttempts++;
+
+				// acquire the lock as contended, since other threads may
+				// still be parked
+				ULONG ulLock = m_ulLock;
+				if (ElsUnlocked == ulLock)
+				{
+					if (FCompareSwap(&m_ulLock, ElsUnlocked, ElsContended))
+					{
+						break;
+					}
+
+					continue;
+				}
+
+				// mark the lock as contended so that the owner wakes us up
+				if (ElsLocked == ulLock && !FCompareSwap(&m_ulLock, ElsLocked, ElsContended))
+				{
+					continue;
+				}
+
+				// park until lock is released; time out periodically to
+				// check for aborts
+				syslib::FutexWait(&m_ulLock, ElsContended, GPOS_SPIN_BACKOFF);
+
+				// non-trackable locks don't know about aborts
+				if (FTrackable())
+				{
+					GPOS_CHECK_ABORT;
+				}
+			}
+
+			gpos::UlpExchangeAdd(&m_ulpCollisions, ulAttempts);
+		}
 		
 	public:
 
@@ -137,9 +261,12 @@ namespace gpos
 			m_wid(false),
 #endif // GPOS_DEBUG
 			m_fLocked(false),
-			m_ulpLock(0), 
+			m_ulLock(ElsUnlocked),
 			m_ulpCollisions(0)
-		{}
+		{
+			// contention is recorded per rank
+			GPOS_CPL_ASSERT(ulRank < GPOS_SPIN_RANKS);
+		}
 		
 		
 		// dtor
@@ -162,54 +289,14 @@ namespace gpos
                             "Tried to acquire spinlock in incorrect order or detected deadlock.");
 #endif // GPOS_DEBUG
 
-            ULONG ulAttempts = 0;
-
-            // attempt getting the lock
-            while(1)
+            // fast path, lock is not contended
+            if (ElsUnlocked != m_ulLock || !FCompareSwap(&m_ulLock, ElsUnlocked, ElsLocked))
             {
-                // do not attempt a sync'd increment unless the counter is likely to be 0
-                if (0 == m_ulpLock)
-                {
-                    // attempt sync'd increment
-                    if (0 == gpos::UlpExchangeAdd(&m_ulpLock, 1))
-                    {
-                        break;
-                    }
-
-                    // count back down
-                    gpos::UlpExchangeAdd(&m_ulpLock, -1);
-                }
-
-                // assert it is not us who holds the lock
-                GPOS_ASSERT(!FOwned() && "self-deadlock detected");
-
-                // trigger a back-off after a certain number of attempts
-                if (ulAttempts++ > GPOS_SPIN_ATTEMPTS)
-                {
-                    // up stats
-                    gpos::UlpExchangeAdd(&m_ulpCollisions, ulAttempts);
-                    ulAttempts = 0;
-
-                    clib::USleep(GPOS_SPIN_BACKOFF);
-
-                    // TODO: 08/02/2009; add warning when burning
-                    // a non-trackable lock; dependent on OPT-87, OPT-86
-
-                    // non-trackable locks don't know about aborts
-                    if (FTrackable())
-                    {
-                        // TODO: 03/09/2008; log that we're burning CPU
-
-                        GPOS_CHECK_ABORT;
-                    }
-                }
+                LockContended();
             }
 
             // got the lock
-            GPOS_ASSERT(m_ulpLock > 0);
-
-            // final update of collision stats
-            gpos::UlpExchangeAdd(&m_ulpCollisions, ulAttempts);
+            GPOS_ASSERT(ElsUnlocked != m_ulLock);
 
 #ifdef GPOS_DEBUG
             if (0 < ulRank && NULL != IWorker::PwrkrSelf())
@@ -235,8 +322,16 @@ namespace gpos
             m_fLocked = false;
 #endif // GPOS_DEBUG
 
-            GPOS_ASSERT(m_ulpLock > 0);
-            gpos::UlpExchangeAdd(&m_ulpLock, -1);
+            GPOS_ASSERT(ElsUnlocked != m_ulLock);
+
+            // wake up a parked thread if the lock was contended
+            if (!FCompareSwap(&m_ulLock, ElsLocked, ElsUnlocked))
+            {
+                GPOS_ASSERT(ElsContended == m_ulLock);
+
+                (void) FCompareSwap(&m_ulLock, ElsContended, ElsUnlocked);
+                syslib::FutexWake(&m_ulLock, 1 /*ulWaiters*/);
+            }
         }
 		
 #ifdef GPOS_DEBUG
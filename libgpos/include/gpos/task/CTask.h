@@ -97,16 +97,30 @@ namespace gpos
 			// task identifier
 			CTaskId m_tid;
 
-			// ctor
-			CTask
+			// ctor; the task is retired until initialized
+			explicit
+			CTask(IMemoryPool *pmp);
+
+			// initialize a retired task for execution
+			void Init
 				(
-				IMemoryPool *pmp,
 				CTaskContext *ptskctxt,
 				IErrorContext *perrctxt,
 				CEvent *pevent,
 				volatile BOOL *pfCancel
 				);
 
+			// release task and error context and TLS of a task that is not
+			// scheduled or has finished, so that the task can be initialized
+			// again; the memory pool is kept
+			void Retire();
+
+			// check if task is retired
+			BOOL FRetired() const
+			{
+				return NULL == m_ptskctxt;
+			}
+
 			// no copy ctor
 			CTask(const CTask&);
 
@@ -286,7 +300,8 @@ namespace gpos
 			// slink for task scheduler
 			SLink m_linkTs;
 
-			// slink for worker pool manager
+			// slink for worker pool manager; links registered tasks in
+			// the task table and retired tasks in the task cache
 			SLink m_linkWpm;
 
 			static
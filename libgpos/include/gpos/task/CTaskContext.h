@@ -18,6 +18,9 @@
 
 namespace gpos
 {
+	// prototypes
+	class CMemoryProfile;
+
 	class CTaskContext
 	{
 		// trace flag iterator needs access to trace vector
@@ -36,6 +39,9 @@ namespace gpos
 			
 			// locale of messages
 			ELocale m_eloc;
+
+			// allocation profile recording allocations of the task
+			CMemoryProfile *m_pmprof;
 			
 		public:
 				
@@ -101,6 +107,20 @@ namespace gpos
 				m_eloc = eloc;
 			}
 
+			// allocation profile, NULL if allocations are not profiled
+			CMemoryProfile *Pmprof() const
+			{
+				return m_pmprof;
+			}
+
+			void SetPmprof
+				(
+				CMemoryProfile *pmprof
+				)
+			{
+				m_pmprof = pmprof;
+			}
+
 			CBitSet *PbsCopyTraceFlags(IMemoryPool *pmp) const
 			{
 				return GPOS_NEW(pmp) CBitSet(pmp, *m_pbs);
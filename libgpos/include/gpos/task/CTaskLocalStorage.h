@@ -55,6 +55,9 @@ namespace gpos
 
 			// reset
 			void Reset(IMemoryPool *pmp);
+
+			// release hash table; TLS must be reset before next use
+			void Cleanup();
 			
 			// accessors
 			void Store(CTaskLocalStorageObject *);
@@ -54,6 +54,13 @@ namespace gpos
 			// start address of current thread's stack
 			const ULONG_PTR m_ulpStackStart;
 
+			// position of the processor the thread is bound to among the
+			// processors of the process, gpos::ulong_max if unbound
+			ULONG m_ulCpu;
+
+			// bind or unbind thread according to worker pool's pinning mode
+			void UpdateCpuBinding();
+
 #ifdef GPOS_DEBUG
 			// currently owned spinlocks
 			CList<CSpinlockBase> m_listSlock;
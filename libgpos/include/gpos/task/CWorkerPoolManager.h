@@ -20,6 +20,7 @@
 #include "gpos/sync/CAtomicCounter.h"
 #include "gpos/sync/CEvent.h"
 #include "gpos/sync/CMutex.h"
+#include "gpos/sync/CSpinlock.h"
 #include "gpos/task/CTask.h"
 #include "gpos/task/CTaskId.h"
 #include "gpos/task/CTaskSchedulerFifo.h"
@@ -30,6 +31,7 @@
 #define GPOS_WORKERPOOL_HT_SIZE 			(1024)				// number of buckets in hash tables
 #define GPOS_WORKER_STACK_SIZE				(500 * 1024)		// max worker stack size
 #define GPOS_WORKERPOOL_MEM_POOL_SIZE 		(2 * 1024 * 1024)	// memory pool size
+#define GPOS_WORKERPOOL_TASK_CACHE_SIZE		(128)				// max number of retired tasks kept for reuse
 
 namespace gpos
 {
@@ -42,6 +44,14 @@ namespace gpos
 	//		maintains WLS (worker local storage);
 	//		assigns tasks to workers;
 	//
+	//		Worker threads outlive the tasks they execute. Task objects are
+	//		kept alive as well: when an ATP releases a task, the task drops
+	//		its contexts and TLS and is cached together with its memory pool,
+	//		so that later ATPs create tasks without setting up a new pool.
+	//		Tasks that leave allocations in their pool are not cached.
+	//		Prewarm() creates worker threads and cached tasks ahead of a
+	//		parallel workload; workers can optionally be pinned to processors.
+	//
 	//------------------------------------------------------------------------
 	class CWorkerPoolManager
 	{	
@@ -94,6 +104,18 @@ namespace gpos
 			CSyncHashtable
 			<CTask, CTaskId, CSpinlockOS> m_shtTS;
 
+			// spinlock protecting the task cache
+			CSpinlockOS m_slockTasksCached;
+
+			// retired tasks kept for reuse
+			CList<CTask> m_listTasksCached;
+
+			// number of cached tasks
+			volatile ULONG_PTR m_ulpTasksCached;
+
+			// are workers pinned to processors
+			volatile BOOL m_fWorkersPinned;
+
 			//-------------------------------------------------------------------
 			// Interface for CAutoTaskProxy
 			//-------------------------------------------------------------------
@@ -124,6 +146,12 @@ namespace gpos
 			// remove task from table
 			CTask *PtskRemoveTask(CTaskId tid);
 
+			// retired task for initialization, taken from cache if available
+			CTask *PtskAcquire();
+
+			// retire task and cache it for reuse, or delete it
+			void ReleaseTask(CTask *ptsk);
+
 			//-------------------------------------------------------------------
 			// Interface for CWorker
 			//-------------------------------------------------------------------
@@ -144,6 +172,12 @@ namespace gpos
 			// create new worker thread
 			void CreateWorkerThread();
 
+			// create retired task with a new memory pool
+			CTask *PtskCreateRetired();
+
+			// add retired task to cache unless cache is full
+			BOOL FCacheTask(CTask *ptsk);
+
 			// lookup given worker
 			CWorker *Pwrkr(CWorkerId wid);
 
@@ -234,6 +268,32 @@ namespace gpos
 			// set max number of workers
 			void SetWorkersMax(volatile ULONG ulWorkersMax);
 
+			// create worker threads and cached tasks for running the given
+			// number of tasks in parallel
+			void Prewarm(ULONG ulTasks);
+
+			// number of cached tasks
+			ULONG UlTasksCached() const
+			{
+				return (ULONG) m_ulpTasksCached;
+			}
+
+			// pin workers to processors, or unpin them; workers apply the
+			// setting before executing their next task
+			void SetWorkersPinned
+				(
+				BOOL fWorkersPinned
+				)
+			{
+				m_fWorkersPinned = fWorkersPinned;
+			}
+
+			// are workers pinned to processors
+			BOOL FWorkersPinned() const
+			{
+				return m_fWorkersPinned;
+			}
+
 			// check if given thread is owned by running threads list
 			BOOL FOwnedThread
 				(
@@ -48,6 +48,9 @@ namespace gpos
 		// print exception on raise to stderr
 		EtracePrintExceptionOnRaise = 104,
 
+		// put per-thread caches in front of thread-safe tracker pools
+		EtraceThreadCacheMemoryPools = 105,
+
 		EtraceSentinel
 	};
 }
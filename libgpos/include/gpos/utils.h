@@ -55,6 +55,10 @@
 #define	ALIGN_STORAGE __attribute__((aligned (8)))
 #endif
 
+// size of a cache line; used to keep frequently written data of different
+// threads apart
+#define GPOS_CACHE_LINE_SIZE	64
+
 #define GPOS_GET_FRAME_POINTER(x) do { ULONG_PTR ulp; GPOS_ASMFP; x = ulp; } while (0)
 #define GPOS_GET_STACK_POINTER(x) do { ULONG_PTR ulp; GPOS_ASMSP; x = ulp; } while (0)
 
@@ -34,6 +34,7 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_Ownership();
 			static GPOS_RESULT EresUnittest_ArrayAppend();
 			static GPOS_RESULT EresUnittest_ArrayAppendExactFit();
+			static GPOS_RESULT EresUnittest_Inline();
 			static GPOS_RESULT EresUnittest_PdrgpulSubsequenceIndexes();
 
 			// destructor function for char's
@@ -32,6 +32,10 @@ namespace gpos
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basic();
 			static GPOS_RESULT EresUnittest_Ownership();
+			static GPOS_RESULT EresUnittest_Growth();
+
+			// hash function returning the key itself
+			static ULONG UlHashIdentity(const ULONG *pul);
 
 	}; // class CHashMapTest
 }
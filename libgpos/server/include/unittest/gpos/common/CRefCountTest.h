@@ -73,6 +73,7 @@ namespace gpos
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_CountUpAndDown();
 			static GPOS_RESULT EresUnittest_DeletableObjects();
+			static GPOS_RESULT EresUnittest_SingleThreaded();
 
 #ifdef GPOS_DEBUG
 			static GPOS_RESULT EresUnittest_Stack();
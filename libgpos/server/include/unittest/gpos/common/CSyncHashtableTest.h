@@ -304,6 +304,7 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_NonConcurrentIteration();
 			static GPOS_RESULT EresUnittest_ConcurrentIteration();
 			static GPOS_RESULT EresUnittest_Concurrency();
+			static GPOS_RESULT EresUnittest_Growth();
 
 
 #ifdef GPOS_DEBUG
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSyncSegmentedArrayTest.h
+//
+//	@doc:
+//		Tests for CSyncSegmentedArray
+//---------------------------------------------------------------------------
+#ifndef GPOS_CSyncSegmentedArrayTest_H
+#define GPOS_CSyncSegmentedArrayTest_H
+
+#include "gpos/types.h"
+#include "gpos/common/CSyncSegmentedArray.h"
+#include "gpos/task/CAutoTaskProxy.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CSyncSegmentedArrayTest
+	//
+	//	@doc:
+	//		Static unit tests for segmented array
+	//
+	//---------------------------------------------------------------------------
+	class CSyncSegmentedArrayTest
+	{
+		private:
+
+			// collection of parameters for parallel tasks
+			struct SArg
+			{
+				// array to append to
+				CSyncSegmentedArray<ULONG> *m_psar;
+
+				// elements to append; each task appends a disjoint range
+				ULONG *m_rgul;
+
+				// number of elements per task
+				ULONG m_ulElems;
+
+				// index of next task's range
+				volatile ULONG_PTR m_ulpTask;
+
+				// ctor
+				SArg
+					(
+					CSyncSegmentedArray<ULONG> *psar,
+					ULONG *rgul,
+					ULONG ulElems
+					)
+					:
+					m_psar(psar),
+					m_rgul(rgul),
+					m_ulElems(ulElems),
+					m_ulpTask(0)
+				{}
+			};
+
+			// stress function
+			static void *RunAppend(void *pv);
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Basics();
+			static GPOS_RESULT EresUnittest_Concurrency();
+
+	}; // class CSyncSegmentedArrayTest
+}
+
+
+#endif // !GPOS_CSyncSegmentedArrayTest_H
+
+// EOF
@@ -39,6 +39,7 @@ namespace gpos
 #ifdef GPOS_DEBUG
 			static GPOS_RESULT EresLeak(CMemoryPoolManager::EAllocType eat);
 			static GPOS_RESULT EresLeakByException(CMemoryPoolManager::EAllocType eat);
+			static GPOS_RESULT EresTestSlabLeak();
 #endif // GPOS_DEBUG
 			static GPOS_RESULT EresConcurrency(CMemoryPoolManager::EAllocType eat);
 			static GPOS_RESULT EresStress(CMemoryPoolManager::EAllocType eat);
@@ -60,6 +61,16 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_TestTracker();
 			static GPOS_RESULT EresUnittest_TestSlab();
 			static GPOS_RESULT EresUnittest_TestStack();
+			static GPOS_RESULT EresUnittest_TestStackRecycle();
+			static GPOS_RESULT EresUnittest_TestStackChurn();
+			static GPOS_RESULT EresUnittest_TestArena();
+			static GPOS_RESULT EresUnittest_TestThreadCache();
+			static GPOS_RESULT EresUnittest_TestThreadCacheTracker();
+			static GPOS_RESULT EresUnittest_TestThreadCacheSlots();
+			static GPOS_RESULT EresUnittest_TestProfile();
+			static GPOS_RESULT EresUnittest_TestHugePage();
+			static GPOS_RESULT EresUnittest_TestHugePageChurn();
+			static GPOS_RESULT EresUnittest_TestRegion();
 
 	}; // class CMemoryPoolBasicTest
 }
@@ -0,0 +1,39 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedStringTableTest.h
+//
+//	@doc:
+//		Tests for the interned string table
+//---------------------------------------------------------------------------
+#ifndef GPOS_CInternedStringTableTest_H
+#define GPOS_CInternedStringTableTest_H
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CInternedStringTableTest
+	//
+	//	@doc:
+	//		Unittests for interned strings
+	//
+	//---------------------------------------------------------------------------
+	class CInternedStringTableTest
+	{
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Intern();
+			static GPOS_RESULT EresUnittest_Release();
+			static GPOS_RESULT EresUnittest_Utf8();
+	}; // class CInternedStringTableTest
+}
+
+#endif // !GPOS_CInternedStringTableTest_H
+
+// EOF
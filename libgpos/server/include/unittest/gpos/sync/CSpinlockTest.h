@@ -11,6 +11,8 @@
 #ifndef GPOS_CSpinlockTest_H
 #define GPOS_CSpinlockTest_H
 
+#include "gpos/sync/CSpinlock.h"
+
 namespace gpos
 {
 	//---------------------------------------------------------------------------
@@ -24,6 +26,33 @@ namespace gpos
 	class CSpinlockTest
 	{
 
+		private:
+
+			// state shared between lock holder and test driver
+			struct SContention
+			{
+				// lock to hold
+				CSpinlockDummy *m_pslock;
+
+				// set when holder has acquired the lock
+				volatile BOOL m_fLocked;
+
+				// set when holder has observed contention of the lock
+				volatile BOOL m_fContended;
+
+				// ctor
+				explicit
+				SContention
+					(
+					CSpinlockDummy *pslock
+					)
+					:
+					m_pslock(pslock),
+					m_fLocked(false),
+					m_fContended(false)
+				{}
+			};
+
 		public:
 
 			// unittests
@@ -32,6 +61,8 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_LockRelease();
 			static GPOS_RESULT EresUnittest_Concurrency();
 			static void *PvUnittest_ConcurrencyRun(void *);
+			static GPOS_RESULT EresUnittest_Contention();
+			static void *PvUnittest_ContentionRun(void *);
 #ifdef GPOS_DEBUG
 			static GPOS_RESULT EresUnittest_SelfDeadlock();
 			static GPOS_RESULT EresUnittest_LockedDestruction();
@@ -68,6 +68,7 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_PropagateExecError();
 			static GPOS_RESULT EresUnittest_ExecuteError();
 			static GPOS_RESULT EresUnittest_CheckErrorPropagation();
+			static GPOS_RESULT EresUnittest_Reuse();
 
 			// propagate error with/without cancel by specific value
 			// need to access the private method of CTask
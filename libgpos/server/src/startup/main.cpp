@@ -38,6 +38,7 @@
 #include "unittest/gpos/common/CStackTest.h"
 #include "unittest/gpos/common/CSyncHashtableTest.h"
 #include "unittest/gpos/common/CSyncListTest.h"
+#include "unittest/gpos/common/CSyncSegmentedArrayTest.h"
 
 #include "unittest/gpos/error/CErrorHandlerTest.h"
 #include "unittest/gpos/error/CExceptionTest.h"
@@ -64,6 +65,7 @@
 #include "unittest/gpos/sync/CMutexTest.h"
 #include "unittest/gpos/sync/CSpinlockTest.h"
 
+#include "unittest/gpos/string/CInternedStringTableTest.h"
 #include "unittest/gpos/string/CStringTest.h"
 #include "unittest/gpos/string/CWStringTest.h"
 
@@ -98,6 +100,7 @@ static gpos::CUnittest rgut[] =
 	GPOS_UNITTEST_STD(CStackTest),
 	GPOS_UNITTEST_STD(CSyncHashtableTest),
 	GPOS_UNITTEST_STD(CSyncListTest),
+	GPOS_UNITTEST_STD(CSyncSegmentedArrayTest),
 
 	// error
 	GPOS_UNITTEST_STD(CErrorHandlerTest),
@@ -123,6 +126,7 @@ static gpos::CUnittest rgut[] =
 	// string
 	GPOS_UNITTEST_STD(CWStringTest),
 	GPOS_UNITTEST_STD(CStringTest),
+	GPOS_UNITTEST_STD(CInternedStringTableTest),
 
 	// sync
 	GPOS_UNITTEST_STD(CAutoMutexTest),
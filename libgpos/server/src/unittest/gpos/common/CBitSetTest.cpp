@@ -14,6 +14,7 @@
 #include "gpos/string/CWStringDynamic.h"
 
 #include "gpos/common/CBitSet.h"
+#include "gpos/common/CBitSetIter.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
@@ -37,6 +38,7 @@ CBitSetTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Basics),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Removal),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_SetOps),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Sparse),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Performance)
 		};
 
@@ -132,7 +134,7 @@ CBitSetTest::EresUnittest_Removal()
 
 	for (ULONG i = 0; i < cInserts; i++)
 	{
-		// cleans up empty links
+		// trims clear words
 		pbs->FExchangeClear(i * cSizeBits);
 
 		GPOS_ASSERT(cInserts - i - 1 == pbs->CElements());
@@ -211,6 +213,89 @@ CBitSetTest::EresUnittest_SetOps()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Sparse
+//
+//	@doc:
+//		Test for sets with distant bits, which grow their words at both
+//		ends and spill from inline storage
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Sparse()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG rgulBits[] = {5000, 4999, 63, 64, 4096, 1000};
+	const ULONG ulBits = GPOS_ARRAY_SIZE(rgulBits);
+
+	CBitSet *pbs1 = GPOS_NEW(pmp) CBitSet(pmp);
+	CBitSet *pbs2 = GPOS_NEW(pmp) CBitSet(pmp);
+	for (ULONG ul = 0; ul < ulBits; ul++)
+	{
+		// insert in opposite orders
+		(void) pbs1->FExchangeSet(rgulBits[ul]);
+		(void) pbs2->FExchangeSet(rgulBits[ulBits - ul - 1]);
+	}
+
+	GPOS_ASSERT(ulBits == pbs1->CElements());
+	GPOS_ASSERT(pbs1->FEqual(pbs2));
+	GPOS_ASSERT(pbs1->UlHash() == pbs2->UlHash());
+	GPOS_ASSERT(!pbs1->FBit(0) && !pbs1->FBit(65) && !pbs1->FBit(5001));
+
+#ifdef GPOS_DEBUG
+	// bits are visited in ascending order
+	CBitSetIter bsiter(*pbs1);
+	ULONG ulPrev = 0;
+	ULONG ulVisited = 0;
+	while (bsiter.FAdvance())
+	{
+		GPOS_ASSERT_IMP(0 < ulVisited, ulPrev < bsiter.UlBit());
+		ulPrev = bsiter.UlBit();
+		ulVisited++;
+	}
+	GPOS_ASSERT(ulBits == ulVisited);
+#endif // GPOS_DEBUG
+
+	// clearing the lowest and highest bits trims the set
+	(void) pbs2->FExchangeClear(63);
+	(void) pbs2->FExchangeClear(5000);
+
+	CBitSet *pbs = GPOS_NEW(pmp) CBitSet(pmp);
+	(void) pbs->FExchangeSet(64);
+	(void) pbs->FExchangeSet(1000);
+	(void) pbs->FExchangeSet(4096);
+	(void) pbs->FExchangeSet(4999);
+
+	GPOS_ASSERT(pbs->FEqual(pbs2));
+	GPOS_ASSERT(pbs->UlHash() == pbs2->UlHash());
+	GPOS_ASSERT(pbs1->FSubset(pbs2) && !pbs2->FSubset(pbs1));
+
+	// intersect and subtract sets with partly overlapping words
+	CBitSet *pbsLow = GPOS_NEW(pmp) CBitSet(pmp);
+	(void) pbsLow->FExchangeSet(1);
+	(void) pbsLow->FExchangeSet(64);
+
+	GPOS_ASSERT(!pbsLow->FDisjoint(pbs));
+	pbs->Intersection(pbsLow);
+	GPOS_ASSERT(1 == pbs->CElements() && pbs->FBit(64));
+
+	pbs2->Difference(pbs);
+	GPOS_ASSERT(3 == pbs2->CElements() && !pbs2->FBit(64));
+	GPOS_ASSERT(pbs2->FDisjoint(pbsLow));
+
+	pbsLow->Release();
+	pbs->Release();
+	pbs2->Release();
+	pbs1->Release();
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSetTest::EresUnittest_Performance
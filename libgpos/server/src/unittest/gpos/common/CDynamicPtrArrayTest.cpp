@@ -36,6 +36,7 @@ CDynamicPtrArrayTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CDynamicPtrArrayTest::EresUnittest_Ownership),
 		GPOS_UNITTEST_FUNC(CDynamicPtrArrayTest::EresUnittest_ArrayAppend),
 		GPOS_UNITTEST_FUNC(CDynamicPtrArrayTest::EresUnittest_ArrayAppendExactFit),
+		GPOS_UNITTEST_FUNC(CDynamicPtrArrayTest::EresUnittest_Inline),
 		GPOS_UNITTEST_FUNC(CDynamicPtrArrayTest::EresUnittest_PdrgpulSubsequenceIndexes),
 		};
 
@@ -286,6 +287,64 @@ CDynamicPtrArrayTest::EresUnittest_ArrayAppendExactFit()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDynamicPtrArrayTest::EresUnittest_Inline
+//
+//	@doc:
+//		Arrays allocate only once their elements do not fit into inline
+//		storage
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDynamicPtrArrayTest::EresUnittest_Inline()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	typedef CDynamicPtrArray<ULONG, CleanupNULL<ULONG>, 2 /*ulInline*/> DrgULONG;
+
+	ULONG rgul[] = {5, 4, 3, 2, 1};
+	const ULONG ulCnt = GPOS_ARRAY_SIZE(rgul);
+
+	DrgULONG *pdrgULONG1 = GPOS_NEW(pmp) DrgULONG(pmp);
+	DrgULONG *pdrgULONG2 = GPOS_NEW(pmp) DrgULONG(pmp);
+
+#ifdef GPOS_DEBUG
+	const ULLONG ullAllocated = pmp->UllTotalAllocatedSize();
+#endif // GPOS_DEBUG
+
+	// fill both arrays up to their inline storage
+	pdrgULONG1->Append(&rgul[0]);
+	pdrgULONG1->Append(&rgul[1]);
+	pdrgULONG2->Append(&rgul[2]);
+	GPOS_ASSERT(ullAllocated == pmp->UllTotalAllocatedSize());
+
+	// move elements to allocated storage
+	pdrgULONG1->AppendArray(pdrgULONG2);
+	pdrgULONG1->Append(&rgul[3]);
+	pdrgULONG1->Append(&rgul[4]);
+	GPOS_ASSERT(ullAllocated < pmp->UllTotalAllocatedSize());
+
+	GPOS_ASSERT(ulCnt == pdrgULONG1->UlLength());
+	for (ULONG ul = 0; ul < ulCnt; ul++)
+	{
+		GPOS_ASSERT(&rgul[ul] == (*pdrgULONG1)[ul]);
+	}
+
+	pdrgULONG2->Append(&rgul[3]);
+	pdrgULONG2->Sort();
+	GPOS_ASSERT(pdrgULONG2->FSorted());
+	GPOS_ASSERT(&rgul[2] == pdrgULONG2->PtLookup(&rgul[2]));
+
+	pdrgULONG1->Release();
+	pdrgULONG2->Release();
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDynamicPtrArrayTest::EresUnittest_PdrgpulSubsequenceIndexes
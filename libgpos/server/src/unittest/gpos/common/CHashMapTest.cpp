@@ -11,6 +11,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
@@ -33,6 +34,7 @@ CHashMapTest::EresUnittest()
 		{
 		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Basic),
 		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Ownership),
+		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Growth),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -186,5 +188,89 @@ CHashMapTest::EresUnittest_Ownership()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CHashMapTest::UlHashIdentity
+//
+//	@doc:
+//		Hash function returning the key itself
+//
+//---------------------------------------------------------------------------
+ULONG
+CHashMapTest::UlHashIdentity
+	(
+	const ULONG *pul
+	)
+{
+	return *pul;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHashMapTest::EresUnittest_Growth
+//
+//	@doc:
+//		Grow a map created with a small size beyond its size, using a hash
+//		function that leaves the low bits constant; entries are found and
+//		iterated in insertion order afterwards
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CHashMapTest::EresUnittest_Growth()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulCnt = 1000;
+
+	typedef CHashMap<ULONG, ULONG, CHashMapTest::UlHashIdentity, gpos::FEqual<ULONG>,
+		CleanupDelete<ULONG>, CleanupDelete<ULONG> > HMUlUl;
+
+	HMUlUl *phm = GPOS_NEW(pmp) HMUlUl(pmp, 4);
+	for (ULONG i = 0; i < ulCnt; ++i)
+	{
+		// insert keys in descending order
+		ULONG *pulKey = GPOS_NEW(pmp) ULONG((ulCnt - i) * 1024);
+		ULONG *pulVal = GPOS_NEW(pmp) ULONG(i);
+
+#ifdef GPOS_DEBUG
+		BOOL fSuccess =
+#endif // GPOS_DEBUG
+			phm->FInsert(pulKey, pulVal);
+		GPOS_ASSERT(fSuccess);
+	}
+	GPOS_ASSERT(ulCnt == phm->UlEntries());
+
+#ifdef GPOS_DEBUG
+	for (ULONG i = 0; i < ulCnt; ++i)
+	{
+		ULONG ulKey = (ulCnt - i) * 1024;
+		GPOS_ASSERT(i == *phm->PtLookup(&ulKey));
+
+		ulKey++;
+		GPOS_ASSERT(NULL == phm->PtLookup(&ulKey));
+	}
+
+	typedef CHashMapIter<ULONG, ULONG, CHashMapTest::UlHashIdentity, gpos::FEqual<ULONG>,
+		CleanupDelete<ULONG>, CleanupDelete<ULONG> > HMIterUlUl;
+
+	ULONG ulVisited = 0;
+	HMIterUlUl hmiter(phm);
+	while (hmiter.FAdvance())
+	{
+		GPOS_ASSERT(ulVisited == *hmiter.Pt());
+		GPOS_ASSERT((ulCnt - ulVisited) * 1024 == *hmiter.Pk());
+		ulVisited++;
+	}
+	GPOS_ASSERT(ulCnt == ulVisited);
+#endif // GPOS_DEBUG
+
+	phm->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
 
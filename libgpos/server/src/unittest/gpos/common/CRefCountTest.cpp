@@ -34,7 +34,8 @@ CRefCountTest::EresUnittest()
 	CUnittest rgut[] =
 		{
 		GPOS_UNITTEST_FUNC(CRefCountTest::EresUnittest_CountUpAndDown),
-		GPOS_UNITTEST_FUNC(CRefCountTest::EresUnittest_DeletableObjects)
+		GPOS_UNITTEST_FUNC(CRefCountTest::EresUnittest_DeletableObjects),
+		GPOS_UNITTEST_FUNC(CRefCountTest::EresUnittest_SingleThreaded)
 
 #ifdef GPOS_DEBUG
 		,
@@ -128,6 +129,64 @@ CRefCountTest::EresUnittest_DeletableObjects()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CRefCountTest::EresUnittest_SingleThreaded
+//
+//	@doc:
+//		Objects created as single-threaded are counted without atomic
+//		operations; objects are shared by default and may be switched
+//		while unshared
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CRefCountTest::EresUnittest_SingleThreaded()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CRefCount *prefShared = GPOS_NEW(pmp) CRefCount;
+	CRefCount *prefLocal = GPOS_NEW(pmp) CRefCount(true /*fSingleThreaded*/);
+
+	for (ULONG i = 0; i < 10; i++)
+	{
+		prefLocal->AddRef();
+	}
+
+	for (ULONG i = 0; i < 10; i++)
+	{
+		prefLocal->Release();
+	}
+
+	BOOL fCorrect =
+		!prefShared->FSingleThreaded() &&
+		prefLocal->FSingleThreaded() &&
+		1 == prefLocal->UlpRefCount();
+
+	// an object is only switched while the caller holds its only reference
+	prefShared->AddRef();
+	CRefCount::SafeSetSingleThreaded(prefShared);
+	fCorrect = fCorrect && !prefShared->FSingleThreaded();
+
+	prefShared->Release();
+	CRefCount::SafeSetSingleThreaded(prefShared);
+	fCorrect = fCorrect && prefShared->FSingleThreaded() && 1 == prefShared->UlpRefCount();
+
+	// the flag shares the word of the counter
+	fCorrect = fCorrect && sizeof(CRefCount) == sizeof(void *) + sizeof(ULONG_PTR);
+
+	prefLocal->Release();
+	prefShared->Release();
+
+	if (!fCorrect)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 #ifdef GPOS_DEBUG
 
 //---------------------------------------------------------------------------
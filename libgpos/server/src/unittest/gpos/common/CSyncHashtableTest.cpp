@@ -33,6 +33,7 @@ using namespace gpos;
 #define GPOS_SHT_INITIAL_ELEMENTS	(1 + GPOS_SHT_ELEMENTS / 2)
 #define GPOS_SHT_ELEMENT_DUPLICATES		5
 #define GPOS_SHT_THREADS	15
+#define GPOS_SHT_GROWTH_ELEMENTS	1000
 
 
 // invalid key
@@ -61,7 +62,8 @@ CSyncHashtableTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_SameKeyIteration),
 		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_NonConcurrentIteration),
 		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_ConcurrentIteration),
-		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_Concurrency)
+		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_Concurrency),
+		GPOS_UNITTEST_FUNC(CSyncHashtableTest::EresUnittest_Growth)
 
 #ifdef GPOS_DEBUG
 		,
@@ -896,6 +898,87 @@ CSyncHashtableTest::PvUnittest_Inserter
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSyncHashtableTest::EresUnittest_Growth
+//
+//	@doc:
+//		Insert many more elements than buckets; hashtable must grow
+//		and keep all elements accessible
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSyncHashtableTest::EresUnittest_Growth()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	SElem *rgelem = GPOS_NEW_ARRAY(pmp, SElem, GPOS_SHT_GROWTH_ELEMENTS);
+
+	// scope for hashtable
+	{
+		SElemHashtable sht;
+		sht.Init
+			(
+			pmp,
+			GPOS_SHT_SMALL_BUCKETS,
+			GPOS_OFFSET(SElem, m_link),
+			GPOS_OFFSET(SElem, m_ulKey),
+			&(SElem::m_ulInvalid),
+			SElem::UlHash,
+			SElem::FEqualKeys
+			);
+
+		const ULONG cBuckets = sht.UlBuckets();
+
+		// insert half of the elements directly and half through accessors
+		for (ULONG i = 0; i < GPOS_SHT_GROWTH_ELEMENTS; i++)
+		{
+			rgelem[i] = SElem(i, i);
+
+			if (0 == i % 2)
+			{
+				sht.Insert(&rgelem[i]);
+			}
+			else
+			{
+				SElemHashtableAccessor shtacc(sht, rgelem[i].m_ulKey);
+				shtacc.Insert(&rgelem[i]);
+			}
+		}
+
+		if (sht.UlBuckets() <= cBuckets ||
+			GPOS_SHT_GROWTH_ELEMENTS != sht.UlpEntries())
+		{
+			GPOS_DELETE_ARRAY(rgelem);
+			return GPOS_FAILED;
+		}
+
+		// all elements must be found in their buckets and can be removed
+		for (ULONG i = 0; i < GPOS_SHT_GROWTH_ELEMENTS; i++)
+		{
+			SElemHashtableAccessor shtacc(sht, rgelem[i].m_ulKey);
+
+			SElem *pelem = shtacc.PtLookup();
+			if (&rgelem[i] != pelem)
+			{
+				GPOS_DELETE_ARRAY(rgelem);
+				return GPOS_FAILED;
+			}
+
+			shtacc.Remove(pelem);
+		}
+
+		GPOS_ASSERT(0 == sht.UlpEntries());
+	}
+
+	GPOS_DELETE_ARRAY(rgelem);
+
+	return GPOS_OK;
+}
+
+
 #ifdef GPOS_DEBUG
 //---------------------------------------------------------------------------
 //	@function:
@@ -0,0 +1,243 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSyncSegmentedArrayTest.cpp
+//
+//	@doc:
+//		Tests for CSyncSegmentedArray
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/task/CAutoTaskProxy.h"
+#include "gpos/task/CWorkerPoolManager.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/common/CSyncSegmentedArrayTest.h"
+
+#define GPOS_SSARR_SIZE 1000
+#define GPOS_SSARR_FIRST_BITS 2
+#define GPOS_SSARR_STRESS_TASKS 10
+#define GPOS_SSARR_STRESS_ITER 50000
+#define GPOS_SSARR_STRESS_CFA 1000
+
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSyncSegmentedArrayTest::EresUnittest
+//
+//	@doc:
+//		Unittest for segmented array
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSyncSegmentedArrayTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CSyncSegmentedArrayTest::EresUnittest_Basics),
+		GPOS_UNITTEST_FUNC(CSyncSegmentedArrayTest::EresUnittest_Concurrency),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSyncSegmentedArrayTest::EresUnittest_Basics
+//
+//	@doc:
+//		Append elements and check that they are found at their positions
+//		and that slots do not move while the array grows; publish an
+//		element at a reserved slot, remove an element, and install the
+//		next slot ahead
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSyncSegmentedArrayTest::EresUnittest_Basics()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG rgul[GPOS_SSARR_SIZE];
+	CSyncSegmentedArray<ULONG> sar(pmp, GPOS_SSARR_FIRST_BITS);
+	GPOS_ASSERT(0 == sar.UlpSize());
+
+	ULONG * const *rgppulSlot[GPOS_SSARR_SIZE];
+	for (ULONG ul = 0; ul < GPOS_SSARR_SIZE; ul++)
+	{
+		rgul[ul] = ul;
+
+#ifdef GPOS_DEBUG
+		ULONG_PTR ulpPos =
+#endif // GPOS_DEBUG
+			sar.UlpAppend(&rgul[ul]);
+
+		GPOS_ASSERT(ul == ulpPos);
+		GPOS_ASSERT(ul + 1 == sar.UlpSize());
+
+		rgppulSlot[ul] = sar.PptSlot(ul);
+	}
+
+	for (ULONG ul = 0; ul < GPOS_SSARR_SIZE; ul++)
+	{
+		if (&rgul[ul] != sar[ul] || rgppulSlot[ul] != sar.PptSlot(ul))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	// a reserved slot is empty until published
+	ULONG ulReserved = GPOS_SSARR_SIZE;
+	const ULONG_PTR ulpReserved = sar.UlpReserve();
+	if (GPOS_SSARR_SIZE != ulpReserved || NULL != sar[ulpReserved])
+	{
+		return GPOS_FAILED;
+	}
+
+	sar.Publish(ulpReserved, &ulReserved);
+	if (&ulReserved != sar[ulpReserved])
+	{
+		return GPOS_FAILED;
+	}
+
+	// a removed element leaves an empty slot behind
+	sar.Remove(0);
+	if (NULL != sar[0] || &rgul[1] != sar[1] || GPOS_SSARR_SIZE + 1 != sar.UlpSize())
+	{
+		return GPOS_FAILED;
+	}
+
+	// the next slot is installed ahead of appending
+	sar.InstallNext();
+	if (!sar.FNextInstalled())
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSyncSegmentedArrayTest::EresUnittest_Concurrency
+//
+//	@doc:
+//		Append elements from parallel tasks and check that every element
+//		was added exactly once
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSyncSegmentedArrayTest::EresUnittest_Concurrency()
+{
+#ifdef GPOS_DEBUG
+	if (IWorker::m_fEnforceTimeSlices)
+	{
+		return GPOS_OK;
+	}
+#endif // GPOS_DEBUG
+
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulElems = GPOS_SSARR_STRESS_TASKS * GPOS_SSARR_STRESS_ITER;
+
+	CAutoRg<ULONG> a_rgul;
+	a_rgul = GPOS_NEW_ARRAY(pmp, ULONG, ulElems);
+	CAutoRg<BOOL> a_rgfSeen;
+	a_rgfSeen = GPOS_NEW_ARRAY(pmp, BOOL, ulElems);
+	for (ULONG ul = 0; ul < ulElems; ul++)
+	{
+		a_rgul[ul] = ul;
+		a_rgfSeen[ul] = false;
+	}
+
+	CSyncSegmentedArray<ULONG> sar(pmp, GPOS_SSARR_FIRST_BITS);
+	SArg arg(&sar, a_rgul.Rgt(), GPOS_SSARR_STRESS_ITER);
+
+	// scope for tasks
+	{
+		CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+		CAutoTaskProxy atp(pmp, pwpm);
+		CTask *rgptsk[GPOS_SSARR_STRESS_TASKS];
+
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgptsk); ul++)
+		{
+			rgptsk[ul] = atp.PtskCreate(RunAppend, &arg);
+		}
+
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgptsk); ul++)
+		{
+			atp.Schedule(rgptsk[ul]);
+		}
+
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgptsk); ul++)
+		{
+			GPOS_CHECK_ABORT;
+
+			atp.Wait(rgptsk[ul]);
+		}
+	}
+
+	if (ulElems != sar.UlpSize())
+	{
+		return GPOS_FAILED;
+	}
+
+	for (ULONG ul = 0; ul < ulElems; ul++)
+	{
+		ULONG *pul = sar[ul];
+		if (NULL == pul || a_rgfSeen[*pul])
+		{
+			return GPOS_FAILED;
+		}
+
+		a_rgfSeen[*pul] = true;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSyncSegmentedArrayTest::RunAppend
+//
+//	@doc:
+//		Append a range of elements to the array
+//
+//---------------------------------------------------------------------------
+void *
+CSyncSegmentedArrayTest::RunAppend
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	SArg *parg = reinterpret_cast<SArg *>(pv);
+	const ULONG_PTR ulpTask = UlpExchangeAdd(&parg->m_ulpTask, 1);
+	ULONG *rgul = parg->m_rgul + ulpTask * parg->m_ulElems;
+
+	for (ULONG ul = 0; ul < parg->m_ulElems; ul++)
+	{
+		if (0 == ul % GPOS_SSARR_STRESS_CFA)
+		{
+			GPOS_CHECK_ABORT;
+		}
+
+		(void) parg->m_psar->UlpAppend(&rgul[ul]);
+	}
+
+	return NULL;
+}
+
+
+// EOF
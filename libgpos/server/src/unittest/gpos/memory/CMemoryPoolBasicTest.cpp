@@ -11,11 +11,19 @@
 
 #include "gpos/assert.h"
 #include "gpos/common/clibwrapper.h"
+#include "gpos/common/syslibwrapper.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/error/CErrorHandlerStandard.h"
 #include "gpos/error/CException.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/memory/CAutoMemoryPoolRegion.h"
+#include "gpos/memory/CMemoryPoolHugePage.h"
+#include "gpos/memory/CMemoryProfile.h"
+#include "gpos/memory/CMemoryPoolRegion.h"
+#include "gpos/memory/CMemoryPoolSlab.h"
+#include "gpos/memory/CMemoryPoolStack.h"
+#include "gpos/memory/CMemoryPoolThreadCache.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/task/CAutoTaskProxy.h"
@@ -64,6 +72,17 @@ CMemoryPoolBasicTest::EresUnittest()
 #endif // GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker),
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestStack),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestStackRecycle),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestStackChurn),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestArena),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestThreadCache),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestThreadCacheTracker),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestThreadCacheSlots),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestProfile),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestHugePage),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestHugePageChurn),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestRegion),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestSlab),
 		};
 
 	CAutoTraceFlag atf(EtraceTestMemoryPools, true /*fVal*/);
@@ -131,6 +150,588 @@ CMemoryPoolBasicTest::EresUnittest_TestStack()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestStackRecycle
+//
+//	@doc:
+//		Check that stack pool recycles small allocations after free
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestStackRecycle()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmpUnderlying = amp.Pmp();
+
+	CMemoryPoolStack mps(pmpUnderlying, gpos::ullong_max, false /*fThreadSafe*/, false /*fOwnsUnderlying*/);
+
+	// small allocations of the same size class share memory after free
+	void *pvFst = mps.PvAllocate(GPOS_MEM_TEST_ALLOC_SMALL * 3, __FILE__, __LINE__);
+	const ULLONG ullReserved = mps.UllTotalAllocatedSize();
+	mps.Free(pvFst);
+	void *pvSnd = mps.PvAllocate(GPOS_MEM_TEST_ALLOC_SMALL * 4, __FILE__, __LINE__);
+	BOOL fRecycled = (pvFst == pvSnd && ullReserved == mps.UllTotalAllocatedSize());
+
+	// large allocations are not recycled
+	void *pvLarge = mps.PvAllocate(GPOS_MEM_TEST_ALLOC_LARGE * 4, __FILE__, __LINE__);
+	mps.Free(pvLarge);
+	BOOL fLargeRecycled = (pvLarge == mps.PvAllocate(GPOS_MEM_TEST_ALLOC_LARGE * 4, __FILE__, __LINE__));
+
+	mps.TearDown();
+
+	if (!fRecycled || fLargeRecycled)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestStackChurn
+//
+//	@doc:
+//		Check that repeated rounds of small allocations that are freed at
+//		the end of each round, as done by transformation jobs in the
+//		scheduler's local pool, do not grow the stack pool
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestStackChurn()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmpUnderlying = amp.Pmp();
+
+	CMemoryPoolStack mps(pmpUnderlying, gpos::ullong_max, false /*fThreadSafe*/, false /*fOwnsUnderlying*/);
+
+	void *rgpv[GPOS_MEM_TEST_LOOP_SHORT];
+	ULLONG ullReserved = 0;
+	BOOL fGrown = false;
+	for (ULONG ulRound = 0; ulRound < GPOS_MEM_TEST_REPEAT_SHORT; ulRound++)
+	{
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpv); ul++)
+		{
+			// mix sizes of all size classes
+			const ULONG ulSize = GPOS_MEM_TEST_ALLOC_SMALL * (1 + ul % (GPOS_MEM_TEST_ALLOC_LARGE / GPOS_MEM_TEST_ALLOC_SMALL));
+			rgpv[ul] = mps.PvAllocate(ulSize, __FILE__, __LINE__);
+		}
+
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpv); ul++)
+		{
+			mps.Free(rgpv[ul]);
+		}
+
+		// all rounds after the first one are served from the free lists
+		if (0 == ulRound)
+		{
+			ullReserved = mps.UllTotalAllocatedSize();
+		}
+		else if (ullReserved != mps.UllTotalAllocatedSize())
+		{
+			fGrown = true;
+		}
+	}
+
+	mps.TearDown();
+
+	if (fGrown)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestArena
+//
+//	@doc:
+//		Run tests for pool using arena allocation
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestArena()
+{
+	return EresTestType(CMemoryPoolManager::EatArena);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestThreadCache
+//
+//	@doc:
+//		Run tests for pool using per-thread caches
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestThreadCache()
+{
+	return EresTestType(CMemoryPoolManager::EatThreadCache);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestThreadCacheTracker
+//
+//	@doc:
+//		Run tests for tracker pools with per-thread caches in front
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestThreadCacheTracker()
+{
+	CAutoTraceFlag atf(EtraceThreadCacheMemoryPools, true /*fVal*/);
+
+	return EresTestType(CMemoryPoolManager::EatTracker);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestThreadCacheSlots
+//
+//	@doc:
+//		Check that a thread keeps using its magazine of a pool when more
+//		pools than thread slots are in use
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestThreadCacheSlots()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmpUnderlying = amp.Pmp();
+
+	const ULONG ulPools = 2 * GPOS_MEM_TC_THREAD_SLOTS + 1;
+	CMemoryPoolThreadCache *rgpmp[ulPools];
+	void *rgpv[ulPools];
+	ULLONG rgullReserved[ulPools];
+	for (ULONG ul = 0; ul < ulPools; ul++)
+	{
+		rgpmp[ul] = GPOS_NEW(pmpUnderlying) CMemoryPoolThreadCache
+					(
+					pmpUnderlying,
+					gpos::ullong_max,
+					true /*fThreadSafe*/,
+					false /*fOwnsUnderlying*/
+					);
+	}
+
+	// pools whose ids map to the same slot take it over from each other
+	BOOL fGrown = false;
+	for (ULONG ulRound = 0; ulRound < GPOS_MEM_TEST_LOOP_SHORT; ulRound++)
+	{
+		for (ULONG ul = 0; ul < ulPools; ul++)
+		{
+			rgpv[ul] = rgpmp[ul]->PvAllocate(GPOS_MEM_TEST_ALLOC_SMALL, __FILE__, __LINE__);
+		}
+
+		for (ULONG ul = 0; ul < ulPools; ul++)
+		{
+			rgpmp[ul]->Free(rgpv[ul]);
+
+			if (0 == ulRound)
+			{
+				rgullReserved[ul] = rgpmp[ul]->UllTotalAllocatedSize();
+			}
+			else if (rgullReserved[ul] != rgpmp[ul]->UllTotalAllocatedSize())
+			{
+				fGrown = true;
+			}
+		}
+	}
+
+	for (ULONG ul = 0; ul < ulPools; ul++)
+	{
+		rgpmp[ul]->TearDown();
+		GPOS_DELETE(rgpmp[ul]);
+	}
+
+	if (fGrown)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestProfile
+//
+//	@doc:
+//		Collect allocation profile of tracker pool
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestProfile()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// allocated before activation, freed while profiling
+	BYTE *pbBefore = GPOS_NEW_ARRAY(pmp, BYTE, GPOS_MEM_TEST_ALLOC_SMALL);
+
+	// site table is too large for the stack of a worker
+	CMemoryProfile *pmprof = GPOS_NEW(pmp) CMemoryProfile(pmp);
+	pmprof->Activate();
+	GPOS_ASSERT(pmprof == CMemoryProfile::PmprofSelf());
+
+	const ULONG ulAllocs = 16;
+	BYTE *rgpb[ulAllocs];
+	for (ULONG ul = 0; ul < ulAllocs; ul++)
+	{
+		rgpb[ul] = GPOS_NEW_ARRAY(pmp, BYTE, GPOS_MEM_TEST_ALLOC_SMALL);
+	}
+
+	// allocations of pools stacked on the profiled one are attributed
+	// to their call site as well
+	CMemoryPoolRegion *pmpr = GPOS_NEW(pmp) CMemoryPoolRegion(pmp);
+	const ULONG ulSitesBefore = pmprof->UlSites();
+	ULONG *pul = GPOS_NEW(pmpr) ULONG(0);
+	const ULONG ulSitesRegion = pmprof->UlSites() - ulSitesBefore;
+	GPOS_DELETE(pul);
+	pmpr->Drop();
+
+	for (ULONG ul = 0; ul < ulAllocs; ul++)
+	{
+		GPOS_DELETE_ARRAY(rgpb[ul]);
+	}
+	GPOS_DELETE_ARRAY(pbBefore);
+
+	pmprof->Deactivate();
+	GPOS_ASSERT(NULL == CMemoryProfile::PmprofSelf());
+
+	const ULONG ulSites = pmprof->UlSites();
+
+	CWStringDynamic str(pmp);
+	COstreamString os(&str);
+	(void) pmprof->OsPrint(os, 5 /*ulTop*/);
+	GPOS_TRACE(str.Wsz());
+
+	GPOS_DELETE(pmprof);
+
+	if (0 == ulSites || 1 != ulSitesRegion)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestHugePage
+//
+//	@doc:
+//		Serve chunks from huge page regions and dedicated mappings
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestHugePage()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmpUnderlying = amp.Pmp();
+
+	// page table is too large for the stack of a worker
+	CMemoryPoolHugePage *pmphp = GPOS_NEW(pmpUnderlying) CMemoryPoolHugePage(pmpUnderlying, false /*fOwnsUnderlying*/);
+
+	// small allocations are passed to the underlying pool
+	void *pvSmall = pmphp->PvAllocate(GPOS_MEM_TEST_ALLOC_SMALL, __FILE__, __LINE__);
+	BOOL fSmallMapped = (0 < pmphp->UlRegions());
+
+	// chunks share a region, a freed run is reused
+	const ULONG ulChunk = GPOS_MEM_TEST_ALLOC_MAX / 4;
+	void *pvFst = pmphp->PvAllocate(ulChunk, __FILE__, __LINE__);
+	void *pvSnd = pmphp->PvAllocate(ulChunk, __FILE__, __LINE__);
+	(void) clib::PvMemSet(pvFst, 0, ulChunk);
+	(void) clib::PvMemSet(pvSnd, 0, ulChunk);
+	pmphp->Free(pvFst);
+	void *pvThd = pmphp->PvAllocate(ulChunk, __FILE__, __LINE__);
+	BOOL fReused = (pvFst == pvThd && 1 == pmphp->UlRegions());
+
+	// requests larger than a region get a dedicated mapping
+	const ULONG ulHuge = GPOS_MEM_HUGE_PAGE_REGION_SIZE + GPOS_MEM_TEST_ALLOC_MAX;
+	void *pvHuge = pmphp->PvAllocate(ulHuge, __FILE__, __LINE__);
+	(void) clib::PvMemSet(pvHuge, 0, ulHuge);
+	BOOL fMapped = (GPOS_MEM_HUGE_PAGE_REGION_SIZE < pmphp->UllTotalAllocatedSize() - GPOS_MEM_HUGE_PAGE_REGION_SIZE);
+	pmphp->Free(pvHuge);
+
+	// a chunk of almost a region needs a region of its own, which is
+	// unmapped once the chunk is freed
+	const ULONG ulLarge = GPOS_MEM_HUGE_PAGE_REGION_SIZE - 2 * GPOS_MEM_HUGE_PAGE_GRANULE;
+	void *pvLarge = pmphp->PvAllocate(ulLarge, __FILE__, __LINE__);
+	BOOL fSecond = (2 == pmphp->UlRegions());
+
+	GPOS_TRACE_FORMAT
+		(
+		"Huge page regions: %d of %d",
+		pmphp->UlHugePageRegions(),
+		pmphp->UlRegions()
+		);
+
+	pmphp->Free(pvLarge);
+	BOOL fReleased = (1 == pmphp->UlRegions() && 1 >= pmphp->UlHugePageRegions());
+
+	pmphp->Free(pvThd);
+	pmphp->Free(pvSnd);
+	pmphp->Free(pvSmall);
+	BOOL fRetained = (GPOS_MEM_HUGE_PAGE_REGION_SIZE == pmphp->UllTotalAllocatedSize());
+
+	pmphp->TearDown();
+	GPOS_DELETE(pmphp);
+
+	// pools opt into huge pages at creation
+	CAutoMemoryPool ampHugePage
+		(
+		CAutoMemoryPool::ElcExc,
+		CMemoryPoolManager::EatArena,
+		true /*fThreadSafe*/,
+		gpos::ullong_max,
+		true /*fHugePages*/
+		);
+	BYTE *pb = GPOS_NEW_ARRAY(ampHugePage.Pmp(), BYTE, GPOS_MEM_TEST_ALLOC_MAX);
+	(void) clib::PvMemSet(pb, 0, GPOS_MEM_TEST_ALLOC_MAX);
+	GPOS_DELETE_ARRAY(pb);
+
+	if (fSmallMapped || !fReused || !fMapped || !fSecond || !fReleased || !fRetained)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestHugePageChurn
+//
+//	@doc:
+//		Map and unmap regions many more times than the page table has slots;
+//		removed entries of the table must not keep new regions from being
+//		mapped
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestHugePageChurn()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmpUnderlying = amp.Pmp();
+
+	CMemoryPoolHugePage *pmphp = GPOS_NEW(pmpUnderlying) CMemoryPoolHugePage(pmpUnderlying, false /*fOwnsUnderlying*/);
+
+	// a chunk that needs a region of its own is freed and allocated again;
+	// memory mapped in between moves the next region to other huge pages
+	const ULONG ulCycles = GPOS_MEM_HUGE_PAGE_TABLE_SIZE / 16;
+	const ULONG ulLarge = GPOS_MEM_HUGE_PAGE_REGION_SIZE - 2 * GPOS_MEM_HUGE_PAGE_GRANULE;
+	void **rgpvSpacers = GPOS_NEW_ARRAY(pmpUnderlying, void*, ulCycles);
+
+	void *pvFirst = pmphp->PvAllocate(GPOS_MEM_HUGE_PAGE_GRANULE, __FILE__, __LINE__);
+	void *pvLarge = pmphp->PvAllocate(ulLarge, __FILE__, __LINE__);
+
+	BOOL fMapped = (2 == pmphp->UlRegions());
+	ULONG ulSpacers = 0;
+	while (fMapped && ulSpacers < ulCycles)
+	{
+		pmphp->Free(pvLarge);
+		rgpvSpacers[ulSpacers++] = syslib::PvMapAnonymous(GPOS_MEM_HUGE_PAGE_REGION_SIZE);
+		pvLarge = pmphp->PvAllocate(ulLarge, __FILE__, __LINE__);
+		fMapped = (2 == pmphp->UlRegions());
+	}
+
+	pmphp->Free(pvLarge);
+	pmphp->Free(pvFirst);
+
+	for (ULONG ul = 0; ul < ulSpacers; ul++)
+	{
+		if (NULL != rgpvSpacers[ul])
+		{
+			syslib::Unmap(rgpvSpacers[ul], GPOS_MEM_HUGE_PAGE_REGION_SIZE);
+		}
+	}
+	GPOS_DELETE_ARRAY(rgpvSpacers);
+
+	pmphp->TearDown();
+	GPOS_DELETE(pmphp);
+
+	if (!fMapped)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestRegion
+//
+//	@doc:
+//		Drop regions directly and through a guard
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestRegion()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+	const ULLONG ullEmpty = pmp->UllTotalAllocatedSize();
+
+	// region is released on drop
+	CMemoryPoolRegion *pmpr = GPOS_NEW(pmp) CMemoryPoolRegion(pmp);
+	for (ULONG ul = 0; ul < GPOS_MEM_TEST_LOOP_SHORT; ul++)
+	{
+		BYTE *pb = GPOS_NEW_ARRAY(pmpr, BYTE, GPOS_MEM_TEST_ALLOC_LARGE);
+		GPOS_DELETE_ARRAY(pb);
+	}
+	BOOL fGrown = (ullEmpty < pmp->UllTotalAllocatedSize());
+	pmpr->Drop();
+	BOOL fReleased = (ullEmpty == pmp->UllTotalAllocatedSize());
+
+	// guard drops its region when going out of scope
+	{
+		CAutoMemoryPoolRegion amprScratch(pmp);
+		BYTE *pb = GPOS_NEW_ARRAY(amprScratch.Pmp(), BYTE, GPOS_MEM_TEST_ALLOC_LARGE);
+		GPOS_DELETE_ARRAY(pb);
+	}
+	BOOL fGuarded = (ullEmpty == pmp->UllTotalAllocatedSize());
+
+	if (!fGrown || !fReleased || !fGuarded)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestSlab
+//
+//	@doc:
+//		Allocate objects of a fixed size from a slab pool, reuse freed blocks
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestSlab()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+	const ULONG ulSlabBlocks = 16;
+	const ULONG ulObjects = 4 * ulSlabBlocks;
+
+	CMemoryPoolSlab *pmps = GPOS_NEW(pmp) CMemoryPoolSlab
+								(
+								pmp,
+								GPOS_SIZEOF(ULLONG),
+								ulSlabBlocks,
+								true /*fThreadSafe*/,
+								false /*fOwnsUnderlying*/
+								);
+
+	ULLONG *rgpull[ulObjects];
+	for (ULONG ul = 0; ul < ulObjects; ul++)
+	{
+		rgpull[ul] = GPOS_NEW(pmps) ULLONG(ul);
+	}
+	BOOL fFilled = (ulObjects / ulSlabBlocks == pmps->UlSlabs() && ulObjects == pmps->UlLive());
+
+	// freed blocks are reused before new slabs are allocated
+	for (ULONG ul = 0; ul < ulObjects; ul += 2)
+	{
+		GPOS_DELETE(rgpull[ul]);
+	}
+	for (ULONG ul = 0; ul < ulObjects; ul += 2)
+	{
+		rgpull[ul] = GPOS_NEW(pmps) ULLONG(ul);
+	}
+	BOOL fReused = (ulObjects / ulSlabBlocks == pmps->UlSlabs());
+
+	BOOL fIntact = true;
+	for (ULONG ul = 0; ul < ulObjects; ul++)
+	{
+		fIntact = fIntact && (ul == *rgpull[ul]);
+		GPOS_DELETE(rgpull[ul]);
+	}
+	BOOL fEmpty = (0 == pmps->UlLive());
+
+	// requests exceeding the object size are served by the underlying pool
+	ULLONG *rgullOversize = GPOS_NEW_ARRAY(pmps, ULLONG, ulSlabBlocks);
+	BOOL fOversize = (ulObjects / ulSlabBlocks == pmps->UlSlabs() && 0 == pmps->UlLive());
+	GPOS_DELETE_ARRAY(rgullOversize);
+
+	pmps->TearDown();
+	GPOS_DELETE(pmps);
+
+	if (!fFilled || !fReused || !fIntact || !fEmpty || !fOversize)
+	{
+		return GPOS_FAILED;
+	}
+
+#ifdef GPOS_DEBUG
+	return EresTestSlabLeak();
+#else
+	return GPOS_OK;
+#endif // GPOS_DEBUG
+}
+
+
+#ifdef GPOS_DEBUG
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresTestSlabLeak
+//
+//	@doc:
+//		Check that a slab holding an unfreed object is left to the
+//		underlying pool at tear down
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresTestSlabLeak()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	CMemoryPoolSlab *pmps = GPOS_NEW(pmp) CMemoryPoolSlab
+								(
+								pmp,
+								GPOS_SIZEOF(ULLONG),
+								16 /*ulSlabBlocks*/,
+								true /*fThreadSafe*/,
+								false /*fOwnsUnderlying*/
+								);
+	const ULLONG ullSize = pmp->UllTotalAllocatedSize();
+
+	ULLONG *pullFreed = GPOS_NEW(pmps) ULLONG(0);
+	(void) GPOS_NEW(pmps) ULLONG(1);
+	GPOS_DELETE(pullFreed);
+
+	pmps->TearDown();
+	GPOS_DELETE(pmps);
+
+	if (ullSize >= pmp->UllTotalAllocatedSize())
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+#endif // GPOS_DEBUG
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresTestType
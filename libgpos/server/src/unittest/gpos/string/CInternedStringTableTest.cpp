@@ -0,0 +1,199 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedStringTableTest.cpp
+//
+//	@doc:
+//		Tests for the interned string table
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/string/CInternedStringTable.h"
+#include "gpos/string/CWStringConst.h"
+#include "gpos/string/CWStringStatic.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/string/CInternedStringTableTest.h"
+
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTableTest::EresUnittest
+//
+//	@doc:
+//		Driver for unittests
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CInternedStringTableTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CInternedStringTableTest::EresUnittest_Intern),
+		GPOS_UNITTEST_FUNC(CInternedStringTableTest::EresUnittest_Release),
+		GPOS_UNITTEST_FUNC(CInternedStringTableTest::EresUnittest_Utf8),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTableTest::EresUnittest_Intern
+//
+//	@doc:
+//		Equal strings are interned to the same entry, different strings
+//		to different entries
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CInternedStringTableTest::EresUnittest_Intern()
+{
+	CInternedStringTable *pist = CInternedStringTable::Pist();
+	GPOS_ASSERT(NULL != pist);
+
+	// intern a string held in different string classes
+	WCHAR wszBuffer[32];
+	CWStringStatic str(wszBuffer, GPOS_ARRAY_SIZE(wszBuffer));
+	str.AppendFormat(GPOS_WSZ_LIT("interned_%d"), 42);
+
+	const CInternedString *pis = pist->PisIntern(&str);
+	const ULONG ulStrings = pist->UlStrings();
+	const CInternedString *pisLit = pist->PisIntern(GPOS_WSZ_LIT("interned_42"));
+
+	// interning an existing string returns its entry
+	const BOOL fExisting = (pis == pisLit && ulStrings == pist->UlStrings());
+
+	// different strings, including prefixes and the empty string, are kept apart
+	const CInternedString *pisPrefix = pist->PisIntern(GPOS_WSZ_LIT("interned_4"));
+	const CInternedString *pisEmpty = pist->PisIntern(GPOS_WSZ_LIT(""));
+	const CInternedString *pisEmptyLit = pist->PisIntern(GPOS_WSZ_LIT(""));
+
+	BOOL fPassed =
+		fExisting &&
+
+		// interned strings keep their contents
+		pis->Pstr()->FEquals(&str) &&
+		0 == clib::IStrCmp(pis->Sz(), "interned_42") &&
+		pis->UlId() < pist->UlStrings() &&
+
+		pis != pisPrefix && pis != pisEmpty && pisPrefix != pisEmpty &&
+		pis->UlId() != pisPrefix->UlId() &&
+		0 == pisEmpty->UlLength() &&
+		0 == pisEmpty->Pstr()->UlLength() &&
+		pisEmpty == pisEmptyLit;
+
+	pist->Release(pisEmptyLit);
+	pist->Release(pisEmpty);
+	pist->Release(pisPrefix);
+	pist->Release(pisLit);
+	pist->Release(pis);
+
+	return fPassed ? GPOS_OK : GPOS_FAILED;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTableTest::EresUnittest_Release
+//
+//	@doc:
+//		A string is dropped with its last reference and interned anew
+//		afterwards
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CInternedStringTableTest::EresUnittest_Release()
+{
+	CInternedStringTable *pist = CInternedStringTable::Pist();
+
+	const CInternedString *pis = pist->PisIntern(GPOS_WSZ_LIT("released_string"));
+	const ULONG ulId = pis->UlId();
+
+	// an additional reference keeps the string alive
+	pist->AddRef(pis);
+	pist->Release(pis);
+
+	const CInternedString *pisKept = pist->PisIntern(GPOS_WSZ_LIT("released_string"));
+	const BOOL fKept = (pis == pisKept && ulId == pisKept->UlId());
+	pist->Release(pisKept);
+	pist->Release(pis);
+
+	if (!fKept)
+	{
+		return GPOS_FAILED;
+	}
+
+	// the string was dropped with its last reference, hence
+	// interning it again creates a new entry
+	const CInternedString *pisNew = pist->PisIntern(GPOS_WSZ_LIT("released_string"));
+	const BOOL fNew = (ulId != pisNew->UlId());
+	pist->Release(pisNew);
+
+	return fNew ? GPOS_OK : GPOS_FAILED;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTableTest::EresUnittest_Utf8
+//
+//	@doc:
+//		Strings are keyed by their UTF-8 encoding and decoded on demand
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CInternedStringTableTest::EresUnittest_Utf8()
+{
+	CInternedStringTable *pist = CInternedStringTable::Pist();
+
+	// 'a', e with acute accent, euro sign, G clef
+	const WCHAR wsz[] = {0x61, 0xE9, 0x20AC, 0x1D11E, 0};
+	const BYTE rgbExpected[] =
+		{
+		0x61,
+		0xC3, 0xA9,
+		0xE2, 0x82, 0xAC,
+		0xF0, 0x9D, 0x84, 0x9E
+		};
+
+	const CInternedString *pis = pist->PisIntern(wsz);
+
+	// the wide copy round-trips
+	const CWStringConst str(wsz);
+	BOOL fPassed =
+		GPOS_ARRAY_SIZE(rgbExpected) == pis->UlLength() &&
+		0 == clib::IMemCmp(rgbExpected, pis->Sz(), GPOS_ARRAY_SIZE(rgbExpected)) &&
+		'\0' == pis->Sz()[pis->UlLength()] &&
+		pis->Pstr()->FEquals(&str);
+
+	pist->Release(pis);
+
+	// strings longer than the encoding buffer
+	WCHAR wszLong[GPOS_INTERNED_STRING_BUFFER + 2];
+	for (ULONG ul = 0; ul < GPOS_INTERNED_STRING_BUFFER + 1; ul++)
+	{
+		wszLong[ul] = 0xE9;
+	}
+	wszLong[GPOS_INTERNED_STRING_BUFFER + 1] = 0;
+
+	const CInternedString *pisLong = pist->PisIntern(wszLong);
+	const CInternedString *pisLongAgain = pist->PisIntern(wszLong);
+	const CWStringConst strLong(wszLong);
+
+	fPassed = fPassed &&
+		2 * (GPOS_INTERNED_STRING_BUFFER + 1) == pisLong->UlLength() &&
+		pisLong == pisLongAgain &&
+		pisLong->Pstr()->FEquals(&strLong);
+
+	pist->Release(pisLongAgain);
+	pist->Release(pisLong);
+
+	return fPassed ? GPOS_OK : GPOS_FAILED;
+}
+
+// EOF
@@ -34,7 +34,8 @@ CSpinlockTest::EresUnittest()
 	CUnittest rgut[] =
 		{
 		GPOS_UNITTEST_FUNC(CSpinlockTest::EresUnittest_LockRelease),
-		GPOS_UNITTEST_FUNC(CSpinlockTest::EresUnittest_Concurrency)
+		GPOS_UNITTEST_FUNC(CSpinlockTest::EresUnittest_Concurrency),
+		GPOS_UNITTEST_FUNC(CSpinlockTest::EresUnittest_Contention)
 #ifdef GPOS_DEBUG
 		,
 		GPOS_UNITTEST_FUNC_ASSERT(CSpinlockTest::EresUnittest_SelfDeadlock),
@@ -156,6 +157,102 @@ CSpinlockTest::PvUnittest_ConcurrencyRun
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSpinlock::EresUnittest_Contention
+//
+//	@doc:
+//		Hold a lock until another thread waits for it; waiting thread must
+//		be counted as contention of the lock's rank
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSpinlockTest::EresUnittest_Contention()
+{
+#ifdef GPOS_DEBUG
+	if (IWorker::m_fEnforceTimeSlices)
+ 	{
+ 		return GPOS_OK;
+	}
+#endif // GPOS_DEBUG
+
+	CSpinlockDummy slock;
+	SContention cont(&slock);
+
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
+	IMemoryPool *pmp = amp.Pmp();
+
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+
+	// scope for tasks
+	{
+		CAutoTaskProxy atp(pmp, pwpm);
+		CTask *ptskHolder = atp.PtskCreate(CSpinlockTest::PvUnittest_ContentionRun, &cont);
+		CTask *ptskWaiter = atp.PtskCreate(CSpinlockTest::PvUnittest_ConcurrencyRun, &slock);
+
+		atp.Schedule(ptskHolder);
+
+		// wait until holder has acquired the lock
+		while (!cont.m_fLocked)
+		{
+			GPOS_CHECK_ABORT;
+
+			clib::USleep(1000);
+		}
+
+		atp.Schedule(ptskWaiter);
+
+		atp.Wait(ptskHolder);
+		atp.Wait(ptskWaiter);
+	}
+
+	if (!cont.m_fContended)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSpinlock::PvUnittest_ContentionRun
+//
+//	@doc:
+//		thread routine; hold lock until another thread contends for it
+//
+//---------------------------------------------------------------------------
+void *
+CSpinlockTest::PvUnittest_ContentionRun
+	(
+	void *pv
+	)
+{
+	SContention *pcont = (SContention*)pv;
+	CSpinlockDummy *pslock = pcont->m_pslock;
+
+	const ULONG ulRank = pslock->UlRank();
+	const ULONG_PTR ulpContentions = CSpinlockBase::UlpContentions(ulRank);
+
+	pslock->Lock();
+	pcont->m_fLocked = true;
+
+	// wait until another thread waits for the lock
+	for (ULONG ul = 0; !pcont->m_fContended && ul < 10000; ul++)
+	{
+		clib::USleep(1000);
+		pcont->m_fContended = (ulpContentions < CSpinlockBase::UlpContentions(ulRank));
+	}
+
+	// give waiting thread time to park
+	clib::USleep(10000);
+	pslock->Unlock();
+
+	return NULL;
+}
+
+
 #ifdef GPOS_DEBUG
 //---------------------------------------------------------------------------
 //	@function:
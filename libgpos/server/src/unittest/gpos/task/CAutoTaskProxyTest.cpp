@@ -41,7 +41,8 @@ CAutoTaskProxyTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_PropagateCancelError),
 		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_PropagateExecError),
 		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_ExecuteError),
-		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_CheckErrorPropagation)
+		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_CheckErrorPropagation),
+		GPOS_UNITTEST_FUNC(CAutoTaskProxyTest::EresUnittest_Reuse)
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -667,6 +668,60 @@ CAutoTaskProxyTest::EresUnittest_CheckErrorPropagation()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CAutoTaskProxyTest::EresUnittest_Reuse
+//
+//	@doc:
+//		Reuse of destroyed tasks by later task proxies
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CAutoTaskProxyTest::EresUnittest_Reuse()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+
+	pwpm->Prewarm(2);
+	GPOS_ASSERT(2 <= pwpm->UlTasksCached());
+
+	CTask *ptskFirst = NULL;
+	ULLONG ullRes = 0;
+
+	// scope for ATP
+	{
+		CAutoTaskProxy atp(pmp, pwpm);
+
+#ifdef GPOS_DEBUG
+		const ULONG ulCached = pwpm->UlTasksCached();
+#endif // GPOS_DEBUG
+		ptskFirst = atp.PtskCreate(CAutoTaskProxyTest::PvUnittest_Short, &ullRes);
+		GPOS_ASSERT(ulCached == pwpm->UlTasksCached() + 1);
+
+		atp.Schedule(ptskFirst);
+		atp.Wait(ptskFirst);
+		GPOS_ASSERT(ullRes == *(ULLONG *) ptskFirst->PvRes());
+	}
+
+	// scope for ATP
+	{
+		CAutoTaskProxy atp(pmp, pwpm);
+
+		// most recently destroyed task is reused first
+		CTask *ptsk = atp.PtskCreate(CAutoTaskProxyTest::PvUnittest_Short, &ullRes);
+		GPOS_ASSERT(ptskFirst == ptsk);
+
+		atp.Schedule(ptsk);
+		atp.Wait(ptsk);
+		GPOS_ASSERT(ullRes == *(ULLONG *) ptsk->PvRes());
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CAutoTaskProxyTest::PvUnittest_Short
@@ -18,6 +18,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/memory/CCacheFactory.h"
+#include "gpos/string/CInternedStringTable.h"
 #include "gpos/string/CWStringStatic.h"
 #include "gpos/task/CAutoTaskProxy.h"
 #include "gpos/task/CWorkerPoolManager.h"
@@ -69,6 +70,11 @@ void gpos_init(struct gpos_init_params* params) {
 		return;
 	}
 
+	if (GPOS_OK != gpos::CInternedStringTable::EresInit())
+	{
+		return;
+	}
+
 #ifdef GPOS_FPSIMULATOR
 	if (GPOS_OK != gpos::CFSimulator::EresInit())
 	{
@@ -114,6 +120,31 @@ int gpos_set_threads(int min, int max)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		gpos_pin_threads
+//
+//	@doc:
+//		Pin worker threads to processors, or unpin them;
+//		return 0 for successful completion, 1 for error;
+//
+//---------------------------------------------------------------------------
+int gpos_pin_threads(bool pin)
+{
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+
+	// check if worker pool is initialized
+	if (NULL == pwpm)
+	{
+		return 1;
+	}
+
+	pwpm->SetWorkersPinned(pin);
+
+	return 0;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		gpos_exec
@@ -247,6 +278,7 @@ void gpos_terminate()
 	CMessageRepository::Pmr()->Shutdown();
 	CWorkerPoolManager::Pwpm()->Shutdown();
 	CCacheFactory::Pcf()->Shutdown();
+	CInternedStringTable::Pist()->Shutdown();
 	CMemoryPoolManager::Pmpm()->Shutdown();
 #endif // GPOS_DEBUG
 }
@@ -8,12 +8,13 @@
 //	@doc:
 //		Implementation of bit sets
 //
-//		Underlying assumption: a set contains only a few links of bitvectors
-//		hence, keeping them in a linked list is efficient;
+//		Stored words are trimmed to the range between the lowest and the
+//		highest word with a bit set, so that each set has exactly one
+//		representation; set operations are plain loops over words which
+//		the compiler is free to vectorize
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
-#include "gpos/common/CAutoRef.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/CBitSetIter.h"
 
@@ -23,111 +24,124 @@
 
 using namespace gpos;
 
+GPOS_CPL_ASSERT(GPOS_BITSET_WORD_BITS == 8 * sizeof(ULLONG));
+
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSetLink
+//		CBitSet::Reserve
 //
 //	@doc:
-//		ctor
+//		Extend stored words to cover the given range of words; new words are
+//		clear; the array is reallocated only if the words do not fit, in
+//		which case its capacity is at least doubled
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink
+void
+CBitSet::Reserve
 	(
-	IMemoryPool *pmp, 
-	ULONG ulOffset, 
-	ULONG cSizeBits
+	ULONG ulWordFirst,
+	ULONG ulWordEnd
 	)
-	: 
-	m_ulOffset(ulOffset)
 {
-	m_pbv = GPOS_NEW(pmp) CBitVector(pmp, cSizeBits);
-}
+	GPOS_ASSERT(ulWordFirst < ulWordEnd);
 
+	if (0 < m_cWords)
+	{
+		const ULONG ulWordEndStored = m_ulWordFirst + m_cWords;
+		if (m_ulWordFirst <= ulWordFirst && ulWordEnd <= ulWordEndStored)
+		{
+			// range is covered already
+			return;
+		}
 
-//---------------------------------------------------------------------------
-//	@function:
-//		CBitSetLink
-//
-//	@doc:
-//		copy ctor
-//
-//---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink
-	(
-	IMemoryPool *pmp, 
-	const CBitSetLink &bsl
-	)
-	: 
-	m_ulOffset(bsl.m_ulOffset)
-{
-	m_pbv = GPOS_NEW(pmp) CBitVector(pmp, *bsl.Pbv());
-}
+		ulWordFirst = std::min(ulWordFirst, m_ulWordFirst);
+		ulWordEnd = std::max(ulWordEnd, ulWordEndStored);
+	}
 
+	const ULONG cWords = ulWordEnd - ulWordFirst;
+	const ULONG ulShift = (0 < m_cWords) ? m_ulWordFirst - ulWordFirst : 0;
 
-//---------------------------------------------------------------------------
-//	@function:
-//		~CBitSetLink
-//
-//	@doc:
-//		ctor
-//
-//---------------------------------------------------------------------------
-CBitSet::CBitSetLink::~CBitSetLink()
-{
-	GPOS_DELETE(m_pbv);
+	ULLONG *rgull = m_rgull;
+	ULONG cWordsCapacity = m_cWordsCapacity;
+	if (cWords > m_cWordsCapacity)
+	{
+		cWordsCapacity = std::max(cWords, 2 * m_cWordsCapacity);
+		cWordsCapacity = ((cWordsCapacity + m_cWordsChunk - 1) / m_cWordsChunk) * m_cWordsChunk;
+
+		rgull = GPOS_NEW_ARRAY(m_pmp, ULLONG, cWordsCapacity);
+	}
+
+	// move stored words to their new position, starting from the top since
+	// words move up if the array is not reallocated
+	for (ULONG ul = m_cWords; ul > 0; ul--)
+	{
+		rgull[ulShift + ul - 1] = m_rgull[ul - 1];
+	}
+
+	for (ULONG ul = 0; ul < ulShift; ul++)
+	{
+		rgull[ul] = 0;
+	}
+
+	for (ULONG ul = ulShift + m_cWords; ul < cWords; ul++)
+	{
+		rgull[ul] = 0;
+	}
+
+	if (rgull != m_rgull)
+	{
+		if (m_rgull != m_rgullInline)
+		{
+			GPOS_DELETE_ARRAY(m_rgull);
+		}
+
+		m_rgull = rgull;
+		m_cWordsCapacity = cWordsCapacity;
+	}
+
+	m_ulWordFirst = ulWordFirst;
+	m_cWords = cWords;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::PbslLocate
+//		CBitSet::Trim
 //
 //	@doc:
-//		Find bit set link for a given offset; if non-existent return previous
-//		link (may be NULL);
-//		By providing a starting link we can implement a number of operations
-//		in one sweep, ie O(N) 
+//		Drop clear words at both ends of stored words
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink *
-CBitSet::PbslLocate
-	(
-	ULONG ulOffset,
-	CBitSetLink *pbsl
-	)
-	const
+void
+CBitSet::Trim()
 {
-	CBitSetLink *pbslFound = NULL;
-	CBitSetLink *pbslCursor = pbsl;
-	
-	if (NULL == pbsl)
+	while (0 < m_cWords && 0 == m_rgull[m_cWords - 1])
 	{
-		// if no cursor provided start with first element
-		pbslCursor = m_bsllist.PtFirst();
+		m_cWords--;
 	}
-	else
+
+	ULONG ulShift = 0;
+	while (ulShift < m_cWords && 0 == m_rgull[ulShift])
 	{
-		GPOS_ASSERT(pbsl->UlOffset() <= ulOffset && "invalid start cursor");
-		pbslFound = pbsl;
+		ulShift++;
 	}
-	
-	GPOS_ASSERT_IMP(NULL != pbslCursor, GPOS_OK == m_bsllist.EresFind(pbslCursor) && "cursor not in list");
-	
-	while(1)
+
+	if (0 < ulShift)
 	{
-		// no more links or we've overshot the target
-		if (NULL == pbslCursor || pbslCursor->UlOffset() > ulOffset)
+		for (ULONG ul = ulShift; ul < m_cWords; ul++)
 		{
-			break;
+			m_rgull[ul - ulShift] = m_rgull[ul];
 		}
-		
-		pbslFound = pbslCursor;		
-		pbslCursor = m_bsllist.PtNext(pbslCursor);
+
+		m_ulWordFirst += ulShift;
+		m_cWords -= ulShift;
+	}
+
+	if (0 == m_cWords)
+	{
+		m_ulWordFirst = 0;
 	}
-	
-	GPOS_ASSERT_IMP(pbslFound, pbslFound->UlOffset() <= ulOffset);
-	return pbslFound;
 }
 
 
@@ -136,23 +150,17 @@ CBitSet::PbslLocate
 //		CBitSet::RecomputeSize
 //
 //	@doc:
-//		Compute size of set by adding up sizes of links
+//		Compute size of set by counting bits of stored words
 //
 //---------------------------------------------------------------------------
 void
 CBitSet::RecomputeSize()
 {
 	m_cElements = 0;
-	CBitSetLink *pbsl = NULL;
-	
-	for (
-		pbsl = m_bsllist.PtFirst();
-		pbsl != NULL;
-		pbsl = m_bsllist.PtNext(pbsl)
-		)
-	{
-		m_cElements += pbsl->Pbv()->CElements();
-	}	
+	for (ULONG ul = 0; ul < m_cWords; ul++)
+	{
+		m_cElements += UlPopCount(m_rgull[ul]);
+	}
 }
 
 
@@ -161,47 +169,25 @@ CBitSet::RecomputeSize()
 //		CBitSet::Clear
 //
 //	@doc:
-//		release all links
+//		Release stored words
 //
 //---------------------------------------------------------------------------
 void
 CBitSet::Clear()
 {
-	CBitSetLink *pbsl = NULL;
-	
-	while(NULL != (pbsl = m_bsllist.PtFirst()))
-	{		
-		CBitSetLink *pbslRemove = pbsl;
-		pbsl = m_bsllist.PtNext(pbsl);
-		
-		m_bsllist.Remove(pbslRemove);
-		GPOS_DELETE(pbslRemove);
+	if (m_rgull != m_rgullInline)
+	{
+		GPOS_DELETE_ARRAY(m_rgull);
+		m_rgull = m_rgullInline;
+		m_cWordsCapacity = GPOS_BITSET_INLINE_WORDS;
 	}
-	
-	RecomputeSize();
-}
-
 
-//---------------------------------------------------------------------------
-//	@function:
-//		CBitSet::UlOffset
-//
-//	@doc:
-//		Compute offset 
-//
-//---------------------------------------------------------------------------
-ULONG
-CBitSet::UlOffset
-	(
-	ULONG ul
-	)
-	const
-{
-	return (ul / m_cSizeBits) * m_cSizeBits;
+	m_ulWordFirst = 0;
+	m_cWords = 0;
+	m_cElements = 0;
 }
 
 
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSet::CBitSet
@@ -217,10 +203,13 @@ CBitSet::CBitSet
 	)
 	:
 	m_pmp(pmp),
-	m_cSizeBits(cSizeBits),
+	m_cWordsChunk(std::max((ULONG) 1, UlWord(cSizeBits + GPOS_BITSET_WORD_BITS - 1))),
+	m_ulWordFirst(0),
+	m_cWords(0),
+	m_cWordsCapacity(GPOS_BITSET_INLINE_WORDS),
+	m_rgull(m_rgullInline),
 	m_cElements(0)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
 }
 
 
@@ -239,10 +228,13 @@ CBitSet::CBitSet
 	)
 	:
 	m_pmp(pmp),
-	m_cSizeBits(bs.m_cSizeBits),
+	m_cWordsChunk(bs.m_cWordsChunk),
+	m_ulWordFirst(0),
+	m_cWords(0),
+	m_cWordsCapacity(GPOS_BITSET_INLINE_WORDS),
+	m_rgull(m_rgullInline),
 	m_cElements(0)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
 	Union(&bs);
 }
 
@@ -276,15 +268,7 @@ CBitSet::FBit
 	)
 	const
 {
-	ULONG ulOffset = UlOffset(ulBit);
-	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL != pbsl && pbsl->UlOffset() == ulOffset)
-	{
-		return pbsl->Pbv()->FBit(ulBit - ulOffset);
-	}
-	
-	return false;
+	return 0 != (UllWord(UlWord(ulBit)) & UllMask(ulBit));
 }
 
 
@@ -293,7 +277,8 @@ CBitSet::FBit
 //		CBitSet::FExchangeSet
 //
 //	@doc:
-//		Set given bit; return previous value; allocate new link if necessary
+//		Set given bit; return previous value; extend stored words if
+//		necessary
 //
 //---------------------------------------------------------------------------
 BOOL 
@@ -302,30 +287,16 @@ CBitSet::FExchangeSet
 	ULONG ulBit
 	)
 {
-	ULONG ulOffset = UlOffset(ulBit);
-	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL == pbsl || pbsl->UlOffset() != ulOffset)
-	{
-		CBitSetLink *pbslNew = GPOS_NEW(m_pmp) CBitSetLink(m_pmp, ulOffset, m_cSizeBits);
-		if (NULL == pbsl)
-		{
-			m_bsllist.Prepend(pbslNew);
-		}
-		else
-		{
-			// insert after found link
-			m_bsllist.Append(pbslNew, pbsl);
-		}
-		
-		pbsl = pbslNew;
-	}
-	
-	GPOS_ASSERT(pbsl->UlOffset() == ulOffset);
-	
-	BOOL fBit = pbsl->Pbv()->FExchangeSet(ulBit - ulOffset);
+	const ULONG ulWord = UlWord(ulBit);
+	Reserve(ulWord, ulWord + 1);
+
+	ULLONG &ull = m_rgull[ulWord - m_ulWordFirst];
+	const ULLONG ullMask = UllMask(ulBit);
+
+	BOOL fBit = (0 != (ull & ullMask));
 	if (!fBit)
 	{
+		ull |= ullMask;
 		m_cElements++;
 	}
 	
@@ -347,29 +318,24 @@ CBitSet::FExchangeClear
 	ULONG ulBit
 	)
 {
-	ULONG ulOffset = UlOffset(ulBit);
-	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL != pbsl && pbsl->UlOffset() == ulOffset)
+	const ULONG ulWord = UlWord(ulBit);
+	const ULLONG ullMask = UllMask(ulBit);
+
+	if (0 == (UllWord(ulWord) & ullMask))
 	{
-		BOOL fBit = pbsl->Pbv()->FExchangeClear(ulBit - ulOffset);
-		
-		// remove empty link
-		if (pbsl->Pbv()->FEmpty())
-		{
-			m_bsllist.Remove(pbsl);
-			GPOS_DELETE(pbsl);
-		}
-		
-		if (fBit)
-		{
-			m_cElements--;
-		}
-		
-		return fBit;
+		return false;
 	}
-	
-	return false;
+
+	ULLONG &ull = m_rgull[ulWord - m_ulWordFirst];
+	ull &= ~ullMask;
+	m_cElements--;
+
+	if (0 == ull)
+	{
+		Trim();
+	}
+
+	return true;
 }
 
 
@@ -378,13 +344,8 @@ CBitSet::FExchangeClear
 //		CBitSet::Union
 //
 //	@doc:
-//		Union with given other set;
-//		(1) determine which links need to be allocated before(!) modifying
-//			the set allocate and copy missing links aside
-//		(2) insert the new links into the list
-//		(3) union all links, old and new, on a per-bitvector basis
-//
-//		For clarity step (2) and (3) are separated;
+//		Union with given other set; extends stored words to cover the other
+//		set's words before(!) modifying any word
 //
 //---------------------------------------------------------------------------
 void
@@ -393,64 +354,20 @@ CBitSet::Union
 	const CBitSet *pbsOther
 	)
 {
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
-
-	// dynamic array of CBitSetLink
-	typedef CDynamicPtrArray <CBitSetLink, CleanupNULL> DrgBSL;
-
-	CAutoRef<DrgBSL> a_drgpbsl;
-	a_drgpbsl = GPOS_NEW(m_pmp) DrgBSL(m_pmp);
-	
-	// iterate through other's links and copy missing links to array
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
-	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		if (NULL == pbsl || pbsl->UlOffset() != pbslOther->UlOffset())
-		{
-			// need to copy this link
-			CAutoP<CBitSetLink> a_pbsl;
-			a_pbsl = GPOS_NEW(m_pmp) CBitSetLink(m_pmp, *pbslOther);
-			a_drgpbsl->Append(a_pbsl.Pt());
-			
-			a_pbsl.PtReset();
-		}
-	}
-
-	// insert all new links
-	pbsl = NULL;
-	for (ULONG i = 0; i < a_drgpbsl->UlLength(); i++)
+	if (0 == pbsOther->m_cWords)
 	{
-		CBitSetLink *pbslInsert = (*a_drgpbsl)[i];
-		pbsl = PbslLocate(pbslInsert->UlOffset(), pbsl);
-		
-		GPOS_ASSERT_IMP(NULL != pbsl, pbsl->UlOffset() < pbslInsert->UlOffset());
-		if (NULL == pbsl)
-		{
-			m_bsllist.Prepend(pbslInsert);
-		}
-		else
-		{
-			m_bsllist.Append(pbslInsert, pbsl);
-		}
+		return;
 	}
-	
-	// iterate through all links and union them up
-	pbslOther = NULL;
-	pbsl = m_bsllist.PtFirst();
-	while (NULL != pbsl)
+
+	const ULONG ulWordFirstOther = pbsOther->m_ulWordFirst;
+	const ULONG cWordsOther = pbsOther->m_cWords;
+	Reserve(ulWordFirstOther, ulWordFirstOther + cWordsOther);
+
+	ULLONG *rgull = m_rgull + (ulWordFirstOther - m_ulWordFirst);
+	const ULLONG *rgullOther = pbsOther->m_rgull;
+	for (ULONG ul = 0; ul < cWordsOther; ul++)
 	{
-		pbslOther = pbsOther->PbslLocate(pbsl->UlOffset(), pbslOther);
-		if (NULL != pbslOther && pbslOther->UlOffset() == pbsl->UlOffset())
-		{
-			pbsl->Pbv()->Union(pbslOther->Pbv());
-		}
-		
-		pbsl = m_bsllist.PtNext(pbsl);
+		rgull[ul] |= rgullOther[ul];
 	}
 	
 	RecomputeSize();
@@ -462,7 +379,7 @@ CBitSet::Union
 //		CBitSet::Intersection
 //
 //	@doc:
-//		Iterate through all links and intersect them; release unused links
+//		Intersect words both sets store; drop all other words
 //
 //---------------------------------------------------------------------------
 void
@@ -471,29 +388,30 @@ CBitSet::Intersection
 	const CBitSet *pbsOther
 	)
 {
-	CBitSetLink *pbslOther = NULL;
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	
-	while (NULL != pbsl)
+	const ULONG ulWordFirst = std::max(m_ulWordFirst, pbsOther->m_ulWordFirst);
+	const ULONG ulWordEnd = std::min(m_ulWordFirst + m_cWords, pbsOther->m_ulWordFirst + pbsOther->m_cWords);
+
+	if (ulWordFirst >= ulWordEnd)
 	{
-		CBitSetLink *pbslRemove = NULL;
+		m_ulWordFirst = 0;
+		m_cWords = 0;
+		m_cElements = 0;
 
-		pbslOther = pbsOther->PbslLocate(pbsl->UlOffset(), pbslOther);
-		if (NULL != pbslOther && pbslOther->UlOffset() == pbsl->UlOffset())
-		{
-			pbsl->Pbv()->Intersection(pbslOther->Pbv());
-			pbsl = m_bsllist.PtNext(pbsl);
-		}
-		else
-		{
-			pbslRemove = pbsl;
-			pbsl = m_bsllist.PtNext(pbsl);
-			
-			m_bsllist.Remove(pbslRemove);
-			GPOS_DELETE(pbslRemove);
-		}
+		return;
 	}
-	
+
+	const ULONG cWords = ulWordEnd - ulWordFirst;
+	const ULLONG *rgull = m_rgull + (ulWordFirst - m_ulWordFirst);
+	const ULLONG *rgullOther = pbsOther->m_rgull + (ulWordFirst - pbsOther->m_ulWordFirst);
+	for (ULONG ul = 0; ul < cWords; ul++)
+	{
+		m_rgull[ul] = rgull[ul] & rgullOther[ul];
+	}
+
+	m_ulWordFirst = ulWordFirst;
+	m_cWords = cWords;
+
+	Trim();
 	RecomputeSize();
 }
 
@@ -503,8 +421,8 @@ CBitSet::Intersection
 //		CBitSet::Difference
 //
 //	@doc:
-//		Substract other set from this by iterating through other set and
-//		explicit removal of elements;
+//		Substract other set from this by clearing the other set's bits in
+//		words both sets store
 //
 //---------------------------------------------------------------------------
 void
@@ -513,16 +431,24 @@ CBitSet::Difference
 	const CBitSet *pbs
 	)
 {
-	if (FDisjoint(pbs))
+	const ULONG ulWordFirst = std::max(m_ulWordFirst, pbs->m_ulWordFirst);
+	const ULONG ulWordEnd = std::min(m_ulWordFirst + m_cWords, pbs->m_ulWordFirst + pbs->m_cWords);
+
+	if (ulWordFirst >= ulWordEnd)
 	{
 		return;
 	}
-	
-	CBitSetIter bsiter(*pbs);
-	while (bsiter.FAdvance())
+
+	const ULONG cWords = ulWordEnd - ulWordFirst;
+	ULLONG *rgull = m_rgull + (ulWordFirst - m_ulWordFirst);
+	const ULLONG *rgullOther = pbs->m_rgull + (ulWordFirst - pbs->m_ulWordFirst);
+	for (ULONG ul = 0; ul < cWords; ul++)
 	{
-		(void) FExchangeClear(bsiter.UlBit());
+		rgull[ul] &= ~rgullOther[ul];
 	}
+
+	Trim();
+	RecomputeSize();
 }	
 
 
@@ -531,7 +457,8 @@ CBitSet::Difference
 //		CBitSet::FSubset
 //
 //	@doc:
-//		Determine if given vector is subset
+//		Determine if given vector is subset; since stored words are trimmed,
+//		the other set's words must lie within the stored words of this set
 //
 //---------------------------------------------------------------------------
 BOOL
@@ -547,21 +474,24 @@ CBitSet::FSubset
 		return false;
 	}
 
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
+	const ULONG cWordsOther = pbsOther->m_cWords;
+	if (0 == cWordsOther)
+	{
+		return true;
+	}
+
+	const ULONG ulWordFirstOther = pbsOther->m_ulWordFirst;
+	if (ulWordFirstOther < m_ulWordFirst ||
+		ulWordFirstOther + cWordsOther > m_ulWordFirst + m_cWords)
+	{
+		return false;
+	}
 
-	// iterate through other's links and check for subsets
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
+	const ULLONG *rgull = m_rgull + (ulWordFirstOther - m_ulWordFirst);
+	const ULLONG *rgullOther = pbsOther->m_rgull;
+	for (ULONG ul = 0; ul < cWordsOther; ul++)
 	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		
-		if (NULL == pbsl ||
-			pbsl->UlOffset() != pbslOther->UlOffset() ||
-			!pbsl->Pbv()->FSubset(pbslOther->Pbv()))
+		if (0 != (rgullOther[ul] & ~rgull[ul]))
 		{
 			return false;
 		}
@@ -576,7 +506,7 @@ CBitSet::FSubset
 //		CBitSet::FEqual
 //
 //	@doc:
-//		Determine if equal
+//		Determine if equal; equal sets store the same words
 //
 //---------------------------------------------------------------------------
 BOOL
@@ -593,29 +523,22 @@ CBitSet::FEqual
 	}
 
 	// skip iterating if we can already tell by the sizes
-	if (CElements() != pbsOther->CElements())
+	if (CElements() != pbsOther->CElements() ||
+		m_ulWordFirst != pbsOther->m_ulWordFirst ||
+		m_cWords != pbsOther->m_cWords)
 	{
 		return false;
 	}
 
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	CBitSetLink *pbslOther = pbsOther->m_bsllist.PtFirst();
-
-	while(NULL != pbsl)
+	for (ULONG ul = 0; ul < m_cWords; ul++)
 	{
-		if (NULL == pbslOther || 
-			pbsl->UlOffset() != pbslOther->UlOffset() ||
-			!pbsl->Pbv()->FEqual(pbslOther->Pbv()))
+		if (m_rgull[ul] != pbsOther->m_rgull[ul])
 		{
 			return false;
 		}
-				
-		pbsl = m_bsllist.PtNext(pbsl);
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther);
 	}
 	
-	// same length implies pbslOther must have reached end as well
-	return pbslOther == NULL;
+	return true;
 }
 
 
@@ -635,21 +558,20 @@ CBitSet::FDisjoint
 	)
 	const
 {
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
-
-	// iterate through other's links an check if disjoint
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
-	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		
-		if (NULL != pbsl && 
-			pbsl->UlOffset() == pbslOther->UlOffset() &&
-			!pbsl->Pbv()->FDisjoint(pbslOther->Pbv()))
+	const ULONG ulWordFirst = std::max(m_ulWordFirst, pbsOther->m_ulWordFirst);
+	const ULONG ulWordEnd = std::min(m_ulWordFirst + m_cWords, pbsOther->m_ulWordFirst + pbsOther->m_cWords);
+
+	if (ulWordFirst >= ulWordEnd)
+	{
+		return true;
+	}
+
+	const ULONG cWords = ulWordEnd - ulWordFirst;
+	const ULLONG *rgull = m_rgull + (ulWordFirst - m_ulWordFirst);
+	const ULLONG *rgullOther = pbsOther->m_rgull + (ulWordFirst - pbsOther->m_ulWordFirst);
+	for (ULONG ul = 0; ul < cWords; ul++)
+	{
+		if (0 != (rgull[ul] & rgullOther[ul]))
 		{
 			return false;
 		}
@@ -670,16 +592,16 @@ CBitSet::FDisjoint
 ULONG
 CBitSet::UlHash() const
 {
-	ULONG ulHash = 0;
-
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	while (NULL != pbsl)
+	if (0 == m_cWords)
 	{
-		ulHash = gpos::UlCombineHashes(ulHash, pbsl->Pbv()->UlHash());
-		pbsl = m_bsllist.PtNext(pbsl);
+		return 0;
 	}
 
-	return ulHash;
+	return gpos::UlCombineHashes
+			(
+			m_ulWordFirst,
+			gpos::UlHashByteArray((BYTE *) m_rgull, GPOS_SIZEOF(m_rgull[0]) * m_cWords)
+			);
 }
 
 
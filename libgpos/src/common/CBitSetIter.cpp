@@ -30,8 +30,7 @@ CBitSetIter::CBitSetIter
 	)
 	:
 	m_bs(bs),
-	m_ulCursor((ULONG)-1),
-	m_pbsl(NULL),
+	m_ulBit(gpos::ulong_max),
 	m_fActive(true)
 {
 }
@@ -50,25 +49,32 @@ CBitSetIter::FAdvance()
 {
 	GPOS_ASSERT(m_fActive && "called advance on exhausted iterator");
 	
-	if (NULL == m_pbsl)
+	// words are read on each advance, so bits cleared during iteration
+	// are skipped
+	ULONG ulWord = m_bs.m_ulWordFirst;
+	ULLONG ull = m_bs.UllWord(ulWord);
+	if (gpos::ulong_max != m_ulBit)
 	{
-		m_pbsl = m_bs.m_bsllist.PtFirst();
+		// clear bits up to and including the current bit
+		ulWord = CBitSet::UlWord(m_ulBit);
+		ull = m_bs.UllWord(ulWord) & ~((CBitSet::UllMask(m_ulBit) << 1) - 1);
 	}
-	
-	while (NULL != m_pbsl)
+
+	while (0 == ull)
 	{
-		if (m_ulCursor + 1 <= m_bs.m_cSizeBits &&
-			m_pbsl->Pbv()->FNextBit(m_ulCursor + 1, m_ulCursor))
+		ulWord = std::max(ulWord + 1, m_bs.m_ulWordFirst);
+		if (ulWord >= m_bs.m_ulWordFirst + m_bs.m_cWords)
 		{
-			break;
+			m_fActive = false;
+			return false;
 		}
 
-		m_pbsl = m_bs.m_bsllist.PtNext(m_pbsl);
-		m_ulCursor = (ULONG)-1;
+		ull = m_bs.UllWord(ulWord);
 	}
 
-	m_fActive = (NULL != m_pbsl);
-	return m_fActive;
+	m_ulBit = ulWord * GPOS_BITSET_WORD_BITS + CBitSet::UlLowestBit(ull);
+
+	return true;
 }
 	
 
@@ -83,10 +89,10 @@ CBitSetIter::FAdvance()
 ULONG
 CBitSetIter::UlBit() const
 {
-	GPOS_ASSERT(m_fActive && NULL != m_pbsl && "iterator uninitialized");
-	GPOS_ASSERT(m_pbsl->Pbv()->FBit(m_ulCursor));
+	GPOS_ASSERT(m_fActive && gpos::ulong_max != m_ulBit && "iterator uninitialized");
+	GPOS_ASSERT(m_bs.FBit(m_ulBit));
 	
-	return m_pbsl->UlOffset() + m_ulCursor;
+	return m_ulBit;
 }
 
 // EOF
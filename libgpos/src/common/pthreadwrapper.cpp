@@ -762,6 +762,104 @@ gpos::pthread::PthrdtPthreadSelf
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		pthread::IPthreadKeyCreate
+//
+//	@doc:
+//		Create a key for thread-specific data
+//
+//---------------------------------------------------------------------------
+INT
+gpos::pthread::IPthreadKeyCreate
+	(
+	PTHREAD_KEY_T *pkey,
+	void (*pfnDestructor)(void*)
+	)
+{
+	GPOS_ASSERT(NULL != pkey);
+
+	INT iRes = pthread_key_create(pkey, pfnDestructor);
+
+	GPOS_ASSERT
+	(
+		0 == iRes ||
+		(EAGAIN == iRes && "Out of thread-specific data keys") ||
+		(ENOMEM == iRes && "Insufficient memory to create key")
+	);
+
+	return iRes;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		pthread::PthreadKeyDelete
+//
+//	@doc:
+//		Delete a key for thread-specific data
+//
+//---------------------------------------------------------------------------
+void
+gpos::pthread::PthreadKeyDelete
+	(
+	PTHREAD_KEY_T key
+	)
+{
+#ifdef GPOS_DEBUG
+	INT iRes =
+#endif // GPOS_DEBUG
+	pthread_key_delete(key);
+
+	GPOS_ASSERT(0 == iRes && "Invalid key");
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		pthread::PvPthreadGetSpecific
+//
+//	@doc:
+//		Get thread-specific data of the calling thread
+//
+//---------------------------------------------------------------------------
+void *
+gpos::pthread::PvPthreadGetSpecific
+	(
+	PTHREAD_KEY_T key
+	)
+{
+	return pthread_getspecific(key);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		pthread::IPthreadSetSpecific
+//
+//	@doc:
+//		Set thread-specific data of the calling thread
+//
+//---------------------------------------------------------------------------
+INT
+gpos::pthread::IPthreadSetSpecific
+	(
+	PTHREAD_KEY_T key,
+	const void *pv
+	)
+{
+	INT iRes = pthread_setspecific(key, pv);
+
+	GPOS_ASSERT
+	(
+		0 == iRes ||
+		(ENOMEM == iRes && "Insufficient memory to set thread-specific data")
+	);
+
+	return iRes;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		pthread::IPthreadSigMask
@@ -12,15 +12,25 @@
 
 #include <syslog.h>
 
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/stat.h>
 
 #include "gpos/assert.h"
 #include "gpos/utils.h"
 
+#include "gpos/common/clibwrapper.h"
 #include "gpos/common/syslibwrapper.h"
 #include "gpos/error/CException.h"
 
+#include <unistd.h>
+
+#ifdef GPOS_Linux
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif // GPOS_Linux
+
 
 using namespace gpos;
 
@@ -153,5 +163,215 @@ gpos::syslib::CloseLog
 	closelog();
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::PvMapAnonymous
+//
+//	@doc:
+//		Map anonymous private memory; return NULL on failure
+//
+//---------------------------------------------------------------------------
+void *
+gpos::syslib::PvMapAnonymous
+	(
+	SIZE_T ulSize
+	)
+{
+	GPOS_ASSERT(0 < ulSize);
+
+	void *pv = mmap(NULL, ulSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1 /*fd*/, 0 /*offset*/);
+	if (MAP_FAILED == pv)
+	{
+		return NULL;
+	}
+
+	return pv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::Unmap
+//
+//	@doc:
+//		Unmap memory obtained by PvMapAnonymous
+//
+//---------------------------------------------------------------------------
+void
+gpos::syslib::Unmap
+	(
+	void *pv,
+	SIZE_T ulSize
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+#ifdef GPOS_DEBUG
+	INT iRes =
+#endif // GPOS_DEBUG
+	munmap(pv, ulSize);
+
+	GPOS_ASSERT(0 == iRes && "Failed to unmap memory");
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::FAdviseHugePages
+//
+//	@doc:
+//		Advise the kernel to back a mapped range with transparent huge pages;
+//		return false if huge pages are not supported
+//
+//---------------------------------------------------------------------------
+BOOL
+gpos::syslib::FAdviseHugePages
+	(
+#ifdef MADV_HUGEPAGE
+	void *pv,
+	SIZE_T ulSize
+#else
+	void *, // pv
+	SIZE_T // ulSize
+#endif // MADV_HUGEPAGE
+	)
+{
+#ifdef MADV_HUGEPAGE
+	return 0 == madvise(pv, ulSize, MADV_HUGEPAGE);
+#else
+	return false;
+#endif // MADV_HUGEPAGE
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::FutexWait
+//
+//	@doc:
+//		Block while the value at the given address equals the expected
+//		value, until woken up or the timeout expires; spurious wake-ups are
+//		possible, callers must re-check the value; on platforms without
+//		futexes, sleep for the timeout
+//
+//---------------------------------------------------------------------------
+void
+gpos::syslib::FutexWait
+	(
+	volatile ULONG *pul,
+	ULONG ulExpected,
+	ULONG ulTimeoutUs
+	)
+{
+	GPOS_ASSERT(NULL != pul);
+
+#ifdef GPOS_Linux
+	struct timespec ts;
+	ts.tv_sec = ulTimeoutUs / GPOS_USEC_IN_SEC;
+	ts.tv_nsec = (ulTimeoutUs % GPOS_USEC_IN_SEC) * 1000;
+
+	(void) syscall(SYS_futex, pul, FUTEX_WAIT_PRIVATE, ulExpected, &ts, NULL, 0);
+#else
+	if (ulExpected == *pul)
+	{
+		clib::USleep(ulTimeoutUs);
+	}
+#endif // GPOS_Linux
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::FutexWake
+//
+//	@doc:
+//		Wake up threads blocked on the given address; on platforms without
+//		futexes, blocked threads wake up when their timeout expires
+//
+//---------------------------------------------------------------------------
+void
+gpos::syslib::FutexWake
+	(
+#ifdef GPOS_Linux
+	volatile ULONG *pul,
+	ULONG ulWaiters
+#else
+	volatile ULONG *, // pul
+	ULONG // ulWaiters
+#endif // GPOS_Linux
+	)
+{
+#ifdef GPOS_Linux
+	(void) syscall(SYS_futex, pul, FUTEX_WAKE_PRIVATE, ulWaiters, NULL, NULL, 0);
+#endif // GPOS_Linux
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		syslib::FBindToCpu
+//
+//	@doc:
+//		Bind calling thread to the processor at the given position, modulo
+//		their number, among the processors the process may run on, or to
+//		all of them if gpos::ulong_max is passed; the process's main thread
+//		is never bound by gpos, hence its affinity mask is the set of
+//		processors granted to the process, e.g. by a cpuset; return false
+//		if binding is not supported
+//
+//---------------------------------------------------------------------------
+BOOL
+gpos::syslib::FBindToCpu
+	(
+#ifdef GPOS_Linux
+	ULONG ulCpu
+#else
+	ULONG // ulCpu
+#endif // GPOS_Linux
+	)
+{
+#ifdef GPOS_Linux
+	cpu_set_t cpusetProcess;
+	CPU_ZERO(&cpusetProcess);
+	if (0 != sched_getaffinity(getpid(), sizeof(cpusetProcess), &cpusetProcess))
+	{
+		return false;
+	}
+
+	const ULONG ulCpus = (ULONG) CPU_COUNT(&cpusetProcess);
+	if (gpos::ulong_max == ulCpu || 0 == ulCpus)
+	{
+		// pid 0 denotes the calling thread
+		return 0 == sched_setaffinity(0, sizeof(cpusetProcess), &cpusetProcess);
+	}
+
+	// find the processor at the given position of the process's mask
+	ULONG ulPos = ulCpu % ulCpus;
+	ULONG ulCpuBound = 0;
+	for (; ulCpuBound < CPU_SETSIZE; ulCpuBound++)
+	{
+		if (CPU_ISSET(ulCpuBound, &cpusetProcess))
+		{
+			if (0 == ulPos)
+			{
+				break;
+			}
+
+			ulPos--;
+		}
+	}
+	GPOS_ASSERT(ulCpuBound < CPU_SETSIZE);
+
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	CPU_SET(ulCpuBound, &cpuset);
+
+	return 0 == sched_setaffinity(0, sizeof(cpuset), &cpuset);
+#else
+	return false;
+#endif // GPOS_Linux
+}
+
 // EOF
 
@@ -243,7 +243,8 @@ CFSimulator::CFSimulator
 		GPOS_OFFSET(CStackTracker, m_skey),
 		&(CStackTracker::m_skeyInvalid),
 		CStackTracker::SStackKey::UlHash,
-		CStackTracker::SStackKey::FEqual
+		CStackTracker::SStackKey::FEqual,
+		false /*fResizable*/
 		);
 }
 
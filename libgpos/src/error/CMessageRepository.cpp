@@ -188,7 +188,8 @@ CMessageRepository::InitDirectory
 		GPOS_OFFSET(CMessageTable, m_eloc),
 		&(CMessageTable::m_elocInvalid),
 		CMessageTable::UlHash,
-		CMessageTable::FEqual
+		CMessageTable::FEqual,
+		false /*fResizable*/
 		);
 }
 
@@ -44,7 +44,8 @@ CMessageTable::CMessageTable
 		GPOS_OFFSET(CMessage, m_exc),
 		&(CException::m_excInvalid),
 		CException::UlHash,
-		CException::FEqual
+		CException::FEqual,
+		false /*fResizable*/
 		);
 }
 
@@ -43,12 +43,13 @@ CAutoMemoryPool::CAutoMemoryPool
 	ELeakCheck elc,
 	CMemoryPoolManager::EAllocType ept,
 	BOOL fThreadSafe,
-	ULLONG ullCapacity
+	ULLONG ullCapacity,
+	BOOL fHugePages
 	)
 	:
 	m_elc(elc)
 {
-	m_pmp = CMemoryPoolManager::Pmpm()->PmpCreate(ept, fThreadSafe, ullCapacity);
+	m_pmp = CMemoryPoolManager::Pmpm()->PmpCreate(ept, fThreadSafe, ullCapacity, fHugePages);
 }
 
 
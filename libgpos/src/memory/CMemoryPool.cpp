@@ -17,6 +17,7 @@
 #endif // GPOS_DEBUG
 #include "gpos/memory/CMemoryPool.h"
 #include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/memory/CMemoryProfile.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
 #include "gpos/task/ITask.h"
 
@@ -96,6 +97,7 @@ CMemoryPool::PvFinalizeAlloc
 	SAllocHeader *pah = static_cast<SAllocHeader*>(pv);
 	pah->m_pmp = this;
 	pah->m_ulAlloc = ulAlloc;
+	pah->m_ulProfileTag = 0;
 
 	BYTE *pbAllocType = reinterpret_cast<BYTE*>(pah + 1) + ulAlloc;
 	*pbAllocType = eat;
@@ -104,6 +106,35 @@ CMemoryPool::PvFinalizeAlloc
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPool::RecordProfiledAlloc
+//
+//	@doc:
+//		Record allocation in the profile of the calling task, if any;
+//		allocations are attributed to the call site of GPOS_NEW
+//		regardless of the pool they are placed in
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPool::RecordProfiledAlloc
+	(
+	void *pv,
+	const CHAR *szFile,
+	ULONG ulLine
+	)
+{
+	CMemoryProfile *pmprof = CMemoryProfile::PmprofSelf();
+	if (NULL == pmprof)
+	{
+		return;
+	}
+
+	SAllocHeader *pah = static_cast<SAllocHeader*>(pv) - 1;
+	pah->m_ulProfileTag = pmprof->UlRecordAllocation(pv, szFile, ulLine, pah->m_ulAlloc);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPool::FreeAlloc
@@ -124,6 +155,16 @@ CMemoryPool::FreeAlloc
 	SAllocHeader *pah = static_cast<SAllocHeader*>(pv) - 1;
 	BYTE *pbAllocType = static_cast<BYTE*>(pv) + pah->m_ulAlloc;
 	GPOS_RTL_ASSERT(*pbAllocType == eat);
+
+	if (0 != pah->m_ulProfileTag)
+	{
+		CMemoryProfile *pmprof = CMemoryProfile::PmprofSelf();
+		if (NULL != pmprof)
+		{
+			pmprof->RecordFree(pv, pah->m_ulProfileTag, pah->m_ulAlloc);
+		}
+	}
+
 	pah->m_pmp->Free(pah);
 
 }
@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolArena.cpp
+//
+//	@doc:
+//		Implementation of arena memory pool that bump-allocates from large
+//		chunks and releases them all at once on tear-down.
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPoolArena.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+
+
+#define GPOS_MEM_ARENA_CHUNK_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SChunk))
+
+
+using namespace gpos;
+
+GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_ARENA_CHUNK_MIN));
+GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_ARENA_CHUNK_MAX));
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::CMemoryPoolArena
+//
+//	@doc:
+//	  ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolArena::CMemoryPoolArena
+	(
+	IMemoryPool *pmp,
+	ULLONG ullCapacity,
+	BOOL fThreadSafe,
+	BOOL fOwnsUnderlying,
+	ULONG ulChunkSizeMin
+	)
+	:
+	CMemoryPool(pmp, fOwnsUnderlying, fThreadSafe),
+	m_pchunkCurrent(NULL),
+	m_ulChunkSizeMin(ulChunkSizeMin),
+	m_ulChunkSize(ulChunkSizeMin),
+	m_ulChunks(0),
+	m_ullReserved(0),
+	m_ullCapacity(ullCapacity)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(MAX_ALIGNED(ulChunkSizeMin));
+	GPOS_ASSERT(GPOS_MEM_ARENA_CHUNK_MAX >= ulChunkSizeMin);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::~CMemoryPoolArena
+//
+//	@doc:
+//		Dtor.
+//
+//---------------------------------------------------------------------------
+CMemoryPoolArena::~CMemoryPoolArena()
+{
+	GPOS_ASSERT(NULL == m_pchunkCurrent);
+	GPOS_ASSERT(0 == m_ulChunks);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::PvAllocate
+//
+//	@doc:
+//		Allocate memory by advancing the offset in the current chunk;
+//		request a new chunk if the current one cannot fit the request
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolArena::PvAllocate
+	(
+	ULONG ulBytes,
+	const CHAR *,  // szFile
+	const ULONG    // ulLine
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= ulBytes);
+
+	ULONG ulAlloc = GPOS_MEM_ALIGNED_SIZE(ulBytes);
+	GPOS_ASSERT(MAX_ALIGNED(ulAlloc));
+
+	CAutoSpinlock as(m_slock);
+	if (FThreadSafe())
+	{
+		as.Lock();
+	}
+
+	SChunk *pchunk = m_pchunkCurrent;
+	if (NULL == pchunk || !pchunk->FFit(ulAlloc))
+	{
+		pchunk = PchunkNew(ulAlloc);
+		if (NULL == pchunk)
+		{
+			return NULL;
+		}
+	}
+
+	void *pvAlloc = GPOS_MEM_OFFSET_POS(pchunk, pchunk->m_ulUsed);
+	pchunk->m_ulUsed += ulAlloc;
+
+	return pvAlloc;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::PchunkNew
+//
+//	@doc:
+//		Allocate chunk from underlying pool; regular chunks replace the
+//		current chunk, oversized chunks are linked behind it
+//
+//---------------------------------------------------------------------------
+CMemoryPoolArena::SChunk *
+CMemoryPoolArena::PchunkNew
+	(
+	ULONG ulAlloc
+	)
+{
+	const ULONG ulRequired = ulAlloc + (ULONG) GPOS_MEM_ARENA_CHUNK_HEADER_SIZE;
+	const BOOL fOversized = (ulRequired > m_ulChunkSize);
+	ULONG ulChunkSize = fOversized ? ulRequired : m_ulChunkSize;
+
+	// check if memory pool has enough capacity
+	if (gpos::ullong_max != m_ullCapacity && ulChunkSize + m_ullReserved > m_ullCapacity)
+	{
+		if (ulRequired + m_ullReserved > m_ullCapacity)
+		{
+			return NULL;
+		}
+
+		// shrink chunk to the remaining capacity
+		ulChunkSize = GPOS_MEM_ARCH * (ULONG) ((m_ullCapacity - m_ullReserved) / GPOS_MEM_ARCH);
+	}
+	GPOS_ASSERT(MAX_ALIGNED(ulChunkSize));
+
+	SChunk *pchunk = static_cast<SChunk*>
+			(
+			PmpUnderlying()->PvAllocate(ulChunkSize, __FILE__, __LINE__)
+			);
+
+	if (NULL == pchunk)
+	{
+		return NULL;
+	}
+
+	if (fOversized && NULL != m_pchunkCurrent)
+	{
+		// keep serving small requests from the current chunk
+		pchunk->Init(ulChunkSize, m_pchunkCurrent->m_pchunkNext);
+		m_pchunkCurrent->m_pchunkNext = pchunk;
+	}
+	else
+	{
+		pchunk->Init(ulChunkSize, m_pchunkCurrent);
+		m_pchunkCurrent = pchunk;
+
+		if (!fOversized)
+		{
+			m_ulChunkSize = std::min((ULONG) GPOS_MEM_ARENA_CHUNK_MAX, 2 * m_ulChunkSize);
+		}
+	}
+
+	m_ullReserved += ulChunkSize;
+	m_ulChunks++;
+
+	return pchunk;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::TearDown
+//
+//	@doc:
+//		Return all chunks to the underlying pool and tear it down.
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolArena::TearDown()
+{
+	GPOS_ASSERT(!m_slock.FOwned());
+
+	SChunk *pchunk = m_pchunkCurrent;
+	while (NULL != pchunk)
+	{
+		SChunk *pchunkNext = pchunk->m_pchunkNext;
+		PmpUnderlying()->Free(pchunk);
+		pchunk = pchunkNext;
+	}
+
+	CMemoryPool::TearDown();
+
+	m_pchunkCurrent = NULL;
+	m_ulChunkSize = m_ulChunkSizeMin;
+	m_ulChunks = 0;
+	m_ullReserved = 0;
+}
+
+#ifdef GPOS_DEBUG
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolArena::CheckAllocation
+//
+//	@doc:
+//		Verifies that an allocation is correct and came from this pool.
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolArena::CheckAllocation
+	(
+	void *pv
+	)
+{
+	CAutoSpinlock as(m_slock);
+	if (FThreadSafe())
+	{
+		as.Lock();
+	}
+
+	SChunk *pchunk = m_pchunkCurrent;
+	while (NULL != pchunk)
+	{
+		if (pv >= GPOS_MEM_OFFSET_POS(pchunk, GPOS_MEM_ARENA_CHUNK_HEADER_SIZE) &&
+			pv < GPOS_MEM_OFFSET_POS(pchunk, pchunk->m_ulUsed))
+		{
+			return;
+		}
+
+		pchunk = pchunk->m_pchunkNext;
+	}
+
+	GPOS_ASSERT(!"object is allocated in one of the chunks");
+}
+
+#endif // GPOS_DEBUG
+
+// EOF
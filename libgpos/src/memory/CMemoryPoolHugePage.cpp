@@ -0,0 +1,805 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolHugePage.cpp
+//
+//	@doc:
+//		Implementation of memory pool that serves large requests from
+//		memory regions backed by transparent huge pages
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/common/syslibwrapper.h"
+#include "gpos/memory/CMemoryPoolHugePage.h"
+#include "gpos/sync/atomic.h"
+
+#define GPOS_MEM_HUGE_PAGE_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader))
+
+// number of granules in a bitmap word
+#define GPOS_MEM_HUGE_PAGE_WORD_BITS (64)
+
+// number of huge pages of a region
+#define GPOS_MEM_HUGE_PAGE_REGION_PAGES (GPOS_MEM_HUGE_PAGE_REGION_SIZE / GPOS_MEM_HUGE_PAGE_SIZE)
+
+// marker of a removed entry of the page table
+#define GPOS_MEM_HUGE_PAGE_REMOVED (ULONG_PTR_MAX)
+
+using namespace gpos;
+
+GPOS_CPL_ASSERT(0 == GPOS_MEM_HUGE_PAGE_REGION_SIZE % GPOS_MEM_HUGE_PAGE_SIZE);
+GPOS_CPL_ASSERT(0 == GPOS_MEM_HUGE_PAGE_GRANULES % GPOS_MEM_HUGE_PAGE_WORD_BITS);
+GPOS_CPL_ASSERT(0 == (GPOS_MEM_HUGE_PAGE_TABLE_SIZE & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1)));
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::CMemoryPoolHugePage
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolHugePage::CMemoryPoolHugePage
+	(
+	IMemoryPool *pmp,
+	BOOL fOwnsUnderlying
+	)
+	:
+	CMemoryPool(pmp, fOwnsUnderlying, true /*fThreadSafe*/),
+	m_ulHugePageRegions(0),
+	m_ullMapped(0),
+	m_ulPageTable(0),
+	m_ulpPageTableVersion(0),
+	m_ulPages(0),
+	m_ulPageSlots(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	m_listRegions.Init(GPOS_OFFSET(SRegion, m_link));
+	m_listMappings.Init(GPOS_OFFSET(SAllocHeader, m_link));
+
+	for (ULONG ul = 0; ul < GPOS_MEM_HUGE_PAGE_TABLE_SIZE; ul++)
+	{
+		m_rgrgulpPages[0][ul] = 0;
+		m_rgrgulpPages[1][ul] = 0;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::~CMemoryPoolHugePage
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolHugePage::~CMemoryPoolHugePage()
+{
+	GPOS_ASSERT(m_listRegions.FEmpty());
+	GPOS_ASSERT(m_listMappings.FEmpty());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::RehashPages
+//
+//	@doc:
+//		Copy the pages of the page table in use into the other table
+//		without removed entries, and switch tables; lookups that overlap
+//		with rehashing see the version of the tables change and are repeated
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::RehashPages()
+{
+	GPOS_ASSERT(m_slock.FOwned());
+
+	const ULONG ulTable = m_ulPageTable;
+	const volatile ULONG_PTR *rgulpFrom = m_rgrgulpPages[ulTable];
+	volatile ULONG_PTR *rgulpTo = m_rgrgulpPages[1 - ulTable];
+
+	// mark tables as being rehashed
+	(void) UlpExchangeAdd(&m_ulpPageTableVersion, 1);
+
+	for (ULONG ul = 0; ul < GPOS_MEM_HUGE_PAGE_TABLE_SIZE; ul++)
+	{
+		rgulpTo[ul] = 0;
+	}
+
+	for (ULONG ul = 0; ul < GPOS_MEM_HUGE_PAGE_TABLE_SIZE; ul++)
+	{
+		const ULONG_PTR ulpPage = rgulpFrom[ul];
+		if (0 == ulpPage || GPOS_MEM_HUGE_PAGE_REMOVED == ulpPage)
+		{
+			continue;
+		}
+
+		ULONG ulSlot = UlPageSlot(ulpPage);
+		while (0 != rgulpTo[ulSlot])
+		{
+			ulSlot = (ulSlot + 1) & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1);
+		}
+		rgulpTo[ulSlot] = ulpPage;
+	}
+
+	m_ulPageTable = 1 - ulTable;
+	m_ulPageSlots = m_ulPages;
+
+	(void) UlpExchangeAdd(&m_ulpPageTableVersion, 1);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::FInsertPages
+//
+//	@doc:
+//		Add huge pages starting at given page-aligned address to the page
+//		table; removed entries are reused, and dropped by rehashing once
+//		they would leave too few empty slots; return false if the table is
+//		full
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemoryPoolHugePage::FInsertPages
+	(
+	const void *pv,
+	ULONG ulPages
+	)
+{
+	GPOS_ASSERT(m_slock.FOwned());
+	GPOS_ASSERT(0 == ((ULONG_PTR) pv) % GPOS_MEM_HUGE_PAGE_SIZE);
+
+	// keep half of the slots empty so that lookups of memory of the
+	// underlying pool terminate quickly
+	if (m_ulPages + ulPages > GPOS_MEM_HUGE_PAGE_TABLE_SIZE / 2)
+	{
+		return false;
+	}
+
+	if (m_ulPageSlots + ulPages > GPOS_MEM_HUGE_PAGE_TABLE_SIZE / 2)
+	{
+		RehashPages();
+	}
+
+	volatile ULONG_PTR *rgulpPages = m_rgrgulpPages[m_ulPageTable];
+	const ULONG_PTR ulpFirst = UlpPage(pv);
+	for (ULONG_PTR ulpPage = ulpFirst; ulpPage < ulpFirst + ulPages; ulpPage++)
+	{
+		ULONG ulSlot = UlPageSlot(ulpPage);
+		while (0 != rgulpPages[ulSlot] && GPOS_MEM_HUGE_PAGE_REMOVED != rgulpPages[ulSlot])
+		{
+			GPOS_ASSERT(ulpPage != rgulpPages[ulSlot]);
+			ulSlot = (ulSlot + 1) & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1);
+		}
+
+		if (0 == rgulpPages[ulSlot])
+		{
+			m_ulPageSlots++;
+		}
+		rgulpPages[ulSlot] = ulpPage;
+	}
+	m_ulPages += ulPages;
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::RemovePages
+//
+//	@doc:
+//		Remove huge pages starting at given address from the page table;
+//		entries are marked as removed so that probing for other pages
+//		continues past them
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::RemovePages
+	(
+	const void *pv,
+	ULONG ulPages
+	)
+{
+	GPOS_ASSERT(m_slock.FOwned());
+	GPOS_ASSERT(ulPages <= m_ulPages);
+
+	volatile ULONG_PTR *rgulpPages = m_rgrgulpPages[m_ulPageTable];
+	const ULONG_PTR ulpFirst = UlpPage(pv);
+	for (ULONG_PTR ulpPage = ulpFirst; ulpPage < ulpFirst + ulPages; ulpPage++)
+	{
+		ULONG ulSlot = UlPageSlot(ulpPage);
+		while (ulpPage != rgulpPages[ulSlot])
+		{
+			GPOS_ASSERT(0 != rgulpPages[ulSlot]);
+			ulSlot = (ulSlot + 1) & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1);
+		}
+
+		rgulpPages[ulSlot] = GPOS_MEM_HUGE_PAGE_REMOVED;
+	}
+	m_ulPages -= ulPages;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::FOwned
+//
+//	@doc:
+//		Is address within memory mapped by the pool; the page of a live
+//		allocation is neither added nor removed concurrently, hence the
+//		table is probed without locking; the lookup is repeated if the
+//		tables were rehashed while probing
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemoryPoolHugePage::FOwned
+	(
+	const void *pv
+	)
+	const
+{
+	const ULONG_PTR ulpPage = UlpPage(pv);
+
+	while (true)
+	{
+		const ULONG_PTR ulpVersion = m_ulpPageTableVersion;
+		if (0 != ulpVersion % 2)
+		{
+			// tables are being rehashed
+			continue;
+		}
+
+		const volatile ULONG_PTR *rgulpPages = m_rgrgulpPages[m_ulPageTable];
+		BOOL fOwned = false;
+		ULONG ulSlot = UlPageSlot(ulpPage);
+		for (ULONG ul = 0; ul < GPOS_MEM_HUGE_PAGE_TABLE_SIZE; ul++)
+		{
+			const ULONG_PTR ulpSlot = rgulpPages[ulSlot];
+			if (ulpPage == ulpSlot)
+			{
+				fOwned = true;
+				break;
+			}
+
+			if (0 == ulpSlot)
+			{
+				break;
+			}
+
+			ulSlot = (ulSlot + 1) & (GPOS_MEM_HUGE_PAGE_TABLE_SIZE - 1);
+		}
+
+		if (ulpVersion == m_ulpPageTableVersion)
+		{
+			return fOwned;
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::PvMapAligned
+//
+//	@doc:
+//		Map memory aligned to huge page size and advise the kernel to back
+//		it by huge pages; return NULL on failure
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolHugePage::PvMapAligned
+	(
+	SIZE_T ulSize,
+	BOOL *pfHugePages
+	)
+{
+	GPOS_ASSERT(0 == ulSize % GPOS_MEM_HUGE_PAGE_SIZE);
+	GPOS_ASSERT(NULL != pfHugePages);
+
+	// over-allocate by a huge page, then trim to an aligned range
+	const SIZE_T ulMapped = ulSize + GPOS_MEM_HUGE_PAGE_SIZE;
+	BYTE *pbMapped = static_cast<BYTE*>(syslib::PvMapAnonymous(ulMapped));
+	if (NULL == pbMapped)
+	{
+		return NULL;
+	}
+
+	const ULONG_PTR ulpMapped = (ULONG_PTR) pbMapped;
+	const ULONG_PTR ulpAligned =
+		(ulpMapped + GPOS_MEM_HUGE_PAGE_SIZE - 1) & ~((ULONG_PTR) GPOS_MEM_HUGE_PAGE_SIZE - 1);
+	BYTE *pbAligned = pbMapped + (ulpAligned - ulpMapped);
+
+	const SIZE_T ulHead = pbAligned - pbMapped;
+	const SIZE_T ulTail = ulMapped - ulHead - ulSize;
+	if (0 < ulHead)
+	{
+		syslib::Unmap(pbMapped, ulHead);
+	}
+	if (0 < ulTail)
+	{
+		syslib::Unmap(pbAligned + ulSize, ulTail);
+	}
+
+	*pfHugePages = syslib::FAdviseHugePages(pbAligned, ulSize);
+
+	return pbAligned;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::PregionNew
+//
+//	@doc:
+//		Map a new region; the caller links it into the list
+//
+//---------------------------------------------------------------------------
+CMemoryPoolHugePage::SRegion *
+CMemoryPoolHugePage::PregionNew()
+{
+	SRegion *pregion = static_cast<SRegion*>
+			(
+			PmpUnderlying()->PvAllocate(GPOS_SIZEOF(SRegion), __FILE__, __LINE__)
+			);
+	if (NULL == pregion)
+	{
+		return NULL;
+	}
+
+	BOOL fHugePages = false;
+	pregion->m_pb = static_cast<BYTE*>(PvMapAligned(GPOS_MEM_HUGE_PAGE_REGION_SIZE, &fHugePages));
+	if (NULL == pregion->m_pb)
+	{
+		PmpUnderlying()->Free(pregion);
+		return NULL;
+	}
+
+	pregion->m_ulFree = GPOS_MEM_HUGE_PAGE_GRANULES;
+	pregion->m_fHugePages = fHugePages;
+	(void) clib::PvMemSet(pregion->m_rgullUsed, 0, sizeof(pregion->m_rgullUsed));
+
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	if (!FInsertPages(pregion->m_pb, GPOS_MEM_HUGE_PAGE_REGION_PAGES))
+	{
+		as.Unlock();
+		UnmapRegion(pregion);
+
+		return NULL;
+	}
+
+	m_listRegions.Append(pregion);
+	m_ullMapped += GPOS_MEM_HUGE_PAGE_REGION_SIZE;
+	if (fHugePages)
+	{
+		m_ulHugePageRegions++;
+	}
+
+	return pregion;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::UnmapRegion
+//
+//	@doc:
+//		Unmap a region that was removed from the list
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::UnmapRegion
+	(
+	SRegion *pregion
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_HUGE_PAGE_GRANULES == pregion->m_ulFree);
+
+	syslib::Unmap(pregion->m_pb, GPOS_MEM_HUGE_PAGE_REGION_SIZE);
+	PmpUnderlying()->Free(pregion);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::UlFindRun
+//
+//	@doc:
+//		Find a run of free granules in a region, return its index or
+//		ulong_max if none was found
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolHugePage::UlFindRun
+	(
+	const SRegion *pregion,
+	ULONG ulGranules
+	)
+{
+	GPOS_ASSERT(0 < ulGranules);
+
+	if (pregion->m_ulFree < ulGranules)
+	{
+		return gpos::ulong_max;
+	}
+
+	ULONG ulRun = 0;
+	ULONG ul = 0;
+	while (ul < GPOS_MEM_HUGE_PAGE_GRANULES)
+	{
+		const ULLONG ullWord = pregion->m_rgullUsed[ul / GPOS_MEM_HUGE_PAGE_WORD_BITS];
+		if (0 == ul % GPOS_MEM_HUGE_PAGE_WORD_BITS && gpos::ullong_max == ullWord)
+		{
+			// skip fully used word
+			ulRun = 0;
+			ul += GPOS_MEM_HUGE_PAGE_WORD_BITS;
+			continue;
+		}
+
+		if (0 == ((ullWord >> (ul % GPOS_MEM_HUGE_PAGE_WORD_BITS)) & 1))
+		{
+			ulRun++;
+			if (ulRun == ulGranules)
+			{
+				return ul + 1 - ulGranules;
+			}
+		}
+		else
+		{
+			ulRun = 0;
+		}
+
+		ul++;
+	}
+
+	return gpos::ulong_max;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::MarkRun
+//
+//	@doc:
+//		Set granules of a run as used or free
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::MarkRun
+	(
+	SRegion *pregion,
+	ULONG ulFirst,
+	ULONG ulGranules,
+	BOOL fUsed
+	)
+{
+	GPOS_ASSERT(ulFirst + ulGranules <= GPOS_MEM_HUGE_PAGE_GRANULES);
+
+	for (ULONG ul = ulFirst; ul < ulFirst + ulGranules; ul++)
+	{
+		ULLONG &ullWord = pregion->m_rgullUsed[ul / GPOS_MEM_HUGE_PAGE_WORD_BITS];
+		const ULLONG ullBit = ((ULLONG) 1) << (ul % GPOS_MEM_HUGE_PAGE_WORD_BITS);
+
+		GPOS_ASSERT(fUsed == (0 == (ullWord & ullBit)));
+		if (fUsed)
+		{
+			ullWord |= ullBit;
+		}
+		else
+		{
+			ullWord &= ~ullBit;
+		}
+	}
+
+	if (fUsed)
+	{
+		pregion->m_ulFree -= ulGranules;
+	}
+	else
+	{
+		pregion->m_ulFree += ulGranules;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::PvAllocateFromRegion
+//
+//	@doc:
+//		Allocate a run of granules, mapping a new region if no region
+//		has enough free granules
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolHugePage::PvAllocateFromRegion
+	(
+	ULONG ulGranules
+	)
+{
+	GPOS_ASSERT(ulGranules <= GPOS_MEM_HUGE_PAGE_GRANULES);
+
+	// scope for spinlock
+	{
+		CAutoSpinlock as(m_slock);
+		as.Lock();
+
+		SRegion *pregion = m_listRegions.PtFirst();
+		while (NULL != pregion)
+		{
+			const ULONG ulFirst = UlFindRun(pregion, ulGranules);
+			if (gpos::ulong_max != ulFirst)
+			{
+				MarkRun(pregion, ulFirst, ulGranules, true /*fUsed*/);
+
+				SAllocHeader *pah = reinterpret_cast<SAllocHeader*>
+						(
+						pregion->m_pb + (ULLONG) ulFirst * GPOS_MEM_HUGE_PAGE_GRANULE
+						);
+				pah->m_pregion = pregion;
+				pah->m_ullSize = ulGranules;
+				pah->m_ulOrigin = EaoRegion;
+
+				return pah;
+			}
+
+			pregion = m_listRegions.PtNext(pregion);
+		}
+	}
+
+	// map without holding the spinlock; another thread may map a region
+	// concurrently, in which case the pool temporarily holds an extra region
+	SRegion *pregion = PregionNew();
+	if (NULL == pregion)
+	{
+		return NULL;
+	}
+
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	const ULONG ulFirst = UlFindRun(pregion, ulGranules);
+	if (gpos::ulong_max == ulFirst)
+	{
+		// region was taken by concurrent allocations
+		return NULL;
+	}
+
+	MarkRun(pregion, ulFirst, ulGranules, true /*fUsed*/);
+
+	SAllocHeader *pah = reinterpret_cast<SAllocHeader*>
+			(
+			pregion->m_pb + (ULLONG) ulFirst * GPOS_MEM_HUGE_PAGE_GRANULE
+			);
+	pah->m_pregion = pregion;
+	pah->m_ullSize = ulGranules;
+	pah->m_ulOrigin = EaoRegion;
+
+	return pah;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::PvAllocateMapping
+//
+//	@doc:
+//		Allocate a dedicated mapping
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolHugePage::PvAllocateMapping
+	(
+	ULLONG ullSize
+	)
+{
+	GPOS_ASSERT(0 == ullSize % GPOS_MEM_HUGE_PAGE_SIZE);
+
+	BOOL fHugePages = false;
+	SAllocHeader *pah = static_cast<SAllocHeader*>(PvMapAligned(ullSize, &fHugePages));
+	if (NULL == pah)
+	{
+		return NULL;
+	}
+
+	pah->m_pregion = NULL;
+	pah->m_ullSize = ullSize;
+	pah->m_ulOrigin = EaoMapping;
+
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	// allocations of a mapping start within its first huge page
+	if (!FInsertPages(pah, 1 /*ulPages*/))
+	{
+		as.Unlock();
+		syslib::Unmap(pah, ullSize);
+
+		return NULL;
+	}
+
+	m_listMappings.Append(pah);
+	m_ullMapped += ullSize;
+
+	return pah;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::PvAllocate
+//
+//	@doc:
+//		Allocate memory; requests that do not fill a granule go to the
+//		underlying pool without a header
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolHugePage::PvAllocate
+	(
+	const ULONG ulBytes,
+	const CHAR *szFile,
+	const ULONG ulLine
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= ulBytes);
+
+	const ULLONG ullSize = GPOS_MEM_HUGE_PAGE_HEADER_SIZE + GPOS_MEM_ALIGNED_SIZE((ULLONG) ulBytes);
+
+	SAllocHeader *pah = NULL;
+	if (GPOS_MEM_HUGE_PAGE_REGION_SIZE < ullSize)
+	{
+		const ULLONG ullPages = (ullSize + GPOS_MEM_HUGE_PAGE_SIZE - 1) / GPOS_MEM_HUGE_PAGE_SIZE;
+		pah = static_cast<SAllocHeader*>(PvAllocateMapping(ullPages * GPOS_MEM_HUGE_PAGE_SIZE));
+	}
+	else if (GPOS_MEM_HUGE_PAGE_GRANULE <= ullSize)
+	{
+		const ULONG ulGranules = (ULONG) ((ullSize + GPOS_MEM_HUGE_PAGE_GRANULE - 1) / GPOS_MEM_HUGE_PAGE_GRANULE);
+		pah = static_cast<SAllocHeader*>(PvAllocateFromRegion(ulGranules));
+	}
+
+	if (NULL == pah)
+	{
+		// small request, or mapping memory failed
+		return PmpUnderlying()->PvAllocate(ulBytes, szFile, ulLine);
+	}
+
+	return GPOS_MEM_OFFSET_POS(pah, GPOS_MEM_HUGE_PAGE_HEADER_SIZE);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::Free
+//
+//	@doc:
+//		Free memory; regions that become empty are unmapped, unless they
+//		are the last region of the pool
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::Free
+	(
+	void *pv
+	)
+{
+	if (!FOwned(pv))
+	{
+		PmpUnderlying()->Free(pv);
+		return;
+	}
+
+	SAllocHeader *pah = reinterpret_cast<SAllocHeader*>(static_cast<BYTE*>(pv) - GPOS_MEM_HUGE_PAGE_HEADER_SIZE);
+
+	switch (pah->m_ulOrigin)
+	{
+		case EaoMapping:
+		{
+			const ULLONG ullSize = pah->m_ullSize;
+
+			// scope for spinlock
+			{
+				CAutoSpinlock as(m_slock);
+				as.Lock();
+
+				m_listMappings.Remove(pah);
+				RemovePages(pah, 1 /*ulPages*/);
+				m_ullMapped -= ullSize;
+			}
+
+			syslib::Unmap(pah, ullSize);
+			break;
+		}
+
+		case EaoRegion:
+		{
+			SRegion *pregion = pah->m_pregion;
+			const ULONG ulFirst =
+				(ULONG) ((reinterpret_cast<BYTE*>(pah) - pregion->m_pb) / GPOS_MEM_HUGE_PAGE_GRANULE);
+
+			CAutoSpinlock as(m_slock);
+			as.Lock();
+
+			MarkRun(pregion, ulFirst, (ULONG) pah->m_ullSize, false /*fUsed*/);
+
+			if (GPOS_MEM_HUGE_PAGE_GRANULES == pregion->m_ulFree && 1 < m_listRegions.UlSize())
+			{
+				m_listRegions.Remove(pregion);
+				RemovePages(pregion->m_pb, GPOS_MEM_HUGE_PAGE_REGION_PAGES);
+				m_ullMapped -= GPOS_MEM_HUGE_PAGE_REGION_SIZE;
+				if (pregion->m_fHugePages)
+				{
+					m_ulHugePageRegions--;
+				}
+
+				as.Unlock();
+				UnmapRegion(pregion);
+			}
+			break;
+		}
+
+		default:
+			GPOS_ASSERT(!"Invalid allocation origin");
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolHugePage::TearDown
+//
+//	@doc:
+//		Return all regions and mappings to the OS and tear down the pool
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolHugePage::TearDown()
+{
+	GPOS_ASSERT(!m_slock.FOwned());
+
+	while (!m_listMappings.FEmpty())
+	{
+		SAllocHeader *pah = m_listMappings.RemoveHead();
+		syslib::Unmap(pah, pah->m_ullSize);
+	}
+
+	while (!m_listRegions.FEmpty())
+	{
+		SRegion *pregion = m_listRegions.RemoveHead();
+		syslib::Unmap(pregion->m_pb, GPOS_MEM_HUGE_PAGE_REGION_SIZE);
+		PmpUnderlying()->Free(pregion);
+	}
+
+	m_ullMapped = 0;
+	m_ulHugePageRegions = 0;
+
+	for (ULONG ul = 0; ul < GPOS_MEM_HUGE_PAGE_TABLE_SIZE; ul++)
+	{
+		m_rgrgulpPages[0][ul] = 0;
+		m_rgrgulpPages[1][ul] = 0;
+	}
+	m_ulPageTable = 0;
+	m_ulPages = 0;
+	m_ulPageSlots = 0;
+
+	CMemoryPool::TearDown();
+}
+
+// EOF
+
@@ -19,9 +19,12 @@
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/memory/IMemoryPool.h"
 #include "gpos/memory/CMemoryPoolAlloc.h"
+#include "gpos/memory/CMemoryPoolArena.h"
+#include "gpos/memory/CMemoryPoolHugePage.h"
 #include "gpos/memory/CMemoryPoolInjectFault.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/memory/CMemoryPoolStack.h"
+#include "gpos/memory/CMemoryPoolThreadCache.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
 #include "gpos/sync/CAutoSpinlock.h"
@@ -51,6 +54,7 @@ CMemoryPoolManager::CMemoryPoolManager
 	)
 	:
 	m_pmpBase(pmpBase),
+	m_pmpHugePage(NULL),
 	m_pmpInternal(pmpInternal),
 	m_pmpGlobal(NULL),
 	m_fAllowGlobalNew(true)
@@ -68,9 +72,14 @@ CMemoryPoolManager::CMemoryPoolManager
 		GPOS_OFFSET(CMemoryPool, m_ulpKey),
 		&(CMemoryPool::m_ulpInvalid),
 		UlHashUlp,
-		FEqualUlp
+		FEqualUlp,
+		false /*fResizable*/
 		);
 
+	// create base pool for pools that request huge pages; it is not
+	// registered since it outlives all registered pools
+	m_pmpHugePage = GPOS_NEW(m_pmpInternal) CMemoryPoolHugePage(m_pmpBase, false /*fOwnsUnderlying*/);
+
 	// create pool used in allocations made using global new operator
 	m_pmpGlobal = PmpCreate(EatTracker, true, gpos::ullong_max);
 }
@@ -118,6 +127,9 @@ CMemoryPoolManager::EresInit
 			false //fOwnsUnderlyingPmp
 			);
 
+	// thread caches keep their per-thread tables in the internal pool
+	CMemoryPoolThreadCache::InitThreadKey(pmpInternal);
+
 	// instantiate manager
 	GPOS_TRY
 	{
@@ -129,6 +141,8 @@ CMemoryPoolManager::EresInit
 	}
 	GPOS_CATCH_EX(ex)
 	{
+		CMemoryPoolThreadCache::ReleaseThreadKey();
+
 		if (GPOS_MATCH_EX(ex, CException::ExmaSystem, CException::ExmiOOM))
 		{
 			Free(pvAllocBase);
@@ -158,14 +172,29 @@ CMemoryPoolManager::PmpCreate
 	(
 	EAllocType eat,
 	BOOL fThreadSafe,
-	ULLONG ullCapacity
+	ULLONG ullCapacity,
+	BOOL fHugePages
 	)
 {
+	// put per-thread caches in front of shared tracker pools if requested
+	if (EatTracker == eat && fThreadSafe &&
+		NULL != ITask::PtskSelf() && GPOS_FTRACE(EtraceThreadCacheMemoryPools))
+	{
+		eat = EatThreadCache;
+	}
+
 	IMemoryPool *pmp =
 #ifdef GPOS_DEBUG
-			PmpCreatePoolStack(eat, ullCapacity, fThreadSafe);
+			PmpCreatePoolStack(eat, ullCapacity, fThreadSafe, fHugePages);
 #else
-			PmpNew(eat, m_pmpBase, ullCapacity, fThreadSafe, false /*fOwnsUnderlyingPmp*/);
+			PmpNew
+				(
+				eat,
+				fHugePages ? m_pmpHugePage : m_pmpBase,
+				ullCapacity,
+				fThreadSafe,
+				false /*fOwnsUnderlyingPmp*/
+				);
 #endif // GPOS_DEBUG
 
 	// accessor scope
@@ -215,6 +244,37 @@ CMemoryPoolManager::PmpNew
 						fThreadSafe,
 						fOwnsUnderlying
 						);
+
+		case CMemoryPoolManager::EatArena:
+			return GPOS_NEW(m_pmpInternal) CMemoryPoolArena
+						(
+						pmpUnderlying,
+						ullCapacity,
+						fThreadSafe,
+						fOwnsUnderlying
+						);
+
+		case CMemoryPoolManager::EatThreadCache:
+		{
+			// caches sit in front of a tracker pool, which is only
+			// called when caches are refilled or flushed
+			IMemoryPool *pmpTracker = PmpNew
+						(
+						EatTracker,
+						pmpUnderlying,
+						ullCapacity,
+						fThreadSafe,
+						fOwnsUnderlying
+						);
+
+			return GPOS_NEW(m_pmpInternal) CMemoryPoolThreadCache
+						(
+						pmpTracker,
+						ullCapacity,
+						fThreadSafe,
+						true /*fOwnsUnderlying*/
+						);
+		}
 	}
 
 	GPOS_ASSERT(!"No matching pool type found");
@@ -237,10 +297,12 @@ CMemoryPoolManager::PmpCreatePoolStack
 	(
 	EAllocType eat,
 	ULLONG ullCapacity,
-	BOOL fThreadSafe
+	BOOL fThreadSafe,
+	BOOL fHugePages
 	)
 {
-	IMemoryPool *pmpBase = m_pmpBase;
+	IMemoryPool *pmpSystem = fHugePages ? m_pmpHugePage : m_pmpBase;
+	IMemoryPool *pmpBase = pmpSystem;
 	BOOL fMallocType = (EatTracker == eat);
 
 	// check if tracking and fault injection on internal allocations
@@ -276,7 +338,7 @@ CMemoryPoolManager::PmpCreatePoolStack
 				pmpBase,
 				ullCapacity,
 				fThreadSafe,
-				pmpBase != m_pmpBase
+				pmpBase != pmpSystem
 				);
 	}
 
@@ -513,6 +575,12 @@ CMemoryPoolManager::Cleanup()
 	// cleanup left-over memory pools;
 	// any such pool means that we have a leak
 	m_sht.DestroyEntries(DestroyMemoryPoolAtShutdown);
+
+	// return huge page regions to the OS after all pools on top are gone
+	CMemoryPool *pmpHugePage = PmpConvert(m_pmpHugePage);
+	m_pmpHugePage = NULL;
+	pmpHugePage->TearDown();
+	GPOS_DELETE(pmpHugePage);
 }
 
 
@@ -527,6 +595,8 @@ CMemoryPoolManager::Cleanup()
 void
 CMemoryPoolManager::Shutdown()
 {
+	CMemoryPoolThreadCache::ReleaseThreadKey();
+
 	// cleanup remaining memory pools
 	Cleanup();
 
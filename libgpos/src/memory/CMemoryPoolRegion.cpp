@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolRegion.cpp
+//
+//	@doc:
+//		Implementation of region sub-pool
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPoolRegion.h"
+
+using namespace gpos;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolRegion::CMemoryPoolRegion
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolRegion::CMemoryPoolRegion
+	(
+	IMemoryPool *pmpParent
+	)
+	:
+	CMemoryPoolArena
+		(
+		pmpParent,
+		gpos::ullong_max,
+		false /*fThreadSafe*/,
+		false /*fOwnsUnderlying*/,
+		GPOS_MEM_REGION_CHUNK_MIN
+		)
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolRegion::~CMemoryPoolRegion
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolRegion::~CMemoryPoolRegion()
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolRegion::Drop
+//
+//	@doc:
+//		Return all chunks to the parent pool and delete the region
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolRegion::Drop()
+{
+	TearDown();
+	GPOS_DELETE(this);
+}
+
+// EOF
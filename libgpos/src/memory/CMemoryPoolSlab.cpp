@@ -0,0 +1,276 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolSlab.cpp
+//
+//	@doc:
+//		Implementation of slab memory pool
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPoolSlab.h"
+
+#define GPOS_MEM_SLAB_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SSlab))
+
+using namespace gpos;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::CMemoryPoolSlab
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::CMemoryPoolSlab
+	(
+	IMemoryPool *pmp,
+	ULONG ulObjectSize,
+	ULONG ulSlabBlocks,
+	BOOL fThreadSafe,
+	BOOL fOwnsUnderlying
+	)
+	:
+	CMemoryPool(pmp, fOwnsUnderlying, fThreadSafe),
+	m_ulBlockSize(UlObjectBlockSize(ulObjectSize)),
+	m_ulSlabBlocks(ulSlabBlocks),
+	m_pslabFirst(NULL),
+	m_pblockFree(NULL),
+	m_pbNext(NULL),
+	m_pbEnd(NULL),
+	m_ulSlabs(0),
+	m_ulLive(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(0 < ulSlabBlocks);
+	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= GPOS_MEM_SLAB_HEADER_SIZE + (ULLONG) m_ulBlockSize * ulSlabBlocks);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::~CMemoryPoolSlab
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::~CMemoryPoolSlab()
+{
+	GPOS_ASSERT(NULL == m_pslabFirst);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::FNewSlab
+//
+//	@doc:
+//		Allocate a new slab and make it the source of unused blocks
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemoryPoolSlab::FNewSlab()
+{
+	GPOS_ASSERT_IMP(FThreadSafe(), m_slock.FOwned());
+
+	const ULONG ulSize = GPOS_MEM_SLAB_HEADER_SIZE + m_ulBlockSize * m_ulSlabBlocks;
+	SSlab *pslab = static_cast<SSlab*>(PmpUnderlying()->PvAllocate(ulSize, __FILE__, __LINE__));
+	if (NULL == pslab)
+	{
+		return false;
+	}
+
+	pslab->m_pslabNext = m_pslabFirst;
+	m_pslabFirst = pslab;
+	m_ulSlabs++;
+
+	m_pbNext = reinterpret_cast<BYTE*>(pslab) + GPOS_MEM_SLAB_HEADER_SIZE;
+	m_pbEnd = reinterpret_cast<BYTE*>(pslab) + ulSize;
+
+	return true;
+}
+
+
+#ifdef GPOS_DEBUG
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::FHoldsLiveBlocks
+//
+//	@doc:
+//		Check if any block carved out of the slab is in use; blocks in use
+//		carry a header pointing to this pool while freed blocks start with
+//		the free list link
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemoryPoolSlab::FHoldsLiveBlocks
+	(
+	SSlab *pslab
+	)
+	const
+{
+	BYTE *pbFirst = reinterpret_cast<BYTE*>(pslab) + GPOS_MEM_SLAB_HEADER_SIZE;
+	BYTE *pbEnd = pbFirst + m_ulBlockSize * m_ulSlabBlocks;
+
+	// blocks of the most recent slab are carved up to the next unused one
+	if (pbFirst <= m_pbNext && m_pbNext <= pbEnd)
+	{
+		pbEnd = m_pbNext;
+	}
+
+	for (BYTE *pb = pbFirst; pb < pbEnd; pb += m_ulBlockSize)
+	{
+		if (this == PmpOfBlock(pb))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#endif // GPOS_DEBUG
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PvAllocate
+//
+//	@doc:
+//		Allocate a block; freed blocks are reused first; requests exceeding
+//		the object size are served by the underlying pool
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolSlab::PvAllocate
+	(
+	const ULONG ulBytes,
+	const CHAR *szFile,
+	const ULONG ulLine
+	)
+{
+	if (!FSlabSize(ulBytes))
+	{
+		return PmpUnderlying()->PvAllocate(ulBytes, szFile, ulLine);
+	}
+
+	CAutoSpinlock as(m_slock);
+	if (FThreadSafe())
+	{
+		as.Lock();
+	}
+
+	void *pv = NULL;
+	if (NULL != m_pblockFree)
+	{
+		pv = m_pblockFree;
+		m_pblockFree = m_pblockFree->m_pblockNext;
+	}
+	else
+	{
+		if (m_pbNext == m_pbEnd && !FNewSlab())
+		{
+			return NULL;
+		}
+
+		pv = m_pbNext;
+		m_pbNext += m_ulBlockSize;
+	}
+
+	m_ulLive++;
+
+	return pv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::Free
+//
+//	@doc:
+//		Return a block to the free list
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::Free
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	if (!FSlabSize(UlAllocSizeOfBlock(pv)))
+	{
+		PmpUnderlying()->Free(pv);
+		return;
+	}
+
+	SBlock *pblock = static_cast<SBlock*>(pv);
+
+	CAutoSpinlock as(m_slock);
+	if (FThreadSafe())
+	{
+		as.Lock();
+	}
+
+	GPOS_ASSERT(0 < m_ulLive);
+
+	pblock->m_pblockNext = m_pblockFree;
+	m_pblockFree = pblock;
+	m_ulLive--;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::TearDown
+//
+//	@doc:
+//		Return all slabs to the underlying pool
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::TearDown()
+{
+	GPOS_ASSERT(!m_slock.FOwned());
+
+	while (NULL != m_pslabFirst)
+	{
+		SSlab *pslabNext = m_pslabFirst->m_pslabNext;
+
+#ifdef GPOS_DEBUG
+		// leave slabs holding unfreed objects to the leak check of the
+		// underlying pool
+		if (!FHoldsLiveBlocks(m_pslabFirst))
+#endif // GPOS_DEBUG
+		{
+			PmpUnderlying()->Free(m_pslabFirst);
+		}
+
+		m_pslabFirst = pslabNext;
+	}
+
+	m_pblockFree = NULL;
+	m_pbNext = NULL;
+	m_pbEnd = NULL;
+	m_ulSlabs = 0;
+	m_ulLive = 0;
+
+	CMemoryPool::TearDown();
+}
+
+// EOF
+
@@ -28,10 +28,17 @@
 #define GPOS_MEM_BLOCK_HEADER_SIZE \
 	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SBlockDescriptor))
 
+#define GPOS_MEM_STACK_ALLOC_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader))
+
+// allocation size of the smallest size class
+#define GPOS_MEM_STACK_SIZE_CLASS_MIN (16)
+
 
 using namespace gpos;
 
 GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_BLOCK_SIZE));
+GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_STACK_SIZE_CLASS_MIN));
 
 
 //---------------------------------------------------------------------------
@@ -60,6 +67,11 @@ CMemoryPoolStack::CMemoryPoolStack
 	GPOS_ASSERT(GPOS_MEM_BLOCK_SIZE < m_ullCapacity);
 
 	m_listBlocks.Init(GPOS_OFFSET(SBlockDescriptor, m_link));
+
+	for (ULONG ul = 0; ul < GPOS_MEM_STACK_SIZE_CLASSES; ul++)
+	{
+		m_rgpflFree[ul] = NULL;
+	}
 }
 
 
@@ -77,13 +89,64 @@ CMemoryPoolStack::~CMemoryPoolStack()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolStack::UlSizeClass
+//
+//	@doc:
+//		Size class of an aligned allocation request; returns ulong_max if
+//		the request is too large to be recycled
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolStack::UlSizeClass
+	(
+	ULONG ulAlloc
+	)
+{
+	ULONG ulBytes = GPOS_MEM_STACK_SIZE_CLASS_MIN;
+	for (ULONG ul = 0; ul < GPOS_MEM_STACK_SIZE_CLASSES; ul++)
+	{
+		if (ulAlloc <= ulBytes)
+		{
+			return ul;
+		}
+
+		ulBytes <<= 1;
+	}
+
+	return gpos::ulong_max;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolStack::UlSizeClassBytes
+//
+//	@doc:
+//		Allocation size of a size class
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolStack::UlSizeClassBytes
+	(
+	ULONG ulSizeClass
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_STACK_SIZE_CLASSES > ulSizeClass);
+
+	return GPOS_MEM_STACK_SIZE_CLASS_MIN << ulSizeClass;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolStack::PvAllocate
 //
 //	@doc:
-//		Allocate memory, either from the underlying pool directly (for large
-//		requests) or by advancing the index in the current block.
+//		Allocate memory, either from the free list of the request's size
+//		class, from the underlying pool directly (for large requests) or by
+//		advancing the index in the current block.
 //
 //---------------------------------------------------------------------------
 void *
@@ -97,9 +160,25 @@ CMemoryPoolStack::PvAllocate
 	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= ulBytes);
 
 	ULONG ulAlloc = GPOS_MEM_ALIGNED_SIZE(ulBytes);
+	const ULONG ulSizeClass = UlSizeClass(ulAlloc);
+	if (gpos::ulong_max != ulSizeClass)
+	{
+		ulAlloc = UlSizeClassBytes(ulSizeClass);
+	}
+	ulAlloc += GPOS_MEM_STACK_ALLOC_HEADER_SIZE;
 	GPOS_ASSERT(MAX_ALIGNED(ulAlloc));
 
 	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	// recycle a freed allocation of the same size class
+	if (gpos::ulong_max != ulSizeClass && NULL != m_rgpflFree[ulSizeClass])
+	{
+		SFreeLink *pfl = m_rgpflFree[ulSizeClass];
+		m_rgpflFree[ulSizeClass] = pfl->m_pflNext;
+
+		return pfl;
+	}
 
 	// check if memory pool has enough capacity
 	if (ulAlloc + m_ullReserved > m_ullCapacity)
@@ -117,16 +196,57 @@ CMemoryPoolStack::PvAllocate
 		// reserve memory
 		m_ullReserved += ulAlloc;
 
-		void *pvAlloc = GPOS_MEM_OFFSET_POS(pbd, pbd->m_ulUsed);
+		SAllocHeader *pah = static_cast<SAllocHeader*>(GPOS_MEM_OFFSET_POS(pbd, pbd->m_ulUsed));
 		pbd->m_ulUsed += ulAlloc;
+		pah->m_ulSizeClass = ulSizeClass;
 
-		return pvAlloc;
+		return GPOS_MEM_OFFSET_POS(pah, GPOS_MEM_STACK_ALLOC_HEADER_SIZE);
 	}
 
 	return NULL;
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolStack::Free
+//
+//	@doc:
+//		Put allocation on the free list of its size class; allocations
+//		without size class are released when the pool is torn down
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolStack::Free
+	(
+	void *pv
+	)
+{
+#ifdef GPOS_DEBUG
+	CheckAllocation(pv);
+#endif // GPOS_DEBUG
+
+	const SAllocHeader *pah = reinterpret_cast<const SAllocHeader*>
+			(
+			static_cast<BYTE*>(pv) - GPOS_MEM_STACK_ALLOC_HEADER_SIZE
+			);
+	const ULONG ulSizeClass = pah->m_ulSizeClass;
+	if (gpos::ulong_max == ulSizeClass)
+	{
+		return;
+	}
+	GPOS_ASSERT(GPOS_MEM_STACK_SIZE_CLASSES > ulSizeClass);
+
+	SFreeLink *pfl = static_cast<SFreeLink*>(pv);
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	pfl->m_pflNext = m_rgpflFree[ulSizeClass];
+	m_rgpflFree[ulSizeClass] = pfl;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolStack::PbdProvider
@@ -142,8 +262,6 @@ CMemoryPoolStack::PbdProvider
 	ULONG ulAlloc
 	)
 {
-	SLock(as);
-
 	SBlockDescriptor *pbd = m_pbd;
 
 	if (NULL == pbd || !pbd->FFit(ulAlloc))
@@ -227,6 +345,11 @@ CMemoryPoolStack::TearDown()
 
 	m_ullReserved = 0;
 	m_pbd = NULL;
+
+	for (ULONG ul = 0; ul < GPOS_MEM_STACK_SIZE_CLASSES; ul++)
+	{
+		m_rgpflFree[ul] = NULL;
+	}
 }
 
 #ifdef GPOS_DEBUG
@@ -0,0 +1,739 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolThreadCache.cpp
+//
+//	@doc:
+//		Implementation of thread-caching memory pool
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/pthreadwrapper.h"
+#include "gpos/memory/CMemoryPoolThreadCache.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/sync/atomic.h"
+
+
+// size of chunks carved into cached allocations
+#define GPOS_MEM_TC_CHUNK_SIZE (256 * 1024)
+
+// allocation size of the smallest size class
+#define GPOS_MEM_TC_SIZE_CLASS_MIN (16)
+
+// bytes moved between a magazine and the central list at once
+#define GPOS_MEM_TC_BATCH_BYTES (8 * 1024)
+
+// bounds on the number of allocations moved at once
+#define GPOS_MEM_TC_BATCH_MIN (4)
+#define GPOS_MEM_TC_BATCH_MAX (32)
+
+#define GPOS_MEM_TC_ALLOC_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SAllocHeader))
+
+#define GPOS_MEM_TC_LARGE_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SLargeHeader))
+
+#define GPOS_MEM_TC_CHUNK_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SChunk))
+
+
+using namespace gpos;
+
+GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_TC_CHUNK_SIZE));
+GPOS_CPL_ASSERT(MAX_ALIGNED(GPOS_MEM_TC_SIZE_CLASS_MIN));
+
+// key of thread-specific slot tables
+PTHREAD_KEY_T CMemoryPoolThreadCache::m_keySlots;
+
+// is the key valid
+BOOL CMemoryPoolThreadCache::m_fKeySlotsValid = false;
+
+// pool for slot tables
+IMemoryPool *CMemoryPoolThreadCache::m_pmpSlots = NULL;
+
+// last assigned pool id
+volatile ULONG_PTR CMemoryPoolThreadCache::m_ulpLastId = 0;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::SMagazine::Init
+//
+//	@doc:
+//		Initialize empty magazine
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::SMagazine::Init
+	(
+	SMagazine *pmagNext
+	)
+{
+	for (ULONG ul = 0; ul < GPOS_MEM_TC_SIZE_CLASSES; ul++)
+	{
+		m_rgpfl[ul] = NULL;
+		m_rgulCount[ul] = 0;
+	}
+
+	m_pmagNext = pmagNext;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::CMemoryPoolThreadCache
+//
+//	@doc:
+//	  ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolThreadCache::CMemoryPoolThreadCache
+	(
+	IMemoryPool *pmp,
+	ULLONG ullCapacity,
+	BOOL fThreadSafe,
+	BOOL fOwnsUnderlying
+	)
+	:
+	CMemoryPool(pmp, fOwnsUnderlying, fThreadSafe),
+	m_pchunkCurrent(NULL),
+	m_pmagFirst(NULL),
+	m_ullReserved(0),
+	m_ullCapacity(ullCapacity),
+	m_ulpId(UlpExchangeAdd(&m_ulpLastId, 1) + 1)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	// size class must immediately precede user data in both header types
+	GPOS_ASSERT(GPOS_MEM_TC_ALLOC_HEADER_SIZE ==
+				GPOS_OFFSET(SAllocHeader, m_ulSizeClass) + GPOS_SIZEOF(ULONG));
+	GPOS_ASSERT(GPOS_MEM_TC_LARGE_HEADER_SIZE ==
+				GPOS_OFFSET(SLargeHeader, m_ulSizeClass) + GPOS_SIZEOF(ULONG));
+
+	for (ULONG ul = 0; ul < GPOS_MEM_TC_SIZE_CLASSES; ul++)
+	{
+		m_rgpflCentral[ul] = NULL;
+	}
+
+	m_magShared.Init(NULL /*pmagNext*/);
+	m_listLarge.Init(GPOS_OFFSET(SLargeHeader, m_link));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::~CMemoryPoolThreadCache
+//
+//	@doc:
+//		Dtor.
+//
+//---------------------------------------------------------------------------
+CMemoryPoolThreadCache::~CMemoryPoolThreadCache()
+{
+	GPOS_ASSERT(NULL == m_pchunkCurrent);
+	GPOS_ASSERT(NULL == m_pmagFirst);
+	GPOS_ASSERT(m_listLarge.FEmpty());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::InitThreadKey
+//
+//	@doc:
+//		Create key of thread-specific slot tables; without a key, all
+//		allocations of thread-safe pools bypass the caches
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::InitThreadKey
+	(
+	IMemoryPool *pmp
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(pmp->FThreadSafe());
+	GPOS_ASSERT(!m_fKeySlotsValid);
+
+	m_pmpSlots = pmp;
+	m_fKeySlotsValid = (0 == pthread::IPthreadKeyCreate(&m_keySlots, DestroySlots));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::ReleaseThreadKey
+//
+//	@doc:
+//		Release slot table of the calling thread and delete the key; slot
+//		tables of other threads are released when these threads exit
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::ReleaseThreadKey()
+{
+	if (!m_fKeySlotsValid)
+	{
+		return;
+	}
+
+	DestroySlots(pthread::PvPthreadGetSpecific(m_keySlots));
+	(void) pthread::IPthreadSetSpecific(m_keySlots, NULL);
+
+	m_fKeySlotsValid = false;
+	pthread::PthreadKeyDelete(m_keySlots);
+	m_pmpSlots = NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::DestroySlots
+//
+//	@doc:
+//		Release slot table of an exiting thread
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::DestroySlots
+	(
+	void *pv
+	)
+{
+	if (NULL != pv)
+	{
+		m_pmpSlots->Free(pv);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::PtsSelf
+//
+//	@doc:
+//		Slot table of the calling thread, created on first use; returns NULL
+//		if the calling thread cannot have a slot table
+//
+//---------------------------------------------------------------------------
+CMemoryPoolThreadCache::SThreadSlots *
+CMemoryPoolThreadCache::PtsSelf()
+{
+	if (!m_fKeySlotsValid)
+	{
+		return NULL;
+	}
+
+	SThreadSlots *pts = static_cast<SThreadSlots*>(pthread::PvPthreadGetSpecific(m_keySlots));
+	if (NULL != pts)
+	{
+		return pts;
+	}
+
+	pts = static_cast<SThreadSlots*>
+			(
+			m_pmpSlots->PvAllocate(GPOS_MEM_ALIGNED_STRUCT_SIZE(SThreadSlots), __FILE__, __LINE__)
+			);
+	if (NULL == pts)
+	{
+		return NULL;
+	}
+
+	for (ULONG ul = 0; ul < GPOS_MEM_TC_THREAD_SLOTS; ul++)
+	{
+		pts->m_rgulpPoolId[ul] = 0;
+		pts->m_rgpmag[ul] = NULL;
+	}
+
+	if (0 != pthread::IPthreadSetSpecific(m_keySlots, pts))
+	{
+		m_pmpSlots->Free(pts);
+		return NULL;
+	}
+
+	return pts;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::UlSizeClass
+//
+//	@doc:
+//		Size class of an aligned allocation request; returns ulong_max if
+//		the request is too large to be cached
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolThreadCache::UlSizeClass
+	(
+	ULONG ulAlloc
+	)
+{
+	ULONG ulBytes = GPOS_MEM_TC_SIZE_CLASS_MIN;
+	for (ULONG ul = 0; ul < GPOS_MEM_TC_SIZE_CLASSES; ul++)
+	{
+		if (ulAlloc <= ulBytes)
+		{
+			return ul;
+		}
+
+		ulBytes <<= 1;
+	}
+
+	return gpos::ulong_max;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::UlSizeClassBytes
+//
+//	@doc:
+//		Allocation size of a size class, including header
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolThreadCache::UlSizeClassBytes
+	(
+	ULONG ulSizeClass
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_TC_SIZE_CLASSES > ulSizeClass);
+
+	return GPOS_MEM_TC_ALLOC_HEADER_SIZE + (GPOS_MEM_TC_SIZE_CLASS_MIN << ulSizeClass);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::UlBatch
+//
+//	@doc:
+//		Number of allocations moved between magazine and central list
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolThreadCache::UlBatch
+	(
+	ULONG ulSizeClass
+	)
+{
+	const ULONG ulBatch = GPOS_MEM_TC_BATCH_BYTES / UlSizeClassBytes(ulSizeClass);
+
+	return std::max((ULONG) GPOS_MEM_TC_BATCH_MIN, std::min((ULONG) GPOS_MEM_TC_BATCH_MAX, ulBatch));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::PmagSelf
+//
+//	@doc:
+//		Magazine of the calling thread, created on first use; returns NULL
+//		if the calling thread cannot have a magazine
+//
+//---------------------------------------------------------------------------
+CMemoryPoolThreadCache::SMagazine *
+CMemoryPoolThreadCache::PmagSelf()
+{
+	if (!FThreadSafe())
+	{
+		return &m_magShared;
+	}
+
+	SThreadSlots *pts = PtsSelf();
+	if (NULL == pts)
+	{
+		return NULL;
+	}
+
+	const ULONG ulSlot = (ULONG) (m_ulpId % GPOS_MEM_TC_THREAD_SLOTS);
+	if (m_ulpId == pts->m_rgulpPoolId[ulSlot])
+	{
+		return pts->m_rgpmag[ulSlot];
+	}
+
+	const PTHREAD_T pthrdtSelf = pthread::PthrdtPthreadSelf();
+	SMagazine *pmag = NULL;
+
+	// scope for lock
+	{
+		CAutoSpinlock as(m_slock);
+		SLock(as);
+
+		// the slot may have been taken over by another pool after the
+		// thread's magazine was created
+		pmag = m_pmagFirst;
+		while (NULL != pmag && !pthread::FPthreadEqual(pthrdtSelf, pmag->m_pthrdt))
+		{
+			pmag = pmag->m_pmagNext;
+		}
+
+		if (NULL == pmag)
+		{
+			pmag = static_cast<SMagazine*>
+					(
+					PvAllocateUnderlying(as, GPOS_MEM_ALIGNED_STRUCT_SIZE(SMagazine))
+					);
+			if (NULL == pmag)
+			{
+				return NULL;
+			}
+
+			pmag->Init(m_pmagFirst);
+			pmag->m_pthrdt = pthrdtSelf;
+			m_pmagFirst = pmag;
+		}
+	}
+
+	// a magazine of another pool in this slot is left to its pool
+	pts->m_rgulpPoolId[ulSlot] = m_ulpId;
+	pts->m_rgpmag[ulSlot] = pmag;
+
+	return pmag;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::PvAllocateUnderlying
+//
+//	@doc:
+//		Allocate memory from underlying pool; spinlock must be held by
+//		caller if pool is thread-safe, and is released during allocation
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolThreadCache::PvAllocateUnderlying
+	(
+	CAutoSpinlock &as,
+	ULONG ulAlloc
+	)
+{
+	GPOS_ASSERT_IMP(FThreadSafe(), m_slock.FOwned());
+
+	// check if memory pool has enough capacity
+	if (ulAlloc + m_ullReserved > m_ullCapacity)
+	{
+		return NULL;
+	}
+	m_ullReserved += ulAlloc;
+
+	// release spinlock to allocate memory from underlying pool
+	SUnlock(as);
+	void *pv = PmpUnderlying()->PvAllocate(ulAlloc, __FILE__, __LINE__);
+	SLock(as);
+
+	if (NULL == pv)
+	{
+		m_ullReserved -= ulAlloc;
+	}
+
+	return pv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::PvAllocateLarge
+//
+//	@doc:
+//		Allocate memory that bypasses the caches
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolThreadCache::PvAllocateLarge
+	(
+	ULONG ulAlloc
+	)
+{
+	const ULONG ulTotal = ulAlloc + GPOS_MEM_TC_LARGE_HEADER_SIZE;
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	SLargeHeader *plh = static_cast<SLargeHeader*>(PvAllocateUnderlying(as, ulTotal));
+	if (NULL == plh)
+	{
+		return NULL;
+	}
+
+	plh->m_ulAlloc = ulTotal;
+	plh->m_ulSizeClass = gpos::ulong_max;
+	m_listLarge.Append(plh);
+
+	return GPOS_MEM_OFFSET_POS(plh, GPOS_MEM_TC_LARGE_HEADER_SIZE);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::FRefill
+//
+//	@doc:
+//		Move a batch of allocations of the given size class from the central
+//		list to the magazine; carve new allocations if the central list runs
+//		empty
+//
+//---------------------------------------------------------------------------
+BOOL
+CMemoryPoolThreadCache::FRefill
+	(
+	SMagazine *pmag,
+	ULONG ulSizeClass
+	)
+{
+	GPOS_ASSERT(NULL != pmag);
+	GPOS_ASSERT(0 == pmag->m_rgulCount[ulSizeClass]);
+
+	const ULONG ulBatch = UlBatch(ulSizeClass);
+	const ULONG ulSlot = UlSizeClassBytes(ulSizeClass);
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	ULONG ulMoved = 0;
+	while (ulMoved < ulBatch && NULL != m_rgpflCentral[ulSizeClass])
+	{
+		SFreeLink *pfl = m_rgpflCentral[ulSizeClass];
+		m_rgpflCentral[ulSizeClass] = pfl->m_pflNext;
+
+		pfl->m_pflNext = pmag->m_rgpfl[ulSizeClass];
+		pmag->m_rgpfl[ulSizeClass] = pfl;
+		ulMoved++;
+	}
+
+	while (ulMoved < ulBatch)
+	{
+		SChunk *pchunk = m_pchunkCurrent;
+		if (NULL == pchunk || pchunk->m_ulTotal - pchunk->m_ulUsed < ulSlot)
+		{
+			pchunk = static_cast<SChunk*>(PvAllocateUnderlying(as, GPOS_MEM_TC_CHUNK_SIZE));
+			if (NULL == pchunk)
+			{
+				break;
+			}
+
+			pchunk->m_pchunkNext = m_pchunkCurrent;
+			pchunk->m_ulTotal = GPOS_MEM_TC_CHUNK_SIZE;
+			pchunk->m_ulUsed = GPOS_MEM_TC_CHUNK_HEADER_SIZE;
+			m_pchunkCurrent = pchunk;
+		}
+
+		SAllocHeader *pah = static_cast<SAllocHeader*>(GPOS_MEM_OFFSET_POS(pchunk, pchunk->m_ulUsed));
+		pchunk->m_ulUsed += ulSlot;
+		pah->m_ulSizeClass = ulSizeClass;
+
+		SFreeLink *pfl = static_cast<SFreeLink*>(GPOS_MEM_OFFSET_POS(pah, GPOS_MEM_TC_ALLOC_HEADER_SIZE));
+		pfl->m_pflNext = pmag->m_rgpfl[ulSizeClass];
+		pmag->m_rgpfl[ulSizeClass] = pfl;
+		ulMoved++;
+	}
+
+	pmag->m_rgulCount[ulSizeClass] = ulMoved;
+
+	return (0 < ulMoved);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::Flush
+//
+//	@doc:
+//		Move a batch of allocations of the given size class from the
+//		magazine to the central list
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::Flush
+	(
+	SMagazine *pmag,
+	ULONG ulSizeClass
+	)
+{
+	GPOS_ASSERT(NULL != pmag);
+
+	const ULONG ulBatch = std::min(UlBatch(ulSizeClass), pmag->m_rgulCount[ulSizeClass]);
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	for (ULONG ul = 0; ul < ulBatch; ul++)
+	{
+		SFreeLink *pfl = pmag->m_rgpfl[ulSizeClass];
+		pmag->m_rgpfl[ulSizeClass] = pfl->m_pflNext;
+
+		pfl->m_pflNext = m_rgpflCentral[ulSizeClass];
+		m_rgpflCentral[ulSizeClass] = pfl;
+	}
+
+	pmag->m_rgulCount[ulSizeClass] -= ulBatch;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::PvAllocate
+//
+//	@doc:
+//		Allocate memory from the calling thread's magazine, refilling it
+//		when empty; large requests go to the underlying pool
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolThreadCache::PvAllocate
+	(
+	ULONG ulBytes,
+	const CHAR *,  // szFile
+	const ULONG    // ulLine
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= ulBytes);
+
+	const ULONG ulAlloc = GPOS_MEM_ALIGNED_SIZE(ulBytes);
+	const ULONG ulSizeClass = UlSizeClass(ulAlloc);
+	if (gpos::ulong_max == ulSizeClass)
+	{
+		return PvAllocateLarge(ulAlloc);
+	}
+
+	SMagazine *pmag = PmagSelf();
+	if (NULL == pmag)
+	{
+		// no cache available for calling thread
+		return PvAllocateLarge(ulAlloc);
+	}
+
+	if (0 == pmag->m_rgulCount[ulSizeClass] && !FRefill(pmag, ulSizeClass))
+	{
+		return NULL;
+	}
+
+	SFreeLink *pfl = pmag->m_rgpfl[ulSizeClass];
+	pmag->m_rgpfl[ulSizeClass] = pfl->m_pflNext;
+	pmag->m_rgulCount[ulSizeClass]--;
+
+	return pfl;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::Free
+//
+//	@doc:
+//		Return cached allocations to the calling thread's magazine, flushing
+//		a batch when it grows too large; large allocations are returned to
+//		the underlying pool
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::Free
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	const ULONG ulSizeClass = *(static_cast<ULONG*>(pv) - 1);
+	if (gpos::ulong_max == ulSizeClass)
+	{
+		SLargeHeader *plh = reinterpret_cast<SLargeHeader*>
+				(
+				static_cast<BYTE*>(pv) - GPOS_MEM_TC_LARGE_HEADER_SIZE
+				);
+
+		// scope for lock
+		{
+			CAutoSpinlock as(m_slock);
+			SLock(as);
+
+			m_listLarge.Remove(plh);
+			m_ullReserved -= plh->m_ulAlloc;
+		}
+
+		PmpUnderlying()->Free(plh);
+
+		return;
+	}
+	GPOS_ASSERT(GPOS_MEM_TC_SIZE_CLASSES > ulSizeClass);
+
+	SFreeLink *pfl = static_cast<SFreeLink*>(pv);
+	SMagazine *pmag = PmagSelf();
+	if (NULL == pmag)
+	{
+		CAutoSpinlock as(m_slock);
+		SLock(as);
+
+		pfl->m_pflNext = m_rgpflCentral[ulSizeClass];
+		m_rgpflCentral[ulSizeClass] = pfl;
+
+		return;
+	}
+
+	pfl->m_pflNext = pmag->m_rgpfl[ulSizeClass];
+	pmag->m_rgpfl[ulSizeClass] = pfl;
+	pmag->m_rgulCount[ulSizeClass]++;
+
+	if (2 * UlBatch(ulSizeClass) < pmag->m_rgulCount[ulSizeClass])
+	{
+		Flush(pmag, ulSizeClass);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolThreadCache::TearDown
+//
+//	@doc:
+//		Return all used memory to the underlying pool and tear it down;
+//		cached allocations live in chunks and need not be visited
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolThreadCache::TearDown()
+{
+	GPOS_ASSERT(!m_slock.FOwned());
+
+	while (!m_listLarge.FEmpty())
+	{
+		PmpUnderlying()->Free(m_listLarge.RemoveHead());
+	}
+
+	while (NULL != m_pchunkCurrent)
+	{
+		SChunk *pchunk = m_pchunkCurrent;
+		m_pchunkCurrent = pchunk->m_pchunkNext;
+		PmpUnderlying()->Free(pchunk);
+	}
+
+	while (NULL != m_pmagFirst)
+	{
+		SMagazine *pmag = m_pmagFirst;
+		m_pmagFirst = pmag->m_pmagNext;
+		PmpUnderlying()->Free(pmag);
+	}
+
+	CMemoryPool::TearDown();
+
+	for (ULONG ul = 0; ul < GPOS_MEM_TC_SIZE_CLASSES; ul++)
+	{
+		m_rgpflCentral[ul] = NULL;
+	}
+	m_magShared.Init(NULL /*pmagNext*/);
+	m_ullReserved = 0;
+}
+
+// EOF
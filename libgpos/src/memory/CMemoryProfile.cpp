@@ -0,0 +1,530 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryProfile.cpp
+//
+//	@doc:
+//		Implementation of per-call-site allocation profile
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/io/COstream.h"
+#include "gpos/memory/CMemoryProfile.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/task/CTaskContext.h"
+#include "gpos/task/ITask.h"
+
+using namespace gpos;
+
+GPOS_CPL_ASSERT(0 == (GPOS_MEM_PROFILE_SITES & (GPOS_MEM_PROFILE_SITES - 1)));
+
+// number of active profiles
+volatile ULONG_PTR CMemoryProfile::m_ulpActive = 0;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::CMemoryProfile
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMemoryProfile::CMemoryProfile
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_ulSites(0),
+	m_ulRecords(0),
+	m_ulTagFree(0),
+	m_ullSerial(0),
+	m_ptsk(NULL)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	(void) clib::PvMemSet(m_rgsite, 0, sizeof(m_rgsite));
+	(void) clib::PvMemSet(&m_siteOverflow, 0, sizeof(m_siteOverflow));
+	m_siteOverflow.m_szFile = "<other>";
+
+	for (ULONG ul = 0; ul < GPOS_MEM_PROFILE_RECORD_CHUNKS; ul++)
+	{
+		m_rgprec[ul] = NULL;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::~CMemoryProfile
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMemoryProfile::~CMemoryProfile()
+{
+	Deactivate();
+
+	for (ULONG ul = 0; ul < GPOS_MEM_PROFILE_RECORD_CHUNKS && NULL != m_rgprec[ul]; ul++)
+	{
+		m_pmp->Free(m_rgprec[ul]);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::Activate
+//
+//	@doc:
+//		Start recording allocations of the calling task and of tasks it
+//		spawns from now on
+//
+//---------------------------------------------------------------------------
+void
+CMemoryProfile::Activate()
+{
+	ITask *ptsk = ITask::PtskSelf();
+	GPOS_ASSERT(NULL != ptsk);
+	GPOS_ASSERT(!FActive());
+	GPOS_ASSERT(NULL == ptsk->Ptskctxt()->Pmprof() && "task is already profiled");
+
+	m_ptsk = ptsk;
+	ptsk->Ptskctxt()->SetPmprof(this);
+	(void) UlpExchangeAdd(&m_ulpActive, 1);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::Deactivate
+//
+//	@doc:
+//		Stop recording; must be called by the task that activated the profile
+//
+//---------------------------------------------------------------------------
+void
+CMemoryProfile::Deactivate()
+{
+	if (!FActive())
+	{
+		return;
+	}
+
+	GPOS_ASSERT(m_ptsk == ITask::PtskSelf());
+	GPOS_ASSERT(this == m_ptsk->Ptskctxt()->Pmprof());
+
+	m_ptsk->Ptskctxt()->SetPmprof(NULL);
+	m_ptsk = NULL;
+	(void) UlpExchangeAdd(&m_ulpActive, -1);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::PmprofSelf
+//
+//	@doc:
+//		Profile of the calling task; the task is only looked up while some
+//		profile is active
+//
+//---------------------------------------------------------------------------
+CMemoryProfile *
+CMemoryProfile::PmprofSelf()
+{
+	if (0 == m_ulpActive)
+	{
+		return NULL;
+	}
+
+	ITask *ptsk = ITask::PtskSelf();
+	if (NULL == ptsk)
+	{
+		return NULL;
+	}
+
+	return ptsk->Ptskctxt()->Pmprof();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::PsiteLookup
+//
+//	@doc:
+//		Find or insert entry of a call site; sites that do not fit into
+//		the table are mapped to the overflow entry
+//
+//---------------------------------------------------------------------------
+CMemoryProfile::SSite *
+CMemoryProfile::PsiteLookup
+	(
+	const CHAR *szFile,
+	ULONG ulLine
+	)
+{
+	GPOS_ASSERT(m_slock.FOwned());
+
+	if (NULL == szFile)
+	{
+		return &m_siteOverflow;
+	}
+
+	const ULONG ulMask = GPOS_MEM_PROFILE_SITES - 1;
+	ULONG ulPos = UlCombineHashes(UlHashPtr<CHAR>(szFile), ulLine) & ulMask;
+
+	for (ULONG ul = 0; ul < GPOS_MEM_PROFILE_SITES; ul++)
+	{
+		SSite *psite = &m_rgsite[ulPos];
+		if (psite->m_szFile == szFile && psite->m_ulLine == ulLine)
+		{
+			return psite;
+		}
+
+		if (NULL == psite->m_szFile)
+		{
+			// keep a free slot so that probing of absent sites terminates
+			if (GPOS_MEM_PROFILE_SITES - 1 == m_ulSites)
+			{
+				break;
+			}
+
+			psite->m_szFile = szFile;
+			psite->m_ulLine = ulLine;
+			m_ulSites++;
+
+			return psite;
+		}
+
+		ulPos = (ulPos + 1) & ulMask;
+	}
+
+	return &m_siteOverflow;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::UlTagNew
+//
+//	@doc:
+//		Tag of an unused record; record chunks are obtained from the
+//		profile's pool directly, so they are not recorded themselves
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryProfile::UlTagNew()
+{
+	GPOS_ASSERT(m_slock.FOwned());
+
+	if (0 != m_ulTagFree)
+	{
+		const ULONG ulTag = m_ulTagFree;
+		m_ulTagFree = Prec(ulTag)->m_ulTagNextFree;
+
+		return ulTag;
+	}
+
+	const ULONG ulChunk = m_ulRecords / GPOS_MEM_PROFILE_RECORD_CHUNK;
+	if (GPOS_MEM_PROFILE_RECORD_CHUNKS == ulChunk)
+	{
+		return 0;
+	}
+
+	if (NULL == m_rgprec[ulChunk])
+	{
+		m_rgprec[ulChunk] = static_cast<SRecord*>
+				(
+				m_pmp->PvAllocate(GPOS_MEM_PROFILE_RECORD_CHUNK * GPOS_SIZEOF(SRecord), __FILE__, __LINE__)
+				);
+
+		if (NULL == m_rgprec[ulChunk])
+		{
+			return 0;
+		}
+	}
+
+	return ++m_ulRecords;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::UlLifetimeBucket
+//
+//	@doc:
+//		Lifetime bucket of an object
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryProfile::UlLifetimeBucket
+	(
+	ULLONG ullLifetime
+	)
+{
+	ULONG ulBucket = 0;
+	while (ulBucket < GPOS_MEM_PROFILE_LIFETIME_BUCKETS - 1 && 16 <= ullLifetime)
+	{
+		ullLifetime >>= 4;
+		ulBucket++;
+	}
+
+	return ulBucket;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::UlRecordAllocation
+//
+//	@doc:
+//		Record an allocation; returns zero if no record is available, in
+//		which case the free of the object is not recorded
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryProfile::UlRecordAllocation
+	(
+	const void *pv,
+	const CHAR *szFile,
+	ULONG ulLine,
+	ULONG ulBytes
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	SSite *psite = PsiteLookup(szFile, ulLine);
+	psite->m_ullAllocs++;
+	psite->m_ullBytes += ulBytes;
+	psite->m_ullLiveBytes += ulBytes;
+	if (psite->m_ullLiveBytes > psite->m_ullPeakLiveBytes)
+	{
+		psite->m_ullPeakLiveBytes = psite->m_ullLiveBytes;
+	}
+
+	const ULONG ulTag = UlTagNew();
+	if (0 != ulTag)
+	{
+		SRecord *prec = Prec(ulTag);
+		prec->m_pv = pv;
+		prec->m_psite = psite;
+		prec->m_ullSerial = m_ullSerial;
+	}
+
+	m_ullSerial++;
+
+	return ulTag;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::RecordFree
+//
+//	@doc:
+//		Record a free of an object; the tag may have been assigned by
+//		another profile, in which case its record does not refer to the
+//		object and the free is ignored
+//
+//---------------------------------------------------------------------------
+void
+CMemoryProfile::RecordFree
+	(
+	const void *pv,
+	ULONG ulTag,
+	ULONG ulBytes
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	if (0 == ulTag || ulTag > m_ulRecords)
+	{
+		return;
+	}
+
+	SRecord *prec = Prec(ulTag);
+	if (pv != prec->m_pv)
+	{
+		return;
+	}
+
+	SSite *psite = prec->m_psite;
+	GPOS_ASSERT(psite->m_ullLiveBytes >= ulBytes || psite == &m_siteOverflow);
+
+	psite->m_ullFrees++;
+	psite->m_ullLiveBytes -= std::min((ULLONG) ulBytes, psite->m_ullLiveBytes);
+	psite->m_rgullLifetime[UlLifetimeBucket(m_ullSerial - prec->m_ullSerial)]++;
+
+	prec->m_pv = NULL;
+	prec->m_psite = NULL;
+	prec->m_ulTagNextFree = m_ulTagFree;
+	m_ulTagFree = ulTag;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::UlSites
+//
+//	@doc:
+//		Number of distinct call sites recorded
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryProfile::UlSites()
+{
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	return m_ulSites;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::ICompareSites
+//
+//	@doc:
+//		Comparator of sites, orders by allocated bytes descending
+//
+//---------------------------------------------------------------------------
+INT
+CMemoryProfile::ICompareSites
+	(
+	const void *pv1,
+	const void *pv2
+	)
+{
+	const SSite *psite1 = *static_cast<SSite * const *>(pv1);
+	const SSite *psite2 = *static_cast<SSite * const *>(pv2);
+
+	if (psite1->m_ullBytes == psite2->m_ullBytes)
+	{
+		return 0;
+	}
+
+	return (psite1->m_ullBytes > psite2->m_ullBytes) ? -1 : 1;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::PrintSite
+//
+//	@doc:
+//		Print a single call site
+//
+//---------------------------------------------------------------------------
+void
+CMemoryProfile::PrintSite
+	(
+	IOstream &os,
+	const SSite *psite
+	)
+{
+	os
+		<< psite->m_szFile << ":" << psite->m_ulLine
+		<< " allocs: " << psite->m_ullAllocs
+		<< ", frees: " << psite->m_ullFrees
+		<< ", bytes: " << psite->m_ullBytes
+		<< ", live bytes: " << psite->m_ullLiveBytes
+		<< ", peak live bytes: " << psite->m_ullPeakLiveBytes
+		<< ", lifetimes: [";
+
+	for (ULONG ul = 0; ul < GPOS_MEM_PROFILE_LIFETIME_BUCKETS; ul++)
+	{
+		if (0 < ul)
+		{
+			os << ", ";
+		}
+		os << psite->m_rgullLifetime[ul];
+	}
+
+	os << "]" << std::endl;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryProfile::OsPrint
+//
+//	@doc:
+//		Print the call sites with the most allocated bytes
+//
+//---------------------------------------------------------------------------
+IOstream &
+CMemoryProfile::OsPrint
+	(
+	IOstream &os,
+	ULONG ulTop
+	)
+{
+	CAutoSpinlock as(m_slock);
+	as.Lock();
+
+	ULONG ulSites = 0;
+	for (ULONG ul = 0; ul < GPOS_MEM_PROFILE_SITES; ul++)
+	{
+		if (NULL != m_rgsite[ul].m_szFile)
+		{
+			m_rgpsite[ulSites++] = &m_rgsite[ul];
+		}
+	}
+
+	if (0 < m_siteOverflow.m_ullAllocs)
+	{
+		m_rgpsite[ulSites++] = &m_siteOverflow;
+	}
+
+	clib::QSort(m_rgpsite, ulSites, sizeof(SSite*), ICompareSites);
+
+	ULLONG ullAllocs = 0;
+	ULLONG ullBytes = 0;
+	for (ULONG ul = 0; ul < ulSites; ul++)
+	{
+		ullAllocs += m_rgpsite[ul]->m_ullAllocs;
+		ullBytes += m_rgpsite[ul]->m_ullBytes;
+	}
+
+	os
+		<< COstream::EsmDec
+		<< "Memory profile: " << ulSites << " call sites, "
+		<< ullAllocs << " allocations, " << ullBytes << " bytes" << std::endl
+		<< "Lifetime buckets (allocations recorded by the profile): "
+		<< "[0, 16), [16, 256), [256, 4K), [4K, 64K), [64K, inf)" << std::endl;
+
+	if (0 == ulTop || ulTop > ulSites)
+	{
+		ulTop = ulSites;
+	}
+
+	for (ULONG ul = 0; ul < ulTop; ul++)
+	{
+		PrintSite(os, m_rgpsite[ul]);
+	}
+
+	return os;
+}
+
+
+// EOF
+
@@ -54,9 +54,13 @@ IMemoryPool::NewImpl
 
 	GPOS_OOM_CHECK(pv);
 
-	return dynamic_cast<CMemoryPool*>(this)->PvFinalizeAlloc(pv, (ULONG) cSize, eat);
+	void *pvResult = dynamic_cast<CMemoryPool*>(this)->PvFinalizeAlloc(pv, (ULONG) cSize, eat);
+	CMemoryPool::RecordProfiledAlloc(pvResult, szFilename, ulLine);
+
+	return pvResult;
 }
 
+
 //---------------------------------------------------------------------------
 //	@function:
 //		DeleteImpl
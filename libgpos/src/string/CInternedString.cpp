@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedString.cpp
+//
+//	@doc:
+//		Implementation of interned strings
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/string/CInternedString.h"
+#include "gpos/string/CInternedStringTable.h"
+
+using namespace gpos;
+
+// invalid key; no string is that long
+const CInternedString::SKey CInternedString::SKey::m_keyInvalid = {NULL, gpos::ulong_max};
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedString::SKey::UlHash
+//
+//	@doc:
+//		Hash of the key's bytes
+//
+//---------------------------------------------------------------------------
+ULONG
+CInternedString::SKey::UlHash
+	(
+	const SKey &key
+	)
+{
+	return gpos::UlHashByteArray((const BYTE *) key.m_sz, key.m_ulLength);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedString::SKey::FEqual
+//
+//	@doc:
+//		Two keys are equal if they hold the same bytes
+//
+//---------------------------------------------------------------------------
+BOOL
+CInternedString::SKey::FEqual
+	(
+	const SKey &keyFst,
+	const SKey &keySnd
+	)
+{
+	if (keyFst.m_ulLength != keySnd.m_ulLength)
+	{
+		return false;
+	}
+
+	if (keyFst.m_sz == keySnd.m_sz)
+	{
+		return true;
+	}
+
+	if (NULL == keyFst.m_sz || NULL == keySnd.m_sz)
+	{
+		return false;
+	}
+
+	return 0 == clib::IMemCmp(keyFst.m_sz, keySnd.m_sz, keyFst.m_ulLength);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedString::Pstr
+//
+//	@doc:
+//		Wide copy of the string; decoded from the UTF-8 bytes on first use,
+//		so strings only read as bytes or compared by identity never pay
+//		for a wide copy
+//
+//---------------------------------------------------------------------------
+const CWStringConst *
+CInternedString::Pstr() const
+{
+	if (NULL == m_pstr)
+	{
+		CInternedStringTable::Pist()->DecodeWide(const_cast<CInternedString *>(this));
+	}
+
+	return m_pstr;
+}
+
+// EOF
+
@@ -0,0 +1,563 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CInternedStringTable.cpp
+//
+//	@doc:
+//		Implementation of the global table of interned strings
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/string/CInternedStringTable.h"
+#include "gpos/sync/atomic.h"
+
+using namespace gpos;
+
+// global instance of the interned string table
+CInternedStringTable *CInternedStringTable::m_pist = NULL;
+
+// replacement for characters that cannot be encoded
+#define GPOS_UTF8_REPLACEMENT	(0xFFFD)
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::CInternedStringTable
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CInternedStringTable::CInternedStringTable
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_ulpStrings(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	m_sht.Init
+		(
+		m_pmp,
+		GPOS_INTERNED_STRING_HT_SIZE,
+		GPOS_OFFSET(CInternedString, m_link),
+		GPOS_OFFSET(CInternedString, m_key),
+		&CInternedString::SKey::m_keyInvalid,
+		CInternedString::SKey::UlHash,
+		CInternedString::SKey::FEqual
+		);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::EresInit
+//
+//	@doc:
+//		Initializes global instance
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CInternedStringTable::EresInit()
+{
+	GPOS_ASSERT(NULL == Pist() &&
+				"Interned string table was already initialized");
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// create memory pool of the table
+	IMemoryPool *pmp = CMemoryPoolManager::Pmpm()->PmpCreate
+		(
+		CMemoryPoolManager::EatTracker,
+		true /*fThreadSafe*/,
+		gpos::ullong_max
+		);
+	GPOS_TRY
+	{
+		CInternedStringTable::m_pist = GPOS_NEW(pmp) CInternedStringTable(pmp);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// destroy memory pool if global instance was not created
+		CMemoryPoolManager::Pmpm()->Destroy(pmp);
+
+		CInternedStringTable::m_pist = NULL;
+
+		if (GPOS_MATCH_EX(ex, CException::ExmaSystem, CException::ExmiOOM))
+		{
+			eres = GPOS_OOM;
+		}
+		else
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+	GPOS_CATCH_END;
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::Shutdown
+//
+//	@doc:
+//		Release all interned strings along with the memory pool
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::Shutdown()
+{
+	CInternedStringTable *pist = CInternedStringTable::Pist();
+
+	GPOS_ASSERT(NULL != pist &&
+				"Interned string table has not been initialized");
+
+	IMemoryPool *pmp = pist->m_pmp;
+
+	// strings are reclaimed with the memory pool
+	CInternedStringTable::m_pist = NULL;
+	GPOS_DELETE(pist);
+
+	CMemoryPoolManager::Pmpm()->Destroy(pmp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::UlUtf8Length
+//
+//	@doc:
+//		Number of bytes needed for the UTF-8 encoding of a wide buffer
+//
+//---------------------------------------------------------------------------
+ULONG
+CInternedStringTable::UlUtf8Length
+	(
+	const WCHAR *wsz,
+	ULONG ulLength
+	)
+{
+	GPOS_ASSERT(NULL != wsz || 0 == ulLength);
+
+	ULONG ulBytes = 0;
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		const ULONG ulCode = (ULONG) wsz[ul];
+		if (0x80 > ulCode)
+		{
+			ulBytes += 1;
+		}
+		else if (0x800 > ulCode)
+		{
+			ulBytes += 2;
+		}
+		else if (0x10000 > ulCode || 0x10FFFF < ulCode)
+		{
+			// characters outside of the code space are replaced
+			ulBytes += 3;
+		}
+		else
+		{
+			ulBytes += 4;
+		}
+	}
+
+	return ulBytes;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::EncodeUtf8
+//
+//	@doc:
+//		Encode a wide buffer as UTF-8; characters outside of the Unicode
+//		code space are encoded as the replacement character
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::EncodeUtf8
+	(
+	CHAR *sz,
+	const WCHAR *wsz,
+	ULONG ulLength
+	)
+{
+	GPOS_ASSERT(NULL != sz);
+
+	BYTE *pb = (BYTE *) sz;
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		ULONG ulCode = (ULONG) wsz[ul];
+		if (0x10FFFF < ulCode)
+		{
+			ulCode = GPOS_UTF8_REPLACEMENT;
+		}
+
+		if (0x80 > ulCode)
+		{
+			*pb++ = (BYTE) ulCode;
+		}
+		else if (0x800 > ulCode)
+		{
+			*pb++ = (BYTE) (0xC0 | (ulCode >> 6));
+			*pb++ = (BYTE) (0x80 | (ulCode & 0x3F));
+		}
+		else if (0x10000 > ulCode)
+		{
+			*pb++ = (BYTE) (0xE0 | (ulCode >> 12));
+			*pb++ = (BYTE) (0x80 | ((ulCode >> 6) & 0x3F));
+			*pb++ = (BYTE) (0x80 | (ulCode & 0x3F));
+		}
+		else
+		{
+			*pb++ = (BYTE) (0xF0 | (ulCode >> 18));
+			*pb++ = (BYTE) (0x80 | ((ulCode >> 12) & 0x3F));
+			*pb++ = (BYTE) (0x80 | ((ulCode >> 6) & 0x3F));
+			*pb++ = (BYTE) (0x80 | (ulCode & 0x3F));
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::UlWideLength
+//
+//	@doc:
+//		Number of wide characters encoded in UTF-8 bytes; every character
+//		starts with a byte that is not a continuation byte
+//
+//---------------------------------------------------------------------------
+ULONG
+CInternedStringTable::UlWideLength
+	(
+	const CHAR *sz,
+	ULONG ulLength
+	)
+{
+	GPOS_ASSERT(NULL != sz || 0 == ulLength);
+
+	const BYTE *pb = (const BYTE *) sz;
+	ULONG ulChars = 0;
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		if (0x80 != (pb[ul] & 0xC0))
+		{
+			ulChars++;
+		}
+	}
+
+	return ulChars;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::DecodeUtf8
+//
+//	@doc:
+//		Decode UTF-8 bytes produced by EncodeUtf8
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::DecodeUtf8
+	(
+	WCHAR *wsz,
+	const CHAR *sz,
+	ULONG ulLength
+	)
+{
+	GPOS_ASSERT(NULL != wsz);
+
+	const BYTE *pb = (const BYTE *) sz;
+	const BYTE *pbEnd = pb + ulLength;
+	while (pb < pbEnd)
+	{
+		ULONG ulCode = *pb++;
+		ULONG ulContinuation = 0;
+		if (0xF0 <= ulCode)
+		{
+			ulCode &= 0x07;
+			ulContinuation = 3;
+		}
+		else if (0xE0 <= ulCode)
+		{
+			ulCode &= 0x0F;
+			ulContinuation = 2;
+		}
+		else if (0xC0 <= ulCode)
+		{
+			ulCode &= 0x1F;
+			ulContinuation = 1;
+		}
+
+		for (ULONG ul = 0; ul < ulContinuation; ul++)
+		{
+			GPOS_ASSERT(pb < pbEnd && 0x80 == (*pb & 0xC0));
+			ulCode = (ulCode << 6) | (*pb++ & 0x3F);
+		}
+
+		*wsz++ = (WCHAR) ulCode;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::PisLookupOrInsert
+//
+//	@doc:
+//		Lookup UTF-8 bytes and add a reference to the entry found; if they
+//		are not found, add a new entry holding a copy of the bytes. The
+//		entry is created outside of the table's lock; when another thread
+//		interned the same string meanwhile, the new entry is dropped and
+//		the existing one is returned.
+//
+//---------------------------------------------------------------------------
+const CInternedString *
+CInternedStringTable::PisLookupOrInsert
+	(
+	const CHAR *sz,
+	ULONG ulLength
+	)
+{
+	CInternedString::SKey key;
+	key.m_sz = sz;
+	key.m_ulLength = ulLength;
+
+	// scope for table accessor
+	{
+		StringTableAccessor shta(m_sht, key);
+		CInternedString *pis = shta.PtLookup();
+		if (NULL != pis)
+		{
+			pis->m_ulRefs++;
+			return pis;
+		}
+	}
+
+	// create entry
+	CAutoRg<CHAR> a_sz;
+	a_sz = GPOS_NEW_ARRAY(m_pmp, CHAR, ulLength + 1);
+	if (0 < ulLength)
+	{
+		(void) clib::PvMemCpy(a_sz.Rgt(), sz, ulLength);
+	}
+	a_sz[ulLength] = '\0';
+
+	CInternedString *pisNew = GPOS_NEW(m_pmp) CInternedString
+								(
+								a_sz.Rgt(),
+								ulLength,
+								CInternedString::SKey::UlHash(key)
+								);
+	(void) a_sz.RgtReset();
+
+	CInternedString *pisFound = NULL;
+
+	// scope for table accessor
+	{
+		StringTableAccessor shta(m_sht, key);
+		pisFound = shta.PtLookup();
+		if (NULL == pisFound)
+		{
+			pisNew->m_ulId = (ULONG) UlpExchangeAdd(&m_ulpStrings, 1);
+			shta.Insert(pisNew);
+
+			return pisNew;
+		}
+
+		pisFound->m_ulRefs++;
+	}
+
+	// another thread interned the string first
+	DeleteEntry(pisNew);
+
+	return pisFound;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::DecodeWide
+//
+//	@doc:
+//		Decode the wide copy of an entry; when another thread installed
+//		its copy first, the new copy is dropped
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::DecodeWide
+	(
+	CInternedString *pis
+	)
+{
+	GPOS_ASSERT(NULL != pis);
+
+	const ULONG ulChars = UlWideLength(pis->Sz(), pis->UlLength());
+	CAutoRg<WCHAR> a_wsz;
+	a_wsz = GPOS_NEW_ARRAY(m_pmp, WCHAR, ulChars + 1);
+	DecodeUtf8(a_wsz.Rgt(), pis->Sz(), pis->UlLength());
+	a_wsz[ulChars] = L'\0';
+
+	const CWStringConst *pstr = GPOS_NEW(m_pmp) CWStringConst(m_pmp, a_wsz.Rgt());
+	if (!FCompareSwap<const CWStringConst>((volatile const CWStringConst **) &pis->m_pstr, NULL, pstr))
+	{
+		GPOS_DELETE(pstr);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::DeleteEntry
+//
+//	@doc:
+//		Delete an entry that is no longer in the table
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::DeleteEntry
+	(
+	CInternedString *pis
+	)
+{
+	GPOS_ASSERT(NULL != pis);
+
+	GPOS_DELETE(pis->m_pstr);
+	GPOS_DELETE_ARRAY(pis->m_key.m_sz);
+	GPOS_DELETE(pis);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::AddRef
+//
+//	@doc:
+//		Add a reference to an interned string
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::AddRef
+	(
+	const CInternedString *pis
+	)
+{
+	GPOS_ASSERT(NULL != pis);
+
+	StringTableAccessor shta(m_sht, pis->m_key);
+	GPOS_ASSERT(pis == shta.PtLookup());
+	GPOS_ASSERT(0 < pis->m_ulRefs);
+
+	const_cast<CInternedString *>(pis)->m_ulRefs++;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::Release
+//
+//	@doc:
+//		Release a reference to an interned string; the string is removed
+//		from the table under the lock of its bucket, so no concurrent
+//		lookup can find it, and deleted after the lock is released
+//
+//---------------------------------------------------------------------------
+void
+CInternedStringTable::Release
+	(
+	const CInternedString *pis
+	)
+{
+	GPOS_ASSERT(NULL != pis);
+
+	CInternedString *pisDropped = const_cast<CInternedString *>(pis);
+
+	// scope for table accessor
+	{
+		StringTableAccessor shta(m_sht, pis->m_key);
+		GPOS_ASSERT(pis == shta.PtLookup());
+		GPOS_ASSERT(0 < pis->m_ulRefs);
+
+		if (0 < --pisDropped->m_ulRefs)
+		{
+			return;
+		}
+
+		shta.Remove(pisDropped);
+	}
+
+	DeleteEntry(pisDropped);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::PisIntern
+//
+//	@doc:
+//		Intern a wide string
+//
+//---------------------------------------------------------------------------
+const CInternedString *
+CInternedStringTable::PisIntern
+	(
+	const CWStringBase *pstr
+	)
+{
+	GPOS_ASSERT(NULL != pstr);
+
+	const WCHAR *wsz = pstr->Wsz();
+	const ULONG ulLength = pstr->UlLength();
+	const ULONG ulBytes = UlUtf8Length(wsz, ulLength);
+
+	// encode short strings on the stack
+	CHAR szBuffer[GPOS_INTERNED_STRING_BUFFER];
+	CAutoRg<CHAR> a_sz;
+	CHAR *sz = szBuffer;
+	if (GPOS_INTERNED_STRING_BUFFER < ulBytes)
+	{
+		a_sz = GPOS_NEW_ARRAY(m_pmp, CHAR, ulBytes);
+		sz = a_sz.Rgt();
+	}
+
+	EncodeUtf8(sz, wsz, ulLength);
+
+	return PisLookupOrInsert(sz, ulBytes);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CInternedStringTable::PisIntern
+//
+//	@doc:
+//		Intern a null terminated wide character buffer
+//
+//---------------------------------------------------------------------------
+const CInternedString *
+CInternedStringTable::PisIntern
+	(
+	const WCHAR *wsz
+	)
+{
+	GPOS_ASSERT(NULL != wsz);
+
+	const CWStringConst str(wsz);
+
+	return PisIntern(&str);
+}
+
+// EOF
+
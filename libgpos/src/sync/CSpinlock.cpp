@@ -0,0 +1,50 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2016 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSpinlock.cpp
+//
+//	@doc:
+//		Contention statistics of spinlocks
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/CSpinlock.h"
+
+using namespace gpos;
+
+// number of contended acquisitions per rank
+volatile ULONG_PTR CSpinlockBase::m_rgulpContentions[GPOS_SPIN_RANKS];
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSpinlockBase::OsPrintContentions
+//
+//	@doc:
+//		Print number of contended acquisitions for all contended ranks
+//
+//---------------------------------------------------------------------------
+IOstream &
+CSpinlockBase::OsPrintContentions
+	(
+	IOstream &os
+	)
+{
+	os << "Spinlock contentions per rank:" << std::endl;
+
+	for (ULONG ulRank = 0; ulRank < GPOS_SPIN_RANKS; ulRank++)
+	{
+		ULONG_PTR ulpContentions = m_rgulpContentions[ulRank];
+		if (0 < ulpContentions)
+		{
+			os << ulRank << ": " << ulpContentions << std::endl;
+		}
+	}
+
+	return os;
+}
+
+// EOF
+
@@ -118,8 +118,8 @@ CAutoTaskProxy::Destroy
 	// remove task from list
 	m_list.Remove(ptsk);
 
-	// delete task object
-	GPOS_DELETE(ptsk);
+	// hand task back to worker pool for reuse
+	m_pwpm->ReleaseTask(ptsk);
 }
 
 
@@ -131,6 +131,8 @@ CAutoTaskProxy::Destroy
 //		Create new task;
 //		Bind task to function and argument and associate with task and error context;
 //		If caller is a task, its task context is cloned and used by the new task;
+//		The task and its memory pool are reused from the worker pool's cache
+//		if possible;
 //
 //---------------------------------------------------------------------------
 CTask *
@@ -141,57 +143,59 @@ CAutoTaskProxy::PtskCreate
 	volatile BOOL *pfCancel
 	)
 {
-	// create memory pool for task
-	CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
-	IMemoryPool *pmp = amp.Pmp();
+	// get retired task along with its memory pool
+	CTask *ptsk = m_pwpm->PtskAcquire();
+	IMemoryPool *pmp = ptsk->Pmp();
 
-	// auto pointer to hold new task context
-	CAutoP<CTaskContext> aptc;
-
-	// check if caller is a task
-	ITask *ptskParent = CWorker::PwrkrSelf()->Ptsk();
-	if (NULL == ptskParent)
-	{
-		// create new task context
-		aptc = GPOS_NEW(pmp) CTaskContext(pmp);
-	}
-	else
+	GPOS_TRY
 	{
-		// clone parent task's context
-		aptc = GPOS_NEW(pmp) CTaskContext(pmp, *ptskParent->Ptskctxt());
-	}
+		// auto pointer to hold new task context
+		CAutoP<CTaskContext> aptc;
 
-	// auto pointer to hold error context
-	CAutoP<CErrorContext> apec;
-	apec = GPOS_NEW(pmp) CErrorContext();
-	CTask *ptsk = CTask::PtskSelf();
-	if (NULL != ptsk)
-	{
-		apec.Pt()->Register(ptsk->PerrctxtConvert()->Pmdr());
-	}
+		// check if caller is a task
+		ITask *ptskParent = CWorker::PwrkrSelf()->Ptsk();
+		if (NULL == ptskParent)
+		{
+			// create new task context
+			aptc = GPOS_NEW(pmp) CTaskContext(pmp);
+		}
+		else
+		{
+			// clone parent task's context
+			aptc = GPOS_NEW(pmp) CTaskContext(pmp, *ptskParent->Ptskctxt());
+		}
 
-	// auto pointer to hold new task
-	// task is created inside ATP's memory pool
-	CAutoP<CTask> apt;
-	apt = GPOS_NEW(m_pmp) CTask(pmp, aptc.Pt(), apec.Pt(), &m_event, pfCancel);
+		// auto pointer to hold error context
+		CAutoP<CErrorContext> apec;
+		apec = GPOS_NEW(pmp) CErrorContext();
+		CTask *ptskSelf = CTask::PtskSelf();
+		if (NULL != ptskSelf)
+		{
+			apec.Pt()->Register(ptskSelf->PerrctxtConvert()->Pmdr());
+		}
 
-	// reset auto pointers - task now handles task and error context
-	(void) aptc.PtReset();
-	(void) apec.PtReset();
+		// initialize task with new contexts
+		ptsk->Init(aptc.Pt(), apec.Pt(), &m_event, pfCancel);
 
-	// detach task's memory pool from auto memory pool
-	amp.PmpDetach();
+		// reset auto pointers - task now handles task and error context
+		(void) aptc.PtReset();
+		(void) apec.PtReset();
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// delete task along with its memory pool
+		GPOS_DELETE(ptsk);
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
 
 	// bind function and argument
-	ptsk = apt.Pt();
 	ptsk->Bind(pfunc, pvArg);
 
 	// add to task list
 	m_list.Append(ptsk);
 
-	// reset auto pointer - ATP now handles task
-	apt.PtReset();
-
 	// register task to worker pool
 	m_pwpm->RegisterTask(ptsk);
 
@@ -199,7 +203,6 @@ CAutoTaskProxy::PtskCreate
 }
 
 
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CAutoTaskProxy::Schedule
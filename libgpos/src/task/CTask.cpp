@@ -24,44 +24,33 @@ const CTaskId CTaskId::m_tidInvalid;
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CTask::~CTask
+//		CTask::CTask
 //
 //	@doc:
-//		ctor
+//		ctor; the task is retired until initialized
 //
 //---------------------------------------------------------------------------
 CTask::CTask
 	(
-	IMemoryPool *pmp,
-	CTaskContext *ptskctxt,
-	IErrorContext *perrctxt,
-	CEvent *pevent,
-	volatile BOOL *pfCancel
+	IMemoryPool *pmp
 	)
 	:
 	m_pmp(pmp),
-	m_ptskctxt(ptskctxt),
-	m_perrctxt(perrctxt),
+	m_ptskctxt(NULL),
+	m_perrctxt(NULL),
 	m_perrhdl(NULL),
 	m_pfunc(NULL),
 	m_pvArg(NULL),
 	m_pvRes(NULL),
-	m_pmutex(pevent->Pmutex()),
-	m_pevent(pevent),
+	m_pmutex(NULL),
+	m_pevent(NULL),
 	m_estatus(EtsInit),
-	m_pfCancel(pfCancel),
+	m_pfCancel(&m_fCancel),
 	m_fCancel(false),
-	m_ulAbortSuspendCount(false),
+	m_ulAbortSuspendCount(0),
 	m_fReported(false)
 {
 	GPOS_ASSERT(NULL != pmp);
-	GPOS_ASSERT(NULL != ptskctxt);
-	GPOS_ASSERT(NULL != perrctxt);
-
-	if (NULL == pfCancel)
-	{
-		m_pfCancel = &m_fCancel;
-	}
 }
 
 
@@ -87,6 +76,79 @@ CTask::~CTask()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTask::Init
+//
+//	@doc:
+//		Initialize a retired task for execution; the task takes over the
+//		given task and error context, which must be allocated in its pool;
+//		each initialization assigns a new task id
+//
+//---------------------------------------------------------------------------
+void
+CTask::Init
+	(
+	CTaskContext *ptskctxt,
+	IErrorContext *perrctxt,
+	CEvent *pevent,
+	volatile BOOL *pfCancel
+	)
+{
+	GPOS_ASSERT(FRetired());
+	GPOS_ASSERT(NULL != ptskctxt);
+	GPOS_ASSERT(NULL != perrctxt);
+	GPOS_ASSERT(NULL != pevent);
+
+	m_ptskctxt = ptskctxt;
+	m_perrctxt = perrctxt;
+	m_perrhdl = NULL;
+	m_pfunc = NULL;
+	m_pvArg = NULL;
+	m_pvRes = NULL;
+	m_pmutex = pevent->Pmutex();
+	m_pevent = pevent;
+	m_estatus = EtsInit;
+	m_fCancel = false;
+	m_pfCancel = (NULL == pfCancel) ? &m_fCancel : pfCancel;
+	m_fReported = false;
+	m_tid = CTaskId();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTask::Retire
+//
+//	@doc:
+//		Release task and error context and TLS of a task that is not
+//		scheduled or has finished; the TLS hash table is released to the
+//		pool it was allocated from, hence that pool must still exist
+//
+//---------------------------------------------------------------------------
+void
+CTask::Retire()
+{
+	GPOS_ASSERT(!FRetired());
+	GPOS_ASSERT(0 == m_ulAbortSuspendCount);
+	GPOS_ASSERT(!FScheduled() || FFinished());
+
+	// suspend cancellation
+	CAutoSuspendAbort asa;
+
+	GPOS_DELETE(m_ptskctxt);
+	GPOS_DELETE(m_perrctxt);
+	m_ptskctxt = NULL;
+	m_perrctxt = NULL;
+
+	m_tls.Cleanup();
+
+	m_pmutex = NULL;
+	m_pevent = NULL;
+	m_pfCancel = &m_fCancel;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTask::Bind
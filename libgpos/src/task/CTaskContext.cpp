@@ -33,7 +33,8 @@ CTaskContext::CTaskContext
 	m_pbs(NULL),
 	m_plogOut(&CLoggerStream::m_plogStdOut),
 	m_plogErr(&CLoggerStream::m_plogStdErr),
-	m_eloc(ElocEnUS_Utf8)
+	m_eloc(ElocEnUS_Utf8),
+	m_pmprof(NULL)
 {
 	m_pbs = GPOS_NEW(pmp) CBitSet(pmp, EtraceSentinel);
 }
@@ -56,7 +57,8 @@ CTaskContext::CTaskContext
 	m_pbs(NULL),
 	m_plogOut(tskctxt.PlogOut()),
 	m_plogErr(tskctxt.PlogErr()),
-	m_eloc(tskctxt.Eloc())
+	m_eloc(tskctxt.Eloc()),
+	m_pmprof(tskctxt.Pmprof())
 {
 	// allocate bitset and union separately to guard against leaks under OOM
 	CAutoRef<CBitSet> a_pbs;
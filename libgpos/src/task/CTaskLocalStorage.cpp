@@ -68,6 +68,21 @@ CTaskLocalStorage::Reset
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTaskLocalStorage::Cleanup
+//
+//	@doc:
+//		Release hash table without deleting stored objects
+//
+//---------------------------------------------------------------------------
+void
+CTaskLocalStorage::Cleanup()
+{
+	m_sht.Cleanup();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTaskLocalStorage::Store
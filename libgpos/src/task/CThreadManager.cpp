@@ -294,7 +294,8 @@ CThreadManager::SetSignalMask()
 //		CThreadManager::FRunningThread
 //
 //	@doc:
-//		Check if given thread is in the running threads list
+//		Check if given thread is in the running threads list; the list is
+//		locked since a new thread may run before its creator adds it
 //
 //---------------------------------------------------------------------------
 BOOL
@@ -303,6 +304,9 @@ CThreadManager::FRunningThread
 	PTHREAD_T pthrdt
 	)
 {
+	CAutoMutex am(m_mutex);
+	am.Lock();
+
 	SThreadDescriptor *ptd = m_tdlRunning.PtFirst();
 	while (NULL != ptd)
 	{
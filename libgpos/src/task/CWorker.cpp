@@ -40,7 +40,8 @@ CWorker::CWorker
 	m_ptsk(NULL),
 	m_ulThreadId(ulThreadId),
 	m_cStackSize(cStackSize),
-	m_ulpStackStart(ulpStackStart)
+	m_ulpStackStart(ulpStackStart),
+	m_ulCpu(gpos::ulong_max)
 {
 #ifdef GPOS_DEBUG			
 	m_listSlock.Init(GPOS_OFFSET(CSpinlockBase, m_link));
@@ -104,11 +105,46 @@ CWorker::Run()
 
 	while (CWorkerPoolManager::EsrExecTask == CWorkerPoolManager::Pwpm()->EsrTskNext(&ptsk))
 	{
+		UpdateCpuBinding();
 		Execute(ptsk);
 	}
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorker::UpdateCpuBinding
+//
+//	@doc:
+//		Bind thread to a processor of the process derived from its id if
+//		the worker pool pins workers, unbind it otherwise; workers of
+//		processes with different affinity masks are bound to different
+//		processors; only called by pool threads
+//
+//---------------------------------------------------------------------------
+void
+CWorker::UpdateCpuBinding()
+{
+	const BOOL fPinned = CWorkerPoolManager::Pwpm()->FWorkersPinned();
+	if (fPinned == (gpos::ulong_max != m_ulCpu))
+	{
+		// binding is up to date
+		return;
+	}
+
+	ULONG ulCpu = gpos::ulong_max;
+	if (fPinned)
+	{
+		ulCpu = m_ulThreadId;
+	}
+
+	if (syslib::FBindToCpu(ulCpu))
+	{
+		m_ulCpu = ulCpu;
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CWorker::Execute
@@ -13,8 +13,10 @@
 //---------------------------------------------------------------------------
 
 
+#include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/memory/CMemoryPoolManager.h"
 #include "gpos/memory/IMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
 
 #include "gpos/task/CWorkerPoolManager.h"
 
@@ -44,7 +46,9 @@ CWorkerPoolManager::CWorkerPoolManager
 	m_ulWorkersMin(0),
 	m_ulWorkersMax(0),
 	m_ulAtpCnt(0),
-	m_fActive(false)
+	m_fActive(false),
+	m_ulpTasksCached(0),
+	m_fWorkersPinned(false)
 {
 	// initialize hash tables
 	m_shtWLS.Init
@@ -69,6 +73,8 @@ CWorkerPoolManager::CWorkerPoolManager
 		CTaskId::FEqual
 		);
 
+	m_listTasksCached.Init(GPOS_OFFSET(CTask, m_linkWpm));
+
 	// initialize mutex
 	m_event.Init(&m_mutex);
 
@@ -166,6 +172,14 @@ CWorkerPoolManager::Shutdown()
 	// wait until all threads exit
 	pwpm->m_tm.ShutDown();
 
+	// delete cached tasks along with their memory pools
+	while (!pwpm->m_listTasksCached.FEmpty())
+	{
+		CTask *ptsk = pwpm->m_listTasksCached.RemoveHead();
+		GPOS_DELETE(ptsk);
+	}
+	pwpm->m_ulpTasksCached = 0;
+
 
 	IMemoryPool *pmp = pwpm->m_pmp;
 
@@ -376,6 +390,160 @@ CWorkerPoolManager::PtskRemoveTask
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorkerPoolManager::PtskCreateRetired
+//
+//	@doc:
+//		Create retired task with a new memory pool; the task object itself
+//		is allocated in the worker pool's memory so that it can outlive the
+//		ATP that uses it
+//
+//---------------------------------------------------------------------------
+CTask *
+CWorkerPoolManager::PtskCreateRetired()
+{
+	// create memory pool for task
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcStrict);
+
+	CTask *ptsk = GPOS_NEW(m_pmp) CTask(amp.Pmp());
+
+	// task now owns its memory pool
+	(void) amp.PmpDetach();
+
+	return ptsk;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorkerPoolManager::PtskAcquire
+//
+//	@doc:
+//		Retired task for initialization, taken from cache if available
+//
+//---------------------------------------------------------------------------
+CTask *
+CWorkerPoolManager::PtskAcquire()
+{
+	if (0 < m_ulpTasksCached)
+	{
+		CAutoSpinlock as(m_slockTasksCached);
+		as.Lock();
+
+		if (!m_listTasksCached.FEmpty())
+		{
+			m_ulpTasksCached--;
+			return m_listTasksCached.RemoveHead();
+		}
+	}
+
+	return PtskCreateRetired();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorkerPoolManager::FCacheTask
+//
+//	@doc:
+//		Add retired task to cache unless cache is full
+//
+//---------------------------------------------------------------------------
+BOOL
+CWorkerPoolManager::FCacheTask
+	(
+	CTask *ptsk
+	)
+{
+	GPOS_ASSERT(ptsk->FRetired());
+
+	CAutoSpinlock as(m_slockTasksCached);
+	as.Lock();
+
+	if (GPOS_WORKERPOOL_TASK_CACHE_SIZE <= m_ulpTasksCached)
+	{
+		return false;
+	}
+
+	m_listTasksCached.Prepend(ptsk);
+	m_ulpTasksCached++;
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorkerPoolManager::ReleaseTask
+//
+//	@doc:
+//		Retire task and cache it for reuse; tasks whose pool still holds
+//		allocations after retiring, e.g. of an aborted task function, are
+//		deleted together with their pool
+//
+//---------------------------------------------------------------------------
+void
+CWorkerPoolManager::ReleaseTask
+	(
+	CTask *ptsk
+	)
+{
+	GPOS_ASSERT(NULL != ptsk);
+
+	ptsk->Retire();
+
+	if (m_fActive && 0 == ptsk->Pmp()->UllTotalAllocatedSize() && FCacheTask(ptsk))
+	{
+		return;
+	}
+
+	GPOS_DELETE(ptsk);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CWorkerPoolManager::Prewarm
+//
+//	@doc:
+//		Create worker threads and cached tasks for running the given number
+//		of tasks in parallel, within the limits on workers and cache size;
+//		does nothing if the pool is already warm
+//
+//---------------------------------------------------------------------------
+void
+CWorkerPoolManager::Prewarm
+	(
+	ULONG ulTasks
+	)
+{
+	const ULONG ulWorkers = std::min(ulTasks, (ULONG) m_ulWorkersMax);
+	while (ulWorkers > m_ulpWorkers)
+	{
+		ULONG_PTR ulpWorkers = m_ulpWorkers;
+		CreateWorkerThread();
+
+		if (ulpWorkers == m_ulpWorkers)
+		{
+			// thread creation failed
+			break;
+		}
+	}
+
+	const ULONG_PTR ulpTasks = std::min((ULONG_PTR) ulTasks, (ULONG_PTR) GPOS_WORKERPOOL_TASK_CACHE_SIZE);
+	while (ulpTasks > m_ulpTasksCached)
+	{
+		CTask *ptsk = PtskCreateRetired();
+		if (!FCacheTask(ptsk))
+		{
+			GPOS_DELETE(ptsk);
+			break;
+		}
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CWorkerPoolManager::Schedule
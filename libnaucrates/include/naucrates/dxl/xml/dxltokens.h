@@ -64,6 +64,9 @@ namespace gpdxl
 		EdxltokenJoinOrderDPThreshold,
 		EdxltokenBroadcastThreshold,
 		EdxltokenEnforceConstraintsOnDML,
+		EdxltokenSearchMemoryBudget,
+		EdxltokenParallelWorkers,
+		EdxltokenOptimizationDeadline,
 		EdxltokenWindowOids,
 		EdxltokenOidRowNumber,
 		EdxltokenOidRank,
@@ -16,6 +16,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/string/CInternedString.h"
 #include "gpos/string/CWStringConst.h"
 
 #include "naucrates/dxl/gpdb_types.h"
@@ -39,6 +40,10 @@ namespace gpmd
 	//	@doc:
 	//		Class for representing ids of GPDB metadata objects
 	//
+	//		The string representation is only built when it is asked for and is
+	//		kept in the global interned string table, so mdids do not carry
+	//		their own string buffer.
+	//
 	//---------------------------------------------------------------------------
 	class CMDIdGPDB : public IMDId
 	{
@@ -56,15 +61,16 @@ namespace gpmd
 			// minor version number
 			ULONG m_ulVersionMinor;
 		
-			// buffer for the serialized mdid
-			WCHAR m_wszBuffer[GPDXL_MDID_LENGTH];
-			
-			// string representation of the mdid
-			CWStringStatic m_str;
+			// referenced interned string representation of the mdid,
+			// computed on first use
+			const CInternedString * volatile m_pis;
 			
-			// serialize mdid
+			// reset string representation after the mdid changed
 			virtual
 			void Serialize();
+
+			// interned string representation of the mdid
+			const CInternedString *Pis() const;
 			
 		public:
 			// ctors
@@ -77,6 +83,10 @@ namespace gpmd
 			explicit
 			CMDIdGPDB(const CMDIdGPDB &mdidSource);
 
+			// dtor
+			virtual
+			~CMDIdGPDB();
+
 			virtual
 			EMDIdType Emdidt() const
 			{
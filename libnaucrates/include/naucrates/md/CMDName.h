@@ -14,6 +14,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/string/CInternedString.h"
 #include "gpos/string/CWStringConst.h"
 
 namespace gpmd
@@ -27,15 +28,26 @@ namespace gpmd
 	//	@doc:
 	//		Class for representing metadata names.
 	//
+	//		Names are interned on demand: equal names share one entry of the
+	//		global interned string table, so they are compared and hashed by
+	//		identity. Names copied from another string keep a reference to
+	//		their entry instead of a copy of their own, and read the entry's
+	//		wide copy, which is decoded once when it is first asked for.
+	//
 	//---------------------------------------------------------------------------
 	class CMDName
 	{
 		private:
-			// the string holding the name
+			// the string holding the name, NULL for names created by
+			// interning a copy of another string
 			const CWStringConst *m_psc;
 			
 			// keep track of copy status
 			BOOL m_fDeepCopy;
+
+			// referenced interned name, computed on first use for names
+			// created from a given string object
+			const CInternedString * volatile m_pis;
 		
 		public:
 			// ctor/dtor
@@ -50,8 +62,32 @@ namespace gpmd
 			// accessors
 			const CWStringConst *Pstr() const
 			{
+				if (NULL == m_psc)
+				{
+					return m_pis->Pstr();
+				}
+
 				return m_psc;
 			}
+
+			// interned name
+			const CInternedString *Pis() const;
+
+			// equality check
+			BOOL FEquals
+				(
+				const CMDName &mdname
+				)
+				const
+			{
+				return Pis() == mdname.Pis();
+			}
+
+			// hash of the name's contents
+			ULONG UlHash() const
+			{
+				return Pis()->UlHash();
+			}
 	};
 
 	// array of names
@@ -71,6 +71,12 @@ namespace gpos
 		// print MEMO during property enforcement process
 		EopttracePrintMemoEnforcement = 101015,
 
+		// print per-call-site allocation profile of optimization
+		EopttracePrintMemoryProfile = 101016,
+
+		// print timeline of optimization jobs in Chrome trace-event format
+		EopttracePrintJobTimeline = 101017,
+
 		///////////////////////////////////////////////////////
 		////////////////// transformations flags //////////////
 		///////////////////////////////////////////////////////
@@ -166,6 +172,12 @@ namespace gpos
 		// create constraint intervals from array expressions in preprocessing
 		EopttraceArrayConstraints = 103026,
 
+		// allocate scratch structures of engine, memo and optimizer context from arena pools
+		EopttraceArenaMemoryPools = 103027,
+
+		// back arena pools by transparent huge pages; requires arena pools
+		EopttraceHugePageMemoryPools = 103028,
+
 		///////////////////////////////////////////////////////
 		///////////////////// statistics flags ////////////////
 		//////////////////////////////////////////////////////
@@ -9,6 +9,10 @@
 //		Implementation of metadata identifiers
 //---------------------------------------------------------------------------
 
+#include "gpos/string/CInternedStringTable.h"
+#include "gpos/string/CWStringStatic.h"
+#include "gpos/sync/atomic.h"
+
 #include "naucrates/md/CMDIdGPDB.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 
@@ -120,16 +124,13 @@ CMDIdGPDB::CMDIdGPDB
 	m_oid(oid),
 	m_ulVersionMajor(1),
 	m_ulVersionMinor(0),
-	m_str(m_wszBuffer, GPOS_ARRAY_SIZE(m_wszBuffer))
+	m_pis(NULL)
 {
 	if (CMDIdGPDB::m_mdidInvalidKey.OidObjectId() == oid)
 	{
 		// construct an invalid mdid 0.0.0
 		m_ulVersionMajor = 0;
 	}
-		
-	// serialize mdid into static string 
-	Serialize();
 }
 
 //---------------------------------------------------------------------------
@@ -150,7 +151,7 @@ CMDIdGPDB::CMDIdGPDB
 	m_oid(oid),
 	m_ulVersionMajor(1),
 	m_ulVersionMinor(0),
-	m_str(m_wszBuffer, GPOS_ARRAY_SIZE(m_wszBuffer))
+	m_pis(NULL)
 {
 	if (CMDIdGPDB::m_mdidInvalidKey.OidObjectId() == oid)
 	{
@@ -159,9 +160,6 @@ CMDIdGPDB::CMDIdGPDB
 	}
 	
 	// TODO:  - Jan 31, 2012; supply system id in constructor
-	
-	// serialize mdid into static string 
-	Serialize();
 }
 
 //---------------------------------------------------------------------------
@@ -183,11 +181,9 @@ CMDIdGPDB::CMDIdGPDB
 	m_oid(oid),
 	m_ulVersionMajor(ulVersionMajor),
 	m_ulVersionMinor(ulVersionMinor),
-	m_str(m_wszBuffer, GPOS_ARRAY_SIZE(m_wszBuffer))
+	m_pis(NULL)
 {
 	// TODO:  - Jan 31, 2012; supply system id in constructor
-	// serialize mdid into static string
-	Serialize();
 }
 
 //---------------------------------------------------------------------------
@@ -208,13 +204,10 @@ CMDIdGPDB::CMDIdGPDB
 	m_oid(mdidSource.OidObjectId()),
 	m_ulVersionMajor(mdidSource.UlVersionMajor()),
 	m_ulVersionMinor(mdidSource.UlVersionMinor()),
-	m_str(m_wszBuffer, GPOS_ARRAY_SIZE(m_wszBuffer))
+	m_pis(NULL)
 {
 	GPOS_ASSERT(mdidSource.FValid());
 	GPOS_ASSERT(IMDId::EmdidGPDB == mdidSource.Emdidt());
-
-	// serialize mdid into static string
-	Serialize();
 }
 
 //---------------------------------------------------------------------------
@@ -222,15 +215,62 @@ CMDIdGPDB::CMDIdGPDB
 //		CMDIdGPDB::Serialize
 //
 //	@doc:
-//		Serialize mdid into static string
+//		Drop the string representation; it is rebuilt on first use
 //
 //---------------------------------------------------------------------------
 void
 CMDIdGPDB::Serialize()
 {
-	m_str.Reset();
-	// serialize mdid as SystemType.Oid.Major.Minor
-	m_str.AppendFormat(GPOS_WSZ_LIT("%d.%d.%d.%d"), Emdidt(), m_oid, m_ulVersionMajor, m_ulVersionMinor);
+	if (NULL != m_pis)
+	{
+		CInternedStringTable::Pist()->Release(m_pis);
+		m_pis = NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDIdGPDB::~CMDIdGPDB
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMDIdGPDB::~CMDIdGPDB()
+{
+	Serialize();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDIdGPDB::Pis
+//
+//	@doc:
+//		Interned string representation of the mdid, built on first use;
+//		when callers race to build it, the representation installed first
+//		is kept
+//
+//---------------------------------------------------------------------------
+const CInternedString *
+CMDIdGPDB::Pis() const
+{
+	if (NULL == m_pis)
+	{
+		WCHAR wszBuffer[GPDXL_MDID_LENGTH];
+		CWStringStatic str(wszBuffer, GPOS_ARRAY_SIZE(wszBuffer));
+
+		// serialize mdid as SystemType.Oid.Major.Minor
+		str.AppendFormat(GPOS_WSZ_LIT("%d.%d.%d.%d"), Emdidt(), m_oid, m_ulVersionMajor, m_ulVersionMinor);
+
+		CInternedStringTable *pist = CInternedStringTable::Pist();
+		const CInternedString *pis = pist->PisIntern(&str);
+		if (!FCompareSwap<const CInternedString>((volatile const CInternedString **) &m_pis, NULL, pis))
+		{
+			pist->Release(pis);
+		}
+	}
+
+	return m_pis;
 }
 
 //---------------------------------------------------------------------------
@@ -244,7 +284,7 @@ CMDIdGPDB::Serialize()
 const WCHAR *
 CMDIdGPDB::Wsz() const
 {
-	return m_str.Wsz();
+	return Pis()->Pstr()->Wsz();
 }
 
 //---------------------------------------------------------------------------
@@ -348,7 +388,7 @@ CMDIdGPDB::Serialize
 	)
 	const
 {
-	pxmlser->AddAttribute(pstrAttribute, &m_str);
+	pxmlser->AddAttribute(pstrAttribute, Pis()->Pstr());
 }
 
 //---------------------------------------------------------------------------
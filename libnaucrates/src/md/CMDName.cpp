@@ -10,7 +10,9 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/string/CInternedStringTable.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/sync/atomic.h"
 #include "naucrates/md/CMDName.h"
 
 using namespace gpmd;
@@ -22,19 +24,23 @@ using namespace gpmd;
 //
 //	@doc:
 //		Constructor
-//		Creates a deep copy of the provided string
+//		Interns the provided string; the name holds a reference to the
+//		interned copy, so no memory is allocated from the pool
 //
 //---------------------------------------------------------------------------
 CMDName::CMDName
 	(
-	IMemoryPool *pmp,
+	IMemoryPool *, // pmp
 	const CWStringBase *pstr
 	)
 	:
 	m_psc(NULL),
-	m_fDeepCopy(true)
+	m_fDeepCopy(false),
+	m_pis(NULL)
 {
-	m_psc = GPOS_NEW(pmp) CWStringConst(pmp, pstr->Wsz());
+	GPOS_ASSERT(NULL != pstr);
+
+	m_pis = CInternedStringTable::Pist()->PisIntern(pstr);
 }
 
 //---------------------------------------------------------------------------
@@ -54,7 +60,8 @@ CMDName::CMDName
 	)
 	:
 	m_psc(pstr),
-	m_fDeepCopy(fOwnsMemory)
+	m_fDeepCopy(fOwnsMemory),
+	m_pis(NULL)
 {
 	GPOS_ASSERT(NULL != m_psc);
 	GPOS_ASSERT(m_psc->FValid());
@@ -73,11 +80,43 @@ CMDName::CMDName
 	const CMDName &name
 	)
 	:
-	m_psc(name.Pstr()),
-	m_fDeepCopy(false)
+	m_psc(name.m_psc),
+	m_fDeepCopy(false),
+	m_pis(name.m_pis)
 {
-	GPOS_ASSERT(NULL != m_psc->Wsz());
-	GPOS_ASSERT(m_psc->FValid());	
+	GPOS_ASSERT(NULL != m_psc || NULL != m_pis);
+	GPOS_ASSERT(NULL == m_psc || m_psc->FValid());
+
+	if (NULL != m_pis)
+	{
+		CInternedStringTable::Pist()->AddRef(m_pis);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDName::Pis
+//
+//	@doc:
+//		Interned name; the first caller to install its entry keeps the
+//		reference, the others release theirs
+//
+//---------------------------------------------------------------------------
+const CInternedString *
+CMDName::Pis() const
+{
+	if (NULL == m_pis)
+	{
+		CInternedStringTable *pist = CInternedStringTable::Pist();
+		const CInternedString *pis = pist->PisIntern(m_psc);
+		if (!FCompareSwap<const CInternedString>((volatile const CInternedString **) &m_pis, NULL, pis))
+		{
+			pist->Release(pis);
+		}
+	}
+
+	return m_pis;
 }
 
 
@@ -91,7 +130,12 @@ CMDName::CMDName
 //---------------------------------------------------------------------------
 CMDName::~CMDName()
 {
-	GPOS_ASSERT(m_psc->FValid());
+	GPOS_ASSERT(NULL == m_psc || m_psc->FValid());
+
+	if (NULL != m_pis)
+	{
+		CInternedStringTable::Pist()->Release(m_pis);
+	}
 
 	if (m_fDeepCopy)
 	{
@@ -88,6 +88,9 @@ CParseHandlerHint::StartElement
 	ULONG ulJoinOrderDPThreshold = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenJoinOrderDPThreshold, EdxltokenHint, true, JOIN_ORDER_DP_THRESHOLD);
 	ULONG ulBroadcastThreshold = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenBroadcastThreshold, EdxltokenHint, true, BROADCAST_THRESHOLD);
 	ULONG fEnforceConstraintsOnDML = CDXLOperatorFactory::FValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenEnforceConstraintsOnDML, EdxltokenHint, true, true);
+	ULONG ulSearchMemoryBudget = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenSearchMemoryBudget, EdxltokenHint, true, gpos::int_max);
+	ULONG ulParallelWorkers = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenParallelWorkers, EdxltokenHint, true, PARALLEL_WORKERS);
+	ULONG ulOptimizationDeadline = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenOptimizationDeadline, EdxltokenHint, true, gpos::int_max);
 
 	m_phint = GPOS_NEW(m_pmp) CHint
 								(
@@ -96,7 +99,10 @@ CParseHandlerHint::StartElement
 								ulArrayExpansionThreshold,
 								ulJoinOrderDPThreshold,
 								ulBroadcastThreshold,
-								fEnforceConstraintsOnDML
+								fEnforceConstraintsOnDML,
+								ulSearchMemoryBudget,
+								ulParallelWorkers,
+								ulOptimizationDeadline
 								);
 }
 
@@ -86,6 +86,9 @@ CDXLTokens::Init
 			{EdxltokenJoinOrderDPThreshold, GPOS_WSZ_LIT("JoinOrderDynamicProgThreshold")},
 			{EdxltokenBroadcastThreshold, GPOS_WSZ_LIT("BroadcastThreshold")},
 			{EdxltokenEnforceConstraintsOnDML, GPOS_WSZ_LIT("EnforceConstraintsOnDML")},
+			{EdxltokenSearchMemoryBudget, GPOS_WSZ_LIT("SearchMemoryBudget")},
+			{EdxltokenParallelWorkers, GPOS_WSZ_LIT("ParallelWorkers")},
+			{EdxltokenOptimizationDeadline, GPOS_WSZ_LIT("OptimizationDeadline")},
 			{EdxltokenWindowOids, GPOS_WSZ_LIT("WindowOids")},
 			{EdxltokenOidRowNumber, GPOS_WSZ_LIT("RowNumber")},
 			{EdxltokenOidRank, GPOS_WSZ_LIT("Rank")},
@@ -511,6 +511,10 @@ namespace gpopt
 			static
 			CExpression *PexprLogicalUnion(IMemoryPool *pmp, ULONG ulDepth);
 
+			// generate a union all expression over the given number of tables
+			static
+			CExpression *PexprLogicalUnionAll(IMemoryPool *pmp, ULONG ulInputs);
+
 			// generate a sequence project expression
 			static
 			CExpression *PexprLogicalSequenceProject(IMemoryPool *pmp, OID oidFunc, CExpression *pexprInput);
@@ -529,7 +533,7 @@ namespace gpopt
 							
 			// generate a query context from an array of required column references
 			static
-			CQueryContext *PqcGenerate(IMemoryPool *pmp, CExpression *pexpr, DrgPcr *pdrgpcr);
+			CQueryContext *PqcGenerate(IMemoryPool *pmp, CExpression *pexpr, DrgPcr *pdrgpcr, BOOL fDeriveStats = true);
 
 			// generate a dummy query context for testing
 			static
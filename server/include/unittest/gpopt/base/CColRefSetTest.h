@@ -31,6 +31,8 @@ namespace gpopt
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basics();
+			static GPOS_RESULT EresUnittest_Intern();
+			static GPOS_RESULT EresUnittest_InternSweep();
 
 	}; // class CColRefSetTest
 }
@@ -16,6 +16,7 @@
 #include "gpos/common/CDynamicPtrArray.h"
 
 #include "gpopt/base/COptimizationContext.h"
+#include "gpopt/cost/CCost.h"
 #include "gpopt/search/CSearchStage.h"
 #include "gpopt/operators/CExpression.h"
 
@@ -46,6 +47,10 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+			// helper for optimizing a wide union all with the given number of workers
+			static
+			CCost CostOptimizeUnionAll(IMemoryPool *pmp, ULONG ulWorkers, ULONG *pulParallelExplorations);
+
 			// counter used to mark last successful test
 			static ULONG m_ulTestCounter;
 
@@ -65,6 +70,22 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_Basic();
 
+			// optimization with arena pools
+			static
+			GPOS_RESULT EresUnittest_ArenaMemoryPools();
+
+			// optimization under exhausted memory budget
+			static
+			GPOS_RESULT EresUnittest_MemoryBudget();
+
+			// optimization under passed deadline
+			static
+			GPOS_RESULT EresUnittest_Deadline();
+
+			// parallel exploration of a large memo
+			static
+			GPOS_RESULT EresUnittest_ParallelExploration();
+
 			// helper function for optimizing deep join trees
 			static
 			GPOS_RESULT EresOptimize
@@ -118,6 +139,22 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_BuildMemoWithCTE();
 
+			// helper for deriving stats of a wide union all with the given number of workers
+			static
+			void DeriveStatsUnionAll
+				(
+				IMemoryPool *pmp,
+				ULONG ulWorkers,
+				ULONG ulInputs,
+				DOUBLE *rgdRows, // row estimates of root group and its children
+				DOUBLE *rgdWidth, // width estimates of root group and its children
+				ULONG *pulParallelStatsDerivations
+				);
+
+			// parallel stats derivation of a large memo
+			static
+			GPOS_RESULT EresUnittest_ParallelStats();
+
 #endif // GPOS_DEBUG
 
 	}; // class CEngineTest
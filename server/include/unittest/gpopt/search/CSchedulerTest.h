@@ -76,6 +76,7 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_QueueBasic();
 			static GPOS_RESULT EresUnittest_QueueLight();
 			static GPOS_RESULT EresUnittest_QueueHeavy();
+			static GPOS_RESULT EresUnittest_Trace();
 			static GPOS_RESULT EresUnittest_BuildMemo();
 			static GPOS_RESULT EresUnittest_BuildMemoLargeJoins();
 
@@ -2484,6 +2484,53 @@ CTestUtils::PexprLogicalUnion
 	return pexpr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTestUtils::PexprLogicalUnionAll
+//
+//	@doc:
+//		Generate a union all of the given number of tables
+//
+//---------------------------------------------------------------------------
+CExpression *
+CTestUtils::PexprLogicalUnionAll
+	(
+	IMemoryPool *pmp,
+	ULONG ulInputs
+	)
+{
+	GPOS_ASSERT(0 < ulInputs);
+
+	DrgPexpr *pdrgpexprInput = GPOS_NEW(pmp) DrgPexpr(pmp, ulInputs);
+	DrgDrgPcr *pdrgpdrgpcrInput = GPOS_NEW(pmp) DrgDrgPcr(pmp);
+
+	for (ULONG ul = 0; ul < ulInputs; ul++)
+	{
+		CExpression *pexprInput = PexprLogicalGet(pmp);
+		DrgPcr *pdrgpcr = CLogicalGet::PopConvert(pexprInput->Pop())->PdrgpcrOutput();
+		pdrgpexprInput->Append(pexprInput);
+
+		pdrgpcr->AddRef();
+		pdrgpdrgpcrInput->Append(pdrgpcr);
+	}
+
+	// output columns are the columns of first input
+	DrgPcr *pdrgpcrInput = (*pdrgpdrgpcrInput)[0];
+	const ULONG ulCols = pdrgpcrInput->UlLength();
+	DrgPcr *pdrgpcrOutput = GPOS_NEW(pmp) DrgPcr(pmp, ulCols);
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		pdrgpcrOutput->Append((*pdrgpcrInput)[ul]);
+	}
+
+	return GPOS_NEW(pmp) CExpression
+						(
+						pmp,
+						GPOS_NEW(pmp) CLogicalUnionAll(pmp, pdrgpcrOutput, pdrgpdrgpcrInput),
+						pdrgpexprInput
+						);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTestUtils::PexprLogicalSequenceProject
@@ -2721,7 +2768,8 @@ CTestUtils::PexprLogicalNAryJoin
 //
 //	@doc:
 //		Generate a dummy context from an array of column references and
-//		empty sort columns for testing
+//		empty sort columns for testing; if stats are not derived for the
+//		query, they are only derived for the memo groups without stats
 //
 //---------------------------------------------------------------------------
 CQueryContext *
@@ -2729,7 +2777,8 @@ CTestUtils::PqcGenerate
 	(
 	IMemoryPool *pmp,
 	CExpression *pexpr,
-	DrgPcr *pdrgpcr
+	DrgPcr *pdrgpcr,
+	BOOL fDeriveStats
 	)
 {
 	// generate required columns
@@ -2763,7 +2812,7 @@ CTestUtils::PqcGenerate
 		pdrgpmdname->Append(pmdname);
 	}
 
-	return GPOS_NEW(pmp) CQueryContext(pmp, pexpr, prpp, pdrgpcr, pdrgpmdname, true /*fDeriveStats*/);
+	return GPOS_NEW(pmp) CQueryContext(pmp, pexpr, prpp, pdrgpcr, pdrgpmdname, fDeriveStats);
 }
 
 //---------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 //---------------------------------------------------------------------------
 #include "gpopt/base/CColRefSet.h"
 #include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/base/CColRefSetFactory.h"
 #include "gpopt/base/CColumnFactory.h"
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/base/CQueryContext.h"
@@ -37,7 +38,9 @@ CColRefSetTest::EresUnittest()
 {
 	CUnittest rgut[] =
 		{
-		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Basics)
+		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Basics),
+		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Intern),
+		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_InternSweep)
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -103,4 +106,159 @@ CColRefSetTest::EresUnittest_Basics()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetTest::EresUnittest_Intern
+//
+//	@doc:
+//		Equal sets are interned to the same shared set
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CColRefSetTest::EresUnittest_Intern()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// Setup an MD cache with a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+				(
+				pmp,
+				&mda,
+				NULL, /* pceeval */
+				CTestUtils::Pcm(pmp)
+				);
+
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+	CColRefSetFactory *pcrsf = COptCtxt::PoctxtFromTLS()->Pcrsf();
+
+	CWStringConst strName(GPOS_WSZ_LIT("Test Column"));
+	CName name(&strName);
+
+	const IMDTypeInt4 *pmdtypeint4 = mda.PtMDType<IMDTypeInt4>();
+
+	CColRefSet *pcrsFst = GPOS_NEW(pmp) CColRefSet(pmp);
+	CColRefSet *pcrsSnd = GPOS_NEW(pmp) CColRefSet(pmp);
+	CColRefSet *pcrsOther = GPOS_NEW(pmp) CColRefSet(pmp);
+
+	ULONG ulCols = 10;
+	for(ULONG i = 0; i < ulCols; i++)
+	{
+		CColRef *pcr = pcf->PcrCreate(pmdtypeint4, IDefaultTypeModifier, name);
+		pcrsFst->Include(pcr);
+		pcrsSnd->Include(pcr);
+
+		if (0 == i % 2)
+		{
+			pcrsOther->Include(pcr);
+		}
+	}
+
+	// interned sets replace the given ones
+	pcrsFst = pcrsf->PcrsIntern(pcrsFst);
+	pcrsSnd = pcrsf->PcrsIntern(pcrsSnd);
+	pcrsOther = pcrsf->PcrsIntern(pcrsOther);
+
+	GPOS_ASSERT(pcrsFst->FInterned());
+	GPOS_ASSERT(pcrsFst == pcrsSnd);
+	GPOS_ASSERT(pcrsFst != pcrsOther);
+	GPOS_ASSERT(!pcrsFst->FEqual(pcrsOther));
+	GPOS_ASSERT(pcrsFst->FSubset(pcrsOther));
+	GPOS_ASSERT(ulCols == pcrsFst->CElements());
+
+	// interning a shared set passes the reference through
+	GPOS_ASSERT(pcrsFst == pcrsf->PcrsIntern(pcrsFst));
+
+	// equality with sets that are not shared
+	CColRefSet *pcrsCopy = GPOS_NEW(pmp) CColRefSet(pmp, *pcrsOther);
+	GPOS_ASSERT(!pcrsCopy->FInterned());
+	GPOS_ASSERT(pcrsCopy->FEqual(pcrsOther));
+	GPOS_ASSERT(pcrsOther->FEqual(pcrsCopy));
+
+	pcrsCopy->Release();
+	pcrsOther->Release();
+	pcrsSnd->Release();
+	pcrsFst->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetTest::EresUnittest_InternSweep
+//
+//	@doc:
+//		Shared sets survive sweeps of the factory while they are referenced;
+//		empty sets are interned to a single shared set
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CColRefSetTest::EresUnittest_InternSweep()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// Setup an MD cache with a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+				(
+				pmp,
+				&mda,
+				NULL, /* pceeval */
+				CTestUtils::Pcm(pmp)
+				);
+
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+	CColRefSetFactory *pcrsf = COptCtxt::PoctxtFromTLS()->Pcrsf();
+
+	CWStringConst strName(GPOS_WSZ_LIT("Test Column"));
+	CName name(&strName);
+
+	const IMDTypeInt4 *pmdtypeint4 = mda.PtMDType<IMDTypeInt4>();
+
+	CColRef *pcrKept = pcf->PcrCreate(pmdtypeint4, IDefaultTypeModifier, name);
+	CColRefSet *pcrsKept = GPOS_NEW(pmp) CColRefSet(pmp);
+	pcrsKept->Include(pcrKept);
+	pcrsKept = pcrsf->PcrsIntern(pcrsKept);
+
+	// share and release enough sets to trigger sweeps
+	for (ULONG ul = 0; ul < 4 * GPOPT_COLREFSET_FACTORY_SWEEP_MIN; ul++)
+	{
+		CColRefSet *pcrs = GPOS_NEW(pmp) CColRefSet(pmp);
+		pcrs->Include(pcf->PcrCreate(pmdtypeint4, IDefaultTypeModifier, name));
+		pcrs = pcrsf->PcrsIntern(pcrs);
+		pcrs->Release();
+	}
+
+	CColRefSet *pcrsEqual = GPOS_NEW(pmp) CColRefSet(pmp);
+	pcrsEqual->Include(pcrKept);
+	pcrsEqual = pcrsf->PcrsIntern(pcrsEqual);
+	GPOS_ASSERT(pcrsKept == pcrsEqual);
+
+	CColRefSet *pcrsEmptyFst = pcrsf->PcrsIntern(GPOS_NEW(pmp) CColRefSet(pmp));
+	CColRefSet *pcrsEmptySnd = pcrsf->PcrsIntern(GPOS_NEW(pmp) CColRefSet(pmp));
+	GPOS_ASSERT(pcrsEmptyFst->FInterned());
+	GPOS_ASSERT(pcrsEmptyFst == pcrsEmptySnd);
+	GPOS_ASSERT(0 == pcrsEmptyFst->CElements());
+
+	pcrsEmptySnd->Release();
+	pcrsEmptyFst->Release();
+	pcrsEqual->Release();
+	pcrsKept->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -12,12 +12,14 @@
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/cost/CCost.h"
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/operators/ops.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "unittest/base.h"
 #include "unittest/gpopt/engine/CEngineTest.h"
@@ -40,6 +42,10 @@ CEngineTest::EresUnittest()
 	CUnittest rgut[] =
 	{
 		GPOS_UNITTEST_FUNC(EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(EresUnittest_ArenaMemoryPools),
+		GPOS_UNITTEST_FUNC(EresUnittest_MemoryBudget),
+		GPOS_UNITTEST_FUNC(EresUnittest_Deadline),
+		GPOS_UNITTEST_FUNC(EresUnittest_ParallelExploration),
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemo),
 		GPOS_UNITTEST_FUNC(EresUnittest_AppendStats),
@@ -50,6 +56,7 @@ CEngineTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoWithWindowing),
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoLargeJoins),
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoWithCTE),
+		GPOS_UNITTEST_FUNC(EresUnittest_ParallelStats),
 #endif // GPOS_DEBUG
 	};
 
@@ -122,6 +129,342 @@ CEngineTest::EresUnittest_Basic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_ArenaMemoryPools
+//
+//	@doc:
+//		Optimize with jobs, memo index and memo objects allocated from
+//		arena pools backed by huge pages
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_ArenaMemoryPools()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoTraceFlag atf(EopttraceArenaMemoryPools, true);
+	CAutoTraceFlag atfHugePages(EopttraceHugePageMemoryPools, true);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+	CEngine eng(pmp);
+
+	// generate join expression
+	CExpression *pexpr = CTestUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp);
+
+	// generate query context
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_MemoryBudget
+//
+//	@doc:
+//		Optimize with a memory budget that is exceeded before the first job;
+//		exploration is skipped but a plan is still produced
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_MemoryBudget()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	CHint *phint = GPOS_NEW(pmp) CHint
+						(
+						gpos::int_max, /* ulMinNumOfPartsToRequireSortOnInsert */
+						gpos::int_max, /* ulJoinArityForAssociativityCommutativity */
+						gpos::int_max, /* ulArrayExpansionThreshold */
+						JOIN_ORDER_DP_THRESHOLD, /* ulJoinOrderDPLimit */
+						BROADCAST_THRESHOLD, /* ulBroadcastThreshold */
+						true, /* fEnforceConstraintsOnDML */
+						0, /* ulSearchMemoryBudget */
+						PARALLEL_WORKERS, /* ulParallelWorkers */
+						gpos::int_max /* ulOptimizationDeadline */
+						);
+
+	COptimizerConfig *poconf = GPOS_NEW(pmp) COptimizerConfig
+						(
+						GPOS_NEW(pmp) CEnumeratorConfig(pmp, 0 /*ullPlanId*/, 0 /*ullSamples*/),
+						CStatisticsConfig::PstatsconfDefault(pmp),
+						CCTEConfig::PcteconfDefault(pmp),
+						CTestUtils::Pcm(pmp),
+						phint,
+						CWindowOids::Pwindowoids(pmp)
+						);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					poconf
+					);
+
+	CEngine eng(pmp);
+
+	// generate join expression
+	CExpression *pexpr = CTestUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp);
+
+	// generate query context
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (!eng.FMemoryBudgetExceeded())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_Deadline
+//
+//	@doc:
+//		Optimize with a deadline that has passed before the first job;
+//		exploration is skipped and jobs are abandoned once a plan exists,
+//		but a plan is still produced
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_Deadline()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	CHint *phint = GPOS_NEW(pmp) CHint
+						(
+						gpos::int_max, /* ulMinNumOfPartsToRequireSortOnInsert */
+						gpos::int_max, /* ulJoinArityForAssociativityCommutativity */
+						gpos::int_max, /* ulArrayExpansionThreshold */
+						JOIN_ORDER_DP_THRESHOLD, /* ulJoinOrderDPLimit */
+						BROADCAST_THRESHOLD, /* ulBroadcastThreshold */
+						true, /* fEnforceConstraintsOnDML */
+						gpos::int_max, /* ulSearchMemoryBudget */
+						PARALLEL_WORKERS, /* ulParallelWorkers */
+						0 /* ulOptimizationDeadline */
+						);
+
+	COptimizerConfig *poconf = GPOS_NEW(pmp) COptimizerConfig
+						(
+						GPOS_NEW(pmp) CEnumeratorConfig(pmp, 0 /*ullPlanId*/, 0 /*ullSamples*/),
+						CStatisticsConfig::PstatsconfDefault(pmp),
+						CCTEConfig::PcteconfDefault(pmp),
+						CTestUtils::Pcm(pmp),
+						phint,
+						CWindowOids::Pwindowoids(pmp)
+						);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					poconf
+					);
+
+	CEngine eng(pmp);
+
+	// generate join expression
+	CExpression *pexpr = CTestUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp);
+
+	// generate query context
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (!eng.FExplorationStopped())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::CostOptimizeUnionAll
+//
+//	@doc:
+//		Helper for optimizing a wide union all with the given number of
+//		workers; returns the cost of the best plan and the number of search
+//		stages whose memo was explored in parallel
+//
+//---------------------------------------------------------------------------
+CCost
+CEngineTest::CostOptimizeUnionAll
+	(
+	IMemoryPool *pmp,
+	ULONG ulWorkers,
+	ULONG *pulParallelExplorations
+	)
+{
+	GPOS_ASSERT(0 < ulWorkers);
+	GPOS_ASSERT(NULL != pulParallelExplorations);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// optimization context reads the flag when installed
+	CAutoTraceFlag atf(EopttraceParallel, 1 < ulWorkers);
+
+	CHint *phint = GPOS_NEW(pmp) CHint
+						(
+						gpos::int_max, /* ulMinNumOfPartsToRequireSortOnInsert */
+						gpos::int_max, /* ulJoinArityForAssociativityCommutativity */
+						gpos::int_max, /* ulArrayExpansionThreshold */
+						JOIN_ORDER_DP_THRESHOLD, /* ulJoinOrderDPLimit */
+						BROADCAST_THRESHOLD, /* ulBroadcastThreshold */
+						true, /* fEnforceConstraintsOnDML */
+						gpos::int_max, /* ulSearchMemoryBudget */
+						ulWorkers, /* ulParallelWorkers */
+						gpos::int_max /* ulOptimizationDeadline */
+						);
+
+	COptimizerConfig *poconf = GPOS_NEW(pmp) COptimizerConfig
+						(
+						GPOS_NEW(pmp) CEnumeratorConfig(pmp, 0 /*ullPlanId*/, 0 /*ullSamples*/),
+						CStatisticsConfig::PstatsconfDefault(pmp),
+						CCTEConfig::PcteconfDefault(pmp),
+						CTestUtils::Pcm(pmp),
+						phint,
+						CWindowOids::Pwindowoids(pmp)
+						);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					poconf
+					);
+
+	CEngine eng(pmp);
+
+	// generate a union all whose memo has more than the 32 groups
+	// that are explored in parallel
+	CExpression *pexpr = CTestUtils::PexprLogicalUnionAll(pmp, 40 /*ulInputs*/);
+
+	// generate query context
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	CCost cost = pexprPlan->Cost();
+	*pulParallelExplorations = eng.UlParallelExplorations();
+
+	// clean up
+	pexpr->Release();
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return cost;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_ParallelExploration
+//
+//	@doc:
+//		Optimize a memo that is explored by parallel jobs; the best plan
+//		must cost the same as the plan found by serial optimization
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_ParallelExploration()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG ulParallelExplorations = 0;
+	CCost costSerial = CostOptimizeUnionAll(pmp, 1 /*ulWorkers*/, &ulParallelExplorations);
+	GPOS_ASSERT(0 == ulParallelExplorations);
+
+	CCost costParallel = CostOptimizeUnionAll(pmp, 4 /*ulWorkers*/, &ulParallelExplorations);
+
+	if (0 == ulParallelExplorations || !(costSerial == costParallel))
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngineTest::EresOptimize
@@ -727,6 +1070,159 @@ CEngineTest::EresUnittest_BuildMemoWithCTE()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::DeriveStatsUnionAll
+//
+//	@doc:
+//		Helper for deriving stats of the memo of a wide union all with the
+//		given number of workers; stats of memo groups are only derived for
+//		the groups without stats, the row and width estimates of the root
+//		group and of its children are returned in the given arrays
+//
+//---------------------------------------------------------------------------
+void
+CEngineTest::DeriveStatsUnionAll
+	(
+	IMemoryPool *pmp,
+	ULONG ulWorkers,
+	ULONG ulInputs,
+	DOUBLE *rgdRows,
+	DOUBLE *rgdWidth,
+	ULONG *pulParallelStatsDerivations
+	)
+{
+	GPOS_ASSERT(0 < ulWorkers);
+	GPOS_ASSERT(NULL != rgdRows);
+	GPOS_ASSERT(NULL != rgdWidth);
+	GPOS_ASSERT(NULL != pulParallelStatsDerivations);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// optimization context reads the flag when installed
+	CAutoTraceFlag atf(EopttraceParallel, 1 < ulWorkers);
+
+	CHint *phint = GPOS_NEW(pmp) CHint
+						(
+						gpos::int_max, /* ulMinNumOfPartsToRequireSortOnInsert */
+						gpos::int_max, /* ulJoinArityForAssociativityCommutativity */
+						gpos::int_max, /* ulArrayExpansionThreshold */
+						JOIN_ORDER_DP_THRESHOLD, /* ulJoinOrderDPLimit */
+						BROADCAST_THRESHOLD, /* ulBroadcastThreshold */
+						true, /* fEnforceConstraintsOnDML */
+						gpos::int_max, /* ulSearchMemoryBudget */
+						ulWorkers, /* ulParallelWorkers */
+						gpos::int_max /* ulOptimizationDeadline */
+						);
+
+	COptimizerConfig *poconf = GPOS_NEW(pmp) COptimizerConfig
+						(
+						GPOS_NEW(pmp) CEnumeratorConfig(pmp, 0 /*ullPlanId*/, 0 /*ullSamples*/),
+						CStatisticsConfig::PstatsconfDefault(pmp),
+						CCTEConfig::PcteconfDefault(pmp),
+						CTestUtils::Pcm(pmp),
+						phint,
+						CWindowOids::Pwindowoids(pmp)
+						);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					poconf
+					);
+
+	CEngine eng(pmp);
+
+	CExpression *pexpr = CTestUtils::PexprLogicalUnionAll(pmp, ulInputs);
+	DrgPcr *pdrgpcr = CLogicalUnionAll::PopConvert(pexpr->Pop())->PdrgpcrOutput();
+
+	// skip deriving stats from the root, so that no memo group has stats
+	// before the groups without stats are derived
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr, pdrgpcr, false /*fDeriveStats*/);
+
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Explore();
+	eng.FinalizeExploration();
+
+	*pulParallelStatsDerivations = eng.UlParallelStatsDerivations();
+
+	CGroup *pgroupRoot = eng.PgroupRoot();
+	CGroupExpression *pgexpr = NULL;
+	{
+		CGroupProxy gp(pgroupRoot);
+		pgexpr = gp.PgexprFirst();
+	}
+	GPOS_ASSERT(ulInputs == pgexpr->UlArity());
+
+	rgdRows[0] = pgroupRoot->Pstats()->DRows().DVal();
+	rgdWidth[0] = pgroupRoot->Pstats()->DWidth().DVal();
+	for (ULONG ul = 0; ul < ulInputs; ul++)
+	{
+		IStatistics *pstats = (*pgexpr)[ul]->Pstats();
+		GPOS_ASSERT(NULL != pstats);
+
+		rgdRows[ul + 1] = pstats->DRows().DVal();
+		rgdWidth[ul + 1] = pstats->DWidth().DVal();
+	}
+
+	// clean up
+	pexpr->Release();
+	GPOS_DELETE(pqc);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_ParallelStats
+//
+//	@doc:
+//		Derive stats of a large memo on parallel jobs; each group must get
+//		the same row and width estimates as by serial derivation
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_ParallelStats()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// the memo has more than the 32 groups whose stats are derived in parallel
+	const ULONG ulInputs = 40;
+
+	DOUBLE rgdRowsSerial[ulInputs + 1];
+	DOUBLE rgdWidthSerial[ulInputs + 1];
+	ULONG ulParallelStatsDerivations = 0;
+	DeriveStatsUnionAll(pmp, 1 /*ulWorkers*/, ulInputs, rgdRowsSerial, rgdWidthSerial, &ulParallelStatsDerivations);
+	GPOS_ASSERT(0 == ulParallelStatsDerivations);
+
+	DOUBLE rgdRowsParallel[ulInputs + 1];
+	DOUBLE rgdWidthParallel[ulInputs + 1];
+	DeriveStatsUnionAll(pmp, 4 /*ulWorkers*/, ulInputs, rgdRowsParallel, rgdWidthParallel, &ulParallelStatsDerivations);
+
+	if (0 == ulParallelStatsDerivations)
+	{
+		return GPOS_FAILED;
+	}
+
+	for (ULONG ul = 0; ul < ulInputs + 1; ul++)
+	{
+		if (CDouble(rgdRowsSerial[ul]) != CDouble(rgdRowsParallel[ul]) ||
+			CDouble(rgdWidthSerial[ul]) != CDouble(rgdWidthParallel[ul]))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+
 #endif // GPOS_DEBUG
 
 // EOF
@@ -108,7 +108,7 @@ COptimizationJobsTest::EresUnittest_StateMachine()
 		CJob *pj = jf.PjCreate(CJob::EjtGroupOptimization);
 		CJobGroupOptimization *pjgo = CJobGroupOptimization::PjConvert(pj);
 		pjgo->Init(pgroup, NULL /*pgexprOrigin*/, poc);
-		sched.Add(pjgo, NULL /*pjParent*/);
+		sched.Add(pjgo, NULL /*pjParent*/, &sc);
 		CScheduler::Run(&sc);
 
 #ifdef GPOS_DEBUG
@@ -24,6 +24,7 @@
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/search/CJobTest.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobTrace.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 #include "gpopt/mdcache/CMDAccessor.h"
@@ -60,6 +61,7 @@ CSchedulerTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueBasic),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueLight),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueHeavy),
+		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_Trace),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_BuildMemo),
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoLargeJoins),
 		};
@@ -228,6 +230,61 @@ CSchedulerTest::EresUnittest_QueueHeavy()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerTest::EresUnittest_Trace
+//
+//	@doc:
+//		Test recording and export of job timeline
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSchedulerTest::EresUnittest_Trace()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulRounds = 100;
+	const ULONG ulFanout = 4;
+	const ULONG ulWorkers = 2;
+	const ULONG ulJobs = ulRounds * ulFanout + 1;
+
+	CJobFactory jf(pmp, ulJobs);
+	CScheduler sched(pmp, ulJobs, ulWorkers);
+	CEngine eng(pmp);
+
+	// keep fewer events than recorded to exercise ring wrap-around
+	const ULONG ulEvents = 64;
+	CJobTrace jtrace(pmp, ulWorkers, ulEvents);
+	sched.SetJobTrace(&jtrace);
+
+	CJobTest *pjt = CJobTest::PjConvert(jf.PjCreate(CJob::EjtTest));
+	CJobQueue jq;
+	pjt->Init(CJobTest::EttSpawn, ulRounds, ulFanout, 1 /*ulIters*/, &jq);
+	pjt->ResetCnt();
+	sched.Add(pjt, NULL /*pjParent*/, NULL /*psc*/);
+
+	RunTasks(pmp, &jf, &sched, &eng, ulWorkers);
+
+	ULONG ulKept = 0;
+	for (ULONG ul = 0; ul < ulWorkers; ul++)
+	{
+		GPOS_RTL_ASSERT(ulEvents >= jtrace.UlEvents(ul));
+		ulKept += jtrace.UlEvents(ul);
+	}
+	GPOS_RTL_ASSERT(0 < ulKept);
+
+	CWStringDynamic str(pmp);
+	COstreamString oss(&str);
+	(void) jtrace.OsPrintChromeTrace(oss);
+
+	CWStringConst strPrefix(GPOS_WSZ_LIT("{\"traceEvents\":["));
+	GPOS_RTL_ASSERT(0 == clib::IWcsNCmp(str.Wsz(), strPrefix.Wsz(), strPrefix.UlLength()));
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CSchedulerTest::ScheduleRoot
@@ -282,7 +339,7 @@ CSchedulerTest::ScheduleRoot
 	CJobQueue jq;
 	pjt->Init(ett, ulRounds, ulFanout, ulIters, &jq);
 	pjt->ResetCnt();
-	sched.Add(pjt, NULL);
+	sched.Add(pjt, NULL /*pjParent*/, NULL /*psc*/);
 
 	RunTasks(pmp, &jf, &sched, &eng, ulWorkers);
 